@@ -0,0 +1,140 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+namespace SimpleEngine {
+
+BenchmarkRunner::BenchmarkRunner(const double min_seconds, const u64 min_iterations, std::string filter)
+    : m_min_seconds(min_seconds),
+      m_min_iterations(min_iterations),
+      m_filter(std::move(filter))
+{
+}
+
+void BenchmarkRunner::run(const std::string& name, const u64 size, const u64 items_per_iteration, const std::function<void()>& fn,
+                          const std::function<void()>& setup)
+{
+    if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+    {
+        return;
+    }
+
+    using clock = std::chrono::steady_clock;
+    BenchmarkResult result;
+    result.name = name;
+    result.size = size;
+    result.items_per_iteration = items_per_iteration;
+
+    if (setup)
+    {
+        setup();
+    }
+    fn();
+    double total_ns = 0.0;
+    while (total_ns < m_min_seconds * 1e9 || result.iteration_ns.size() < m_min_iterations)
+    {
+        if (setup)
+        {
+            setup();
+        }
+        const clock::time_point start = clock::now();
+        fn();
+        const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        result.iteration_ns.push_back(ns);
+        total_ns += ns;
+    }
+    result.iterations = result.iteration_ns.size();
+
+    std::cout << "  " << name << " [" << size << "]: " << result.iterations << " iterations\n";
+    m_results.push_back(std::move(result));
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const std::vector<double>& sorted, const double fraction)
+{
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+struct Summary
+{
+    double mean = 0.0;
+    double min = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double max = 0.0;
+    double items_per_second = 0.0;
+};
+
+static Summary summarize(const BenchmarkResult& result)
+{
+    std::vector<double> sorted = result.iteration_ns;
+    std::sort(sorted.begin(), sorted.end());
+
+    Summary summary;
+    summary.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    summary.min = sorted.front();
+    summary.p50 = percentile(sorted, 0.5);
+    summary.p90 = percentile(sorted, 0.9);
+    summary.max = sorted.back();
+    // From the median so one preempted iteration doesn't skew it
+    summary.items_per_second = summary.p50 > 0.0 ? result.items_per_iteration * 1e9 / summary.p50 : 0.0;
+    return summary;
+}
+
+void BenchmarkRunner::print_table() const
+{
+    std::cout << std::left << std::setw(32) << "benchmark" << std::right
+              << std::setw(10) << "size" << std::setw(14) << "p50 us" << std::setw(14) << "min us"
+              << std::setw(14) << "p90 us" << std::setw(16) << "items/s" << "\n";
+    for (const BenchmarkResult& result : m_results)
+    {
+        const Summary summary = summarize(result);
+        std::cout << std::left << std::setw(32) << result.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << result.size
+                  << std::setw(14) << summary.p50 / 1e3
+                  << std::setw(14) << summary.min / 1e3
+                  << std::setw(14) << summary.p90 / 1e3
+                  << std::setw(16) << std::setprecision(0) << summary.items_per_second << "\n";
+    }
+}
+
+bool BenchmarkRunner::write_json(const char* path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Can't write '" << path << "'\n";
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(1);
+    out << "{\n  \"benchmarks\": [";
+    bool first = true;
+    for (const BenchmarkResult& result : m_results)
+    {
+        const Summary summary = summarize(result);
+        out << (first ? "\n    " : ",\n    ");
+        first = false;
+        out << "{\"name\":\"" << result.name << "\""
+            << ",\"size\":" << result.size
+            << ",\"items_per_iteration\":" << result.items_per_iteration
+            << ",\"iterations\":" << result.iterations
+            << ",\"ns\":{\"mean\":" << summary.mean
+            << ",\"min\":" << summary.min
+            << ",\"p50\":" << summary.p50
+            << ",\"p90\":" << summary.p90
+            << ",\"max\":" << summary.max << "}"
+            << ",\"items_per_second\":" << summary.items_per_second << "}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+}
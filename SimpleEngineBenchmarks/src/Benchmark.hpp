@@ -0,0 +1,67 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace SimpleEngine {
+
+// Keeps the compiler from dropping a computation whose result is unused
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static const void* volatile s_sink;
+    s_sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+struct BenchmarkResult
+{
+    std::string name;
+    u64 size = 0;
+    u64 items_per_iteration = 0;
+    u64 iterations = 0;
+    // Wall time of every iteration, in nanoseconds
+    std::vector<double> iteration_ns;
+};
+
+// Runs each benchmark until it has taken at least `min_seconds` and
+// `min_iterations` iterations, after one untimed warm-up iteration, and keeps
+// every iteration's time. Benchmarks whose name doesn't contain the filter
+// are skipped.
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner(const double min_seconds, const u64 min_iterations, std::string filter);
+
+    // `size` is the input size the benchmark scales with, `items_per_iteration`
+    // what one call of `fn` processes (for the items/s figure). `setup`, if
+    // any, runs untimed before every iteration.
+    void run(const std::string& name, const u64 size, const u64 items_per_iteration, const std::function<void()>& fn,
+             const std::function<void()>& setup = {});
+
+    const std::vector<BenchmarkResult>& get_results() const noexcept { return m_results; }
+
+    void print_table() const;
+    bool write_json(const char* path) const;
+
+private:
+    double m_min_seconds;
+    u64 m_min_iterations;
+    std::string m_filter;
+    std::vector<BenchmarkResult> m_results;
+};
+
+}
+
+#endif // BENCHMARK_HPP
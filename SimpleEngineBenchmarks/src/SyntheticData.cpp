@@ -0,0 +1,288 @@
+#include "SyntheticData.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace SimpleEngine {
+
+namespace {
+
+struct GridTriangle
+{
+    std::array<u32, 3> corners;
+};
+
+// Corner (x, y) of the grid is index y * (grid + 1) + x
+std::vector<GridTriangle> grid_triangles(const u32 grid)
+{
+    std::vector<GridTriangle> triangles;
+    triangles.reserve(size_t(2) * grid * grid);
+    const u32 row = grid + 1;
+    for (u32 y = 0; y < grid; ++y)
+    {
+        for (u32 x = 0; x < grid; ++x)
+        {
+            const u32 corner = y * row + x;
+            triangles.push_back({ { corner, corner + 1, corner + row + 1 } });
+            triangles.push_back({ { corner, corner + row + 1, corner + row } });
+        }
+    }
+    return triangles;
+}
+
+// A gently rolling height field so coordinates aren't all round numbers
+std::array<float, 3> grid_position(const u32 corner, const u32 grid)
+{
+    const u32 x = corner % (grid + 1);
+    const u32 y = corner / (grid + 1);
+    const float u = static_cast<float>(x) / grid;
+    const float v = static_cast<float>(y) / grid;
+    return { u * 10.f - 5.f, 0.5f * std::sin(u * 12.f) * std::cos(v * 9.f), v * 10.f - 5.f };
+}
+
+void put_u32_le(std::vector<u8>& out, const u32 value)
+{
+    for (u32 i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<u8>(value >> (8 * i)));
+    }
+}
+
+void put_u32_be(std::vector<u8>& out, const u32 value)
+{
+    for (u32 i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<u8>(value >> (24 - 8 * i)));
+    }
+}
+
+void put_float(std::vector<u8>& out, const float value)
+{
+    u32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u32_le(out, bits);
+}
+
+u32 crc32(const u8* data, const size_t size, u32 crc = 0)
+{
+    static const std::array<u32, 256> table = []()
+    {
+        std::array<u32, 256> table{};
+        for (u32 i = 0; i < 256; ++i)
+        {
+            u32 value = i;
+            for (u32 bit = 0; bit < 8; ++bit)
+            {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            table[i] = value;
+        }
+        return table;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+u32 adler32(const std::vector<u8>& data)
+{
+    u32 a = 1;
+    u32 b = 0;
+    for (const u8 byte : data)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+// Deflate bits go out least significant first
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<u8>& out) : m_out(out) {}
+
+    void put(const u32 value, const u32 bits_count)
+    {
+        for (u32 i = 0; i < bits_count; ++i)
+        {
+            put_bit((value >> i) & 1);
+        }
+    }
+
+    // Huffman codes are stored most significant bit first
+    void put_code(const u32 code, const u32 bits_count)
+    {
+        for (u32 i = bits_count; i > 0; --i)
+        {
+            put_bit((code >> (i - 1)) & 1);
+        }
+    }
+
+    void flush()
+    {
+        if (m_bits_count > 0)
+        {
+            m_out.push_back(m_byte);
+            m_byte = 0;
+            m_bits_count = 0;
+        }
+    }
+
+private:
+    void put_bit(const u32 bit)
+    {
+        m_byte |= static_cast<u8>(bit << m_bits_count);
+        if (++m_bits_count == 8)
+        {
+            flush();
+        }
+    }
+
+    std::vector<u8>& m_out;
+    u8 m_byte = 0;
+    u32 m_bits_count = 0;
+};
+
+std::vector<u8> zlib_literals(const std::vector<u8>& data)
+{
+    std::vector<u8> out = { 0x78, 0x01 };
+    BitWriter writer(out);
+    writer.put(1, 1); // last block
+    writer.put(1, 2); // fixed Huffman codes
+    for (const u8 byte : data)
+    {
+        if (byte < 144)
+        {
+            writer.put_code(0x30 + byte, 8);
+        }
+        else
+        {
+            writer.put_code(0x190 + (byte - 144), 9);
+        }
+    }
+    writer.put_code(0, 7); // end of block
+    writer.flush();
+    put_u32_be(out, adler32(data));
+    return out;
+}
+
+void put_chunk(std::vector<u8>& png, const char* type, const std::vector<u8>& data)
+{
+    put_u32_be(png, static_cast<u32>(data.size()));
+    const size_t type_offset = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    put_u32_be(png, crc32(png.data() + type_offset, png.size() - type_offset));
+}
+
+}
+
+std::string make_obj(const u32 grid)
+{
+    std::ostringstream out;
+    const u32 corners_count = (grid + 1) * (grid + 1);
+    for (u32 corner = 0; corner < corners_count; ++corner)
+    {
+        const std::array<float, 3> position = grid_position(corner, grid);
+        out << "v " << position[0] << ' ' << position[1] << ' ' << position[2] << '\n';
+    }
+    for (u32 corner = 0; corner < corners_count; ++corner)
+    {
+        out << "vt " << static_cast<float>(corner % (grid + 1)) / grid << ' '
+            << static_cast<float>(corner / (grid + 1)) / grid << '\n';
+    }
+    for (u32 corner = 0; corner < corners_count; ++corner)
+    {
+        out << "vn 0 1 0\n";
+    }
+    for (const GridTriangle& triangle : grid_triangles(grid))
+    {
+        out << 'f';
+        for (const u32 corner : triangle.corners)
+        {
+            out << ' ' << corner + 1 << '/' << corner + 1 << '/' << corner + 1;
+        }
+        out << '\n';
+    }
+    return out.str();
+}
+
+std::vector<u8> make_stl_binary(const u32 grid)
+{
+    const std::vector<GridTriangle> triangles = grid_triangles(grid);
+    std::vector<u8> out(80, 0);
+    const char header[] = "SimpleEngine benchmark grid";
+    std::memcpy(out.data(), header, sizeof(header) - 1);
+    put_u32_le(out, static_cast<u32>(triangles.size()));
+    for (const GridTriangle& triangle : triangles)
+    {
+        put_float(out, 0.f);
+        put_float(out, 1.f);
+        put_float(out, 0.f);
+        for (const u32 corner : triangle.corners)
+        {
+            for (const float coordinate : grid_position(corner, grid))
+            {
+                put_float(out, coordinate);
+            }
+        }
+        out.push_back(0);
+        out.push_back(0);
+    }
+    return out;
+}
+
+std::string make_stl_ascii(const u32 grid)
+{
+    std::ostringstream out;
+    out << "solid grid\n";
+    for (const GridTriangle& triangle : grid_triangles(grid))
+    {
+        out << "facet normal 0 1 0\nouter loop\n";
+        for (const u32 corner : triangle.corners)
+        {
+            const std::array<float, 3> position = grid_position(corner, grid);
+            out << "vertex " << position[0] << ' ' << position[1] << ' ' << position[2] << '\n';
+        }
+        out << "endloop\nendfacet\n";
+    }
+    out << "endsolid grid\n";
+    return out.str();
+}
+
+std::vector<u8> make_png(const u32 width, const u32 height)
+{
+    const size_t row_size = size_t(width) * 4;
+    std::vector<u8> filtered;
+    filtered.reserve((row_size + 1) * height);
+    u32 noise = 0x12345678u;
+    for (u32 y = 0; y < height; ++y)
+    {
+        filtered.push_back(static_cast<u8>(y % 5));
+        for (size_t x = 0; x < row_size; ++x)
+        {
+            // Small residuals, like filtering leaves on a smooth image
+            noise = noise * 1664525u + 1013904223u;
+            filtered.push_back(static_cast<u8>((noise >> 24) & 0x0F));
+        }
+    }
+
+    std::vector<u8> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    std::vector<u8> header;
+    put_u32_be(header, width);
+    put_u32_be(header, height);
+    header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bits, RGBA, deflate, adaptive filters, no interlace
+    put_chunk(png, "IHDR", header);
+    put_chunk(png, "IDAT", zlib_literals(filtered));
+    put_chunk(png, "IEND", {});
+    return png;
+}
+
+}
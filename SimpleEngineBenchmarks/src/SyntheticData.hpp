@@ -0,0 +1,26 @@
+#ifndef SYNTHETIC_DATA_HPP
+#define SYNTHETIC_DATA_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <string>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Inputs for the loaders, generated so benchmarks need no asset files. Meshes
+// are a grid x grid quad surface (2 * grid * grid triangles) with every
+// interior corner shared, so welding has real duplicates to merge.
+
+// OBJ with positions, texcoords and normals; faces are "f v/vt/vn" triangles
+std::string make_obj(const u32 grid);
+std::vector<u8> make_stl_binary(const u32 grid);
+std::string make_stl_ascii(const u32 grid);
+
+// RGBA8 PNG whose rows cycle through all five filter types. The deflate stream
+// is one fixed-Huffman block of literals, so decoding walks the Huffman path
+// for every byte without needing a real compressor.
+std::vector<u8> make_png(const u32 width, const u32 height);
+
+}
+
+#endif // SYNTHETIC_DATA_HPP
@@ -0,0 +1,589 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Event.hpp"
+#include "SimpleEngineCore/EventBus.hpp"
+#include "SimpleEngineCore/JobSystem.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+#include "SimpleEngineCore/TraceLog.hpp"
+#include "SimpleEngineCore/stb_image.h"
+#include "SimpleEngineCore/stl_reader.hpp"
+#include "SimpleEngineCore/Rendering/NullRenderBackend.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/MipChain.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ModelLoader.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ParametricMesh.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Shape.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/VertexBuffer.hpp"
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/null_sink.h>
+#include "Benchmark.hpp"
+#include "SyntheticData.hpp"
+
+// Times engine hot paths in isolation on generated inputs of growing size and
+// writes the results as JSON. Only CPU code runs: no window, context or GPU is
+// needed, and the null render backend is installed so nothing reaches GL.
+
+using namespace SimpleEngine;
+namespace fs = std::filesystem;
+
+static void print_usage()
+{
+    std::cout << "Usage: SimpleEngineBenchmarks [--filter text] [--min-time seconds] [--min-iterations N]\n"
+                 "                              [--quick] [--output benchmarks.json]\n"
+                 "--filter runs only benchmarks whose name contains the text; --quick skips the largest sizes.\n";
+}
+
+static bool write_file(const fs::path& path, const void* data, const size_t size)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<bool>(out);
+}
+
+class BenchmarkShape final : public Shape
+{
+public:
+    void render() override {}
+};
+
+static void benchmark_obj(BenchmarkRunner& runner, const fs::path& directory, const std::vector<u32>& grids)
+{
+    for (const u32 grid : grids)
+    {
+        const std::string obj = make_obj(grid);
+        const fs::path path = directory / ("grid_" + std::to_string(grid) + ".obj");
+        if (!write_file(path, obj.data(), obj.size()))
+        {
+            continue;
+        }
+        const u64 triangles = u64(2) * grid * grid;
+        runner.run("obj_parse", triangles, triangles, [&]()
+        {
+            const std::vector<Vertex> vertices = loadOBJ(path.string().c_str());
+            do_not_optimize(vertices.data());
+        });
+    }
+}
+
+static void benchmark_stl(BenchmarkRunner& runner, const fs::path& directory, const std::vector<u32>& grids)
+{
+    for (const u32 grid : grids)
+    {
+        const std::vector<u8> binary = make_stl_binary(grid);
+        const std::string ascii = make_stl_ascii(grid);
+        const fs::path binary_path = directory / ("grid_" + std::to_string(grid) + "_binary.stl");
+        const fs::path ascii_path = directory / ("grid_" + std::to_string(grid) + "_ascii.stl");
+        if (!write_file(binary_path, binary.data(), binary.size()) || !write_file(ascii_path, ascii.data(), ascii.size()))
+        {
+            continue;
+        }
+
+        const u64 triangles = u64(2) * grid * grid;
+        for (const auto& input : { std::make_pair("stl_read_weld_binary", binary_path), std::make_pair("stl_read_weld_ascii", ascii_path) })
+        {
+            const std::string path = input.second.string();
+            runner.run(input.first, triangles, triangles, [&]()
+            {
+                std::vector<float> coords, normals;
+                std::vector<unsigned int> tris, solids;
+                try
+                {
+                    stl_reader::ReadStlFile(path.c_str(), coords, normals, tris, solids);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << e.what() << "\n";
+                }
+                do_not_optimize(coords.data());
+                do_not_optimize(tris.data());
+            });
+        }
+    }
+}
+
+static void benchmark_png(BenchmarkRunner& runner, const std::vector<u32>& sizes)
+{
+    for (const u32 size : sizes)
+    {
+        const std::vector<u8> png = make_png(size, size);
+        int width = 0, height = 0, channels = 0;
+        if (!stbi_info_from_memory(png.data(), static_cast<int>(png.size()), &width, &height, &channels))
+        {
+            std::cerr << "Generated PNG is invalid: " << stbi_failure_reason() << "\n";
+            continue;
+        }
+        runner.run("png_decode", size, u64(size) * size, [&]()
+        {
+            stbi_uc* pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &width, &height, &channels, 4);
+            do_not_optimize(pixels);
+            stbi_image_free(pixels);
+        });
+    }
+}
+
+static void benchmark_primitives(BenchmarkRunner& runner, const std::vector<u32>& segments_counts)
+{
+    for (const u32 segments : segments_counts)
+    {
+        const PrimitiveKey torus = make_torus_key(1.f, segments, 0.3f, segments, glm::vec3(1.f), glm::vec3(0.f), ETopology::Triangles);
+        runner.run("generate_torus", segments, u64(segments) * segments, [&]()
+        {
+            const MeshData mesh = generate_primitive(torus);
+            do_not_optimize(mesh.vertices.data());
+        });
+
+        const PrimitiveKey cone = make_cone_key(1.f, 0.5f, segments, glm::vec3(1.f), glm::vec3(0.f), ETopology::Triangles);
+        runner.run("generate_cone", segments, segments, [&]()
+        {
+            const MeshData mesh = generate_primitive(cone);
+            do_not_optimize(mesh.vertices.data());
+        });
+    }
+}
+
+static void benchmark_shapes(BenchmarkRunner& runner, const std::vector<u32>& counts)
+{
+    for (const u32 count : counts)
+    {
+        std::vector<BenchmarkShape> shapes(count);
+        float angle = 0.f;
+        runner.run("shape_model_matrix", count, count, [&]()
+        {
+            // A new value every call, so no setter takes the unchanged early-out
+            angle += 1.f;
+            for (BenchmarkShape& shape : shapes)
+            {
+                shape.set_rotation(glm::vec3(angle, 0.5f * angle, 0.f));
+            }
+            do_not_optimize(shapes.back().get_model_matrix());
+        });
+    }
+}
+
+static void benchmark_event_dispatch(BenchmarkRunner& runner, const std::vector<u32>& counts)
+{
+    EventDispatcher dispatcher;
+    u64 handled = 0;
+    dispatcher.add_event_listener<EventMouseMoved>([&](EventMouseMoved& event) { handled += event.x > 0.0; });
+    dispatcher.add_event_listener<EventKeyPressed>([&](EventKeyPressed& event) { handled += event.key; });
+    dispatcher.add_event_listener<EventWindowResize>([&](EventWindowResize& event) { handled += event.width; });
+
+    for (const u32 count : counts)
+    {
+        // Mostly mouse moves, as in a real frame, plus events nobody listens to
+        std::vector<std::unique_ptr<BaseEvent>> events;
+        events.reserve(count);
+        for (u32 i = 0; i < count; ++i)
+        {
+            switch (i % 8)
+            {
+                case 0: events.push_back(std::make_unique<EventKeyPressed>()); break;
+                case 1: events.push_back(std::make_unique<EventKeyReleased>()); break;
+                case 2: events.push_back(std::make_unique<EventWindowResize>(1280, 720)); break;
+                default: events.push_back(std::make_unique<EventMouseMoved>(i, i)); break;
+            }
+        }
+        runner.run("event_dispatch", count, count, [&]()
+        {
+            for (const std::unique_ptr<BaseEvent>& event : events)
+            {
+                dispatcher.dispatch(*event);
+            }
+            do_not_optimize(handled);
+        });
+    }
+}
+
+static void benchmark_event_bus(BenchmarkRunner& runner, const std::vector<u32>& counts)
+{
+    EventBus bus;
+    u64 handled = 0;
+    bus.add_event_listener<EventMouseMoved>([&](EventMouseMoved& event) { handled += event.x > 0.0; });
+    bus.add_event_listener<EventMouseMoved>([&](EventMouseMoved& event) { handled += event.y > 0.0; });
+    bus.add_event_listener<EventKeyPressed>([&](EventKeyPressed& event) { handled += event.key; });
+    bus.add_event_listener<EventWindowResize>([&](EventWindowResize& event) { handled += event.width; });
+
+    for (const u32 count : counts)
+    {
+        // Posted and dispatched a ring at a time, the same mix as event_dispatch
+        runner.run("event_bus_post_dispatch", count, count, [&]()
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                switch (i % 8)
+                {
+                    case 0: bus.post(EventKeyPressed()); break;
+                    case 1: bus.post(EventKeyReleased()); break;
+                    case 2: bus.post(EventWindowResize(1280, 720)); break;
+                    default: bus.post(EventMouseMoved(i, i)); break;
+                }
+                if ((i + 1) % EventBus::capacity == 0)
+                {
+                    bus.dispatch_pending();
+                }
+            }
+            bus.dispatch_pending();
+            do_not_optimize(handled);
+        });
+    }
+    if (bus.get_dropped_events() > 0)
+    {
+        std::cerr << "event_bus_post_dispatch dropped " << bus.get_dropped_events() << " events\n";
+    }
+}
+
+static void benchmark_trace_log(BenchmarkRunner& runner, const std::vector<u32>& counts)
+{
+    // Formatted into a null sink, so no I/O is timed
+    const std::shared_ptr<spdlog::logger> default_logger = spdlog::default_logger();
+    const std::shared_ptr<spdlog::logger> null_logger = std::make_shared<spdlog::logger>("null", std::make_shared<spdlog::sinks::null_sink_mt>());
+    spdlog::set_default_logger(null_logger);
+    TraceLog& trace_log = TraceLog::get();
+    trace_log.set_rate_limit(0);
+    const u64 dropped_records = trace_log.get_dropped_records();
+    const std::string path = "textures/stone.png";
+
+    for (const u32 count : counts)
+    {
+        TraceLog::set_level(ETraceLevel::Off);
+        runner.run("trace_log_disabled", count, count, [&]()
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                SIMPLE_ENGINE_TRACE(ETraceLevel::Info, "Streamed {0} mip {1} in {2:.3f} ms", path, i, 0.25);
+            }
+        });
+        TraceLog::set_level(ETraceLevel::Info);
+
+        // Flushed before the ring fills up, which includes the formatting
+        // the background thread otherwise does
+        runner.run("trace_log_write_format", count, count, [&]()
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                SIMPLE_ENGINE_TRACE(ETraceLevel::Info, "Streamed {0} mip {1} in {2:.3f} ms", path, i, 0.25);
+                if ((i + 1) % 256 == 0)
+                {
+                    trace_log.flush();
+                }
+            }
+            trace_log.flush();
+        });
+
+        // A log point without the trace log
+        runner.run("spdlog_sync_format", count, count, [&]()
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                null_logger->info("Streamed {0} mip {1} in {2:.3f} ms", path, i, 0.25);
+            }
+        });
+    }
+
+    // What a log point costs the calling thread, in batches that fit a ring;
+    // the formatting is left to the untimed flush between them
+    const u32 batch = 256;
+    runner.run("trace_log_write", batch, batch, [&]()
+    {
+        for (u32 i = 0; i < batch; ++i)
+        {
+            SIMPLE_ENGINE_TRACE(ETraceLevel::Info, "Streamed {0} mip {1} in {2:.3f} ms", path, i, 0.25);
+        }
+    }, [&]() { trace_log.flush(); });
+    trace_log.flush();
+
+    if (trace_log.get_dropped_records() != dropped_records)
+    {
+        std::cerr << "trace_log benchmarks dropped " << trace_log.get_dropped_records() - dropped_records << " records\n";
+    }
+    trace_log.set_rate_limit(TraceLog::default_rate_limit);
+    spdlog::set_default_logger(default_logger);
+}
+
+template <size_t... I>
+static BufferLayout make_layout(const std::vector<ShaderDataType>& types, std::index_sequence<I...>)
+{
+    return BufferLayout{ BufferElement(types[I])... };
+}
+
+template <size_t ElementsCount>
+static void benchmark_buffer_layout(BenchmarkRunner& runner, const std::vector<ShaderDataType>& types)
+{
+    // Types are read at run time so the constexpr constructor can't be folded away
+    constexpr u32 layouts_count = 10000;
+    runner.run("buffer_layout", ElementsCount, layouts_count, [&]()
+    {
+        size_t strides = 0;
+        for (u32 i = 0; i < layouts_count; ++i)
+        {
+            const BufferLayout layout = make_layout(types, std::make_index_sequence<ElementsCount>());
+            strides += layout.get_stride();
+            do_not_optimize(layout);
+        }
+        do_not_optimize(strides);
+    });
+}
+
+// The same per-frame temporaries from the heap and from a frame arena reset
+// after every frame, as the engine's frame loops do
+static void benchmark_frame_temporaries(BenchmarkRunner& runner, const std::vector<u32>& counts)
+{
+    constexpr u32 frames_count = 100;
+    for (const u32 count : counts)
+    {
+        runner.run("frame_temporaries_heap", count, u64(frames_count) * count, [&]()
+        {
+            for (u32 frame = 0; frame < frames_count; ++frame)
+            {
+                std::vector<u32> indices;
+                std::vector<float> values;
+                for (u32 i = 0; i < count; ++i)
+                {
+                    indices.push_back(i);
+                    values.push_back(static_cast<float>(i));
+                }
+                do_not_optimize(indices.data());
+                do_not_optimize(values.data());
+            }
+        });
+
+        LinearArena arena(EMemoryTag::Frame);
+        runner.run("frame_temporaries_arena", count, u64(frames_count) * count, [&]()
+        {
+            for (u32 frame = 0; frame < frames_count; ++frame)
+            {
+                {
+                    ArenaVector<u32> indices(ArenaAllocator<u32>(arena, EMemoryTag::General));
+                    ArenaVector<float> values(ArenaAllocator<float>(arena, EMemoryTag::General));
+                    for (u32 i = 0; i < count; ++i)
+                    {
+                        indices.push_back(i);
+                        values.push_back(static_cast<float>(i));
+                    }
+                    do_not_optimize(indices.data());
+                    do_not_optimize(values.data());
+                }
+                arena.reset();
+            }
+        });
+    }
+}
+
+// 1, 2, 4... up to the hardware thread count, which is always included
+static std::vector<u32> thread_counts()
+{
+    const u32 hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<u32> counts;
+    for (u32 threads = 1; threads < hardware_threads; threads *= 2)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(hardware_threads);
+    return counts;
+}
+
+static void benchmark_job_scaling(BenchmarkRunner& runner, const u32 elements, const u32 image_size)
+{
+    JobSystem& jobs = JobSystem::get();
+    std::vector<float> values(elements);
+    Image image;
+    image.width = image_size;
+    image.height = image_size;
+    image.rgba.resize(size_t(image_size) * image_size * 4);
+    for (size_t i = 0; i < image.rgba.size(); ++i)
+    {
+        image.rgba[i] = static_cast<u8>(i * 7 + i / 4093);
+    }
+
+    for (const u32 threads : thread_counts())
+    {
+        jobs.start(threads);
+        runner.run("parallel_for_threads", threads, elements, [&]()
+        {
+            jobs.parallel_for(0u, elements, jobs.get_grain(elements), [&](const u32 first, const u32 last)
+            {
+                for (u32 i = first; i < last; ++i)
+                {
+                    values[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i));
+                }
+            });
+            do_not_optimize(values.data());
+        });
+        runner.run("mip_chain_kaiser_threads", threads, u64(image_size) * image_size, [&]()
+        {
+            const std::vector<Image> mips = generate_mip_chain(image, EMipFilter::Kaiser);
+            do_not_optimize(mips.data());
+        });
+    }
+    jobs.start();
+}
+
+// Submits from several threads at once, nests parallel_for inside jobs and
+// chains jobs on counters, then checks every job ran exactly once and after
+// its dependency. Returns the number of failed checks.
+static u32 stress_job_system(BenchmarkRunner& runner, const u32 jobs_per_thread)
+{
+    constexpr u32 submitters_count = 3;
+    constexpr u32 nested_ranges = 64;
+    constexpr u32 nested_items = 256;
+    JobSystem& jobs = JobSystem::get();
+    u32 failures = 0;
+
+    runner.run("job_stress", jobs_per_thread, u64(submitters_count + 2) * jobs_per_thread, [&]()
+    {
+        std::atomic<u64> sum{ 0 };
+        std::vector<std::thread> submitters;
+        for (u32 t = 0; t < submitters_count; ++t)
+        {
+            submitters.emplace_back([&]()
+            {
+                JobCounter counter;
+                for (u32 i = 0; i < jobs_per_thread; ++i)
+                {
+                    jobs.run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+                }
+                jobs.wait(counter);
+            });
+        }
+
+        std::atomic<u64> nested_sum{ 0 };
+        jobs.parallel_for(0u, nested_ranges, 1, [&](const u32 first, const u32 last)
+        {
+            for (u32 range = first; range < last; ++range)
+            {
+                jobs.parallel_for(0u, nested_items, 16, [&](const u32 item_first, const u32 item_last)
+                {
+                    nested_sum.fetch_add(item_last - item_first, std::memory_order_relaxed);
+                });
+            }
+        });
+
+        JobCounter producers;
+        JobCounter consumers;
+        std::vector<u8> produced(jobs_per_thread, 0);
+        std::atomic<u32> out_of_order{ 0 };
+        for (u32 i = 0; i < jobs_per_thread; ++i)
+        {
+            jobs.run([&produced, i]() { produced[i] = 1; }, &producers);
+        }
+        for (u32 i = 0; i < jobs_per_thread; ++i)
+        {
+            jobs.run([&produced, &out_of_order, i]() { out_of_order.fetch_add(produced[i] == 0 ? 1 : 0); }, &consumers, &producers);
+        }
+        jobs.wait(consumers);
+        jobs.wait(producers);
+
+        for (std::thread& submitter : submitters)
+        {
+            submitter.join();
+        }
+
+        const u64 expected_sum = u64(submitters_count) * jobs_per_thread * (jobs_per_thread - 1) / 2;
+        if (sum.load() != expected_sum || nested_sum.load() != u64(nested_ranges) * nested_items || out_of_order.load() != 0)
+        {
+            std::cerr << "job_stress: sum " << sum.load() << " of " << expected_sum << ", nested " << nested_sum.load()
+                      << " of " << nested_ranges * nested_items << ", " << out_of_order.load() << " jobs ran before their dependency\n";
+            ++failures;
+        }
+    });
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+    double min_seconds = 0.5;
+    u64 min_iterations = 5;
+    bool quick = false;
+    std::string filter;
+    std::string output_path = "benchmarks.json";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+        {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && has_value)
+        {
+            min_seconds = std::stod(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--min-iterations") == 0 && has_value)
+        {
+            min_iterations = std::stoull(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            quick = true;
+        }
+        else if (std::strcmp(argv[i], "--output") == 0 && has_value)
+        {
+            output_path = argv[++i];
+        }
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    Profiler::get().set_enabled(false);
+    RenderBackend::set(std::make_unique<NullRenderBackend>());
+
+    std::error_code error;
+    const fs::path directory = fs::temp_directory_path(error) / "SimpleEngineBenchmarks";
+    fs::create_directories(directory, error);
+    if (error)
+    {
+        std::cerr << "Can't create '" << directory.string() << "': " << error.message() << "\n";
+        return 1;
+    }
+
+    const auto sizes = [quick](std::vector<u32> values)
+    {
+        if (quick)
+        {
+            values.pop_back();
+        }
+        return values;
+    };
+
+    BenchmarkRunner runner(min_seconds, min_iterations, filter);
+    benchmark_obj(runner, directory, sizes({ 16, 64, 256 }));
+    benchmark_stl(runner, directory, sizes({ 16, 64, 256 }));
+    benchmark_png(runner, sizes({ 64, 256, 1024 }));
+    benchmark_primitives(runner, sizes({ 16, 64, 256 }));
+    benchmark_shapes(runner, sizes({ 1000, 10000, 100000 }));
+    benchmark_event_dispatch(runner, sizes({ 1000, 10000, 100000 }));
+    benchmark_event_bus(runner, sizes({ 1000, 10000, 100000 }));
+    benchmark_trace_log(runner, sizes({ 1000, 10000, 100000 }));
+    benchmark_frame_temporaries(runner, sizes({ 100, 1000, 10000 }));
+
+    const std::vector<ShaderDataType> types = { ShaderDataType::Float3, ShaderDataType::Float2, ShaderDataType::Float4, ShaderDataType::Int,
+                                                ShaderDataType::Float, ShaderDataType::Int2, ShaderDataType::Float3, ShaderDataType::Int4,
+                                                ShaderDataType::Float2, ShaderDataType::Float, ShaderDataType::Int3, ShaderDataType::Float4,
+                                                ShaderDataType::Float3, ShaderDataType::Int, ShaderDataType::Float2, ShaderDataType::Float4 };
+    benchmark_buffer_layout<1>(runner, types);
+    benchmark_buffer_layout<4>(runner, types);
+    benchmark_buffer_layout<BufferLayout::max_elements>(runner, types);
+
+    benchmark_job_scaling(runner, quick ? 1 << 18 : 1 << 22, quick ? 256 : 1024);
+    const u32 job_failures = stress_job_system(runner, quick ? 1000 : 10000);
+
+    fs::remove_all(directory, error);
+    RenderBackend::release();
+
+    runner.print_table();
+    return runner.write_json(output_path.c_str()) && job_failures == 0 ? 0 : 1;
+}
@@ -1,11 +1,53 @@
 #ifndef APPLICATION_HPP
 #define APPLICATION_HPP
 #include "SimpleEngineCore/Types.hpp"
-#include "SimpleEngineCore/Event.hpp"
+#include "SimpleEngineCore/EventBus.hpp"
 #include <memory>
+#include <string>
 
 namespace SimpleEngine {
 
+enum class EBenchmarkBackend
+{
+    OpenGL,
+    // Engine submission cost only: the scene renders into a backend that drops every call
+    Null
+};
+
+struct BenchmarkSettings
+{
+    u32 width = 1280;
+    u32 height = 720;
+    // Rendered from the first camera pose and left out of the report
+    u32 warmup_frames = 60;
+    u32 frames = 600;
+    u32 torch_instances = 10000;
+    std::string report_path = "benchmark_report.json";
+    EBenchmarkBackend backend = EBenchmarkBackend::OpenGL;
+    // When set, the backend command stream of the whole run is saved there
+    std::string commands_path;
+    // Fails the run if a frame after warm-up allocates from the heap outside
+    // ImGui and the profiler; needs SIMPLE_ENGINE_TRACK_ALLOCATIONS
+    bool fail_on_frame_allocations = false;
+};
+
+// start() advances the simulation in fixed steps and renders as often as
+// pacing allows, interpolating between the last two steps
+struct LoopSettings
+{
+    // Simulation steps per second; on_fixed_update() always gets 1 / simulation_rate
+    double simulation_rate = 60.0;
+    // Frames per second to pace rendering to; 0 leaves it to vsync
+    double target_fps = 0.0;
+    // 0 presents immediately, 1 waits for vsync, 2 for every other one
+    i32 swap_interval = 1;
+    // Steps run at most per frame; the rest of a longer hitch is dropped
+    u32 max_steps_per_frame = 8;
+    // Submits GL on its own thread, overlapping the next frame's update with
+    // this one's rendering. on_update() must then not touch GL.
+    bool render_thread = true;
+};
+
 class Application
 {
 public:
@@ -16,14 +58,25 @@ public:
     Application& operator=(const Application&) = delete;
     Application& operator=(Application&&) = delete;
 
+    // Takes effect at the next start()
+    void set_loop_settings(const LoopSettings& settings) { m_loop_settings = settings; }
     virtual i32 start(u32 window_width, u32 window_height, const char* title);
+    // Renders the scene in a headless window along a fixed camera path, one
+    // pose per frame regardless of timing, and writes a JSON report
+    i32 run_benchmark(const BenchmarkSettings& settings);
 
+    // Once per simulation step, dt in seconds
+    virtual void on_fixed_update(const double /*dt*/){}
+    // Once per rendered frame
     virtual void on_update(){}
 
 private:
     std::unique_ptr<class Window> m_pWindow;
+    std::unique_ptr<class FramePacer> m_p_frame_pacer;
+    LoopSettings m_loop_settings;
 
-    EventDispatcher m_event_dispatcher;
+    // Filled by the window callbacks, dispatched at the start of each frame
+    EventBus m_event_bus;
 
     bool m_bCloseWindow = false;
 };
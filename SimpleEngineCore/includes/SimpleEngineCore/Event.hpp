@@ -3,6 +3,7 @@
 #include "Types.hpp"
 #include <functional>
 #include <array>
+#include <vector>
 
 namespace SimpleEngine {
 
@@ -25,8 +26,12 @@ struct BaseEvent
 {
     virtual ~BaseEvent() = default;
     virtual EventType get_type() const = 0;
+
+    // Monotonic Profiler::now_ns() when the window received it, 0 if unknown
+    u64 time_ns = 0;
 };
 
+// Calls every listener added for an event's type, in the order they were added
 class EventDispatcher
 {
 public:
@@ -35,24 +40,20 @@ public:
     {
         auto baseCallback = [func = std::move(callback)](BaseEvent& e)
         {
-            if(e.get_type() == EventType::type)
-            {
-                func(static_cast<EventType&>(e));
-            }
+            func(static_cast<EventType&>(e));
         };
-        m_eventCallbacks[static_cast<size_t>(EventType::type)] = std::move(baseCallback);
+        m_eventCallbacks[static_cast<size_t>(EventType::type)].push_back(std::move(baseCallback));
     }
 
     void dispatch(BaseEvent& event)
     {
-        auto& callback = m_eventCallbacks[static_cast<size_t>(event.get_type())];
-        if(callback)
+        for (auto& callback : m_eventCallbacks[static_cast<size_t>(event.get_type())])
         {
             callback(event);
         }
     }
 private:
-    std::array<std::function<void(BaseEvent&)>, static_cast<size_t>(EventType::EventsCount)> m_eventCallbacks;
+    std::array<std::vector<std::function<void(BaseEvent&)>>, static_cast<size_t>(EventType::EventsCount)> m_eventCallbacks;
 };
 
 struct EventMouseMoved : public BaseEvent
@@ -0,0 +1,94 @@
+#ifndef EVENT_BUS_HPP
+#define EVENT_BUS_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Event.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace SimpleEngine {
+
+// Queues events from any thread and dispatches them on the owning thread in
+// one batch per frame. Events are copied into fixed-size records of a ring
+// allocated once (a bounded multi-producer queue: producers claim a record
+// with one CAS, the consumer needs none), so neither posting nor dispatching
+// allocates. Consecutive mouse moves are coalesced into the last one.
+class EventBus
+{
+public:
+    static constexpr size_t capacity = 1024;
+    static constexpr size_t record_size = 32;
+
+    EventBus();
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // Any thread. False, and the event is dropped, when the ring is full.
+    template<typename T>
+    bool post(const T& event);
+    // Copies the event as its concrete type
+    bool post(const BaseEvent& event);
+
+    // Listeners run in the order they were added; add them before dispatching
+    template<typename T>
+    void add_event_listener(std::function<void(T&)> callback)
+    {
+        m_dispatcher.add_event_listener<T>(std::move(callback));
+    }
+
+    // Owning thread only: dispatches the events posted so far in order.
+    // Events posted by listeners wait for the next call.
+    void dispatch_pending();
+
+    u64 get_dropped_events() const noexcept { return m_dropped_events.load(std::memory_order_relaxed); }
+    u64 get_coalesced_events() const noexcept { return m_coalesced_events; }
+
+private:
+    struct Record
+    {
+        // Equal to the position a producer may claim it at, one more once
+        // written, and `capacity` more once the consumer is done with it
+        std::atomic<size_t> sequence;
+        BaseEvent* event = nullptr;
+        alignas(std::max_align_t) unsigned char storage[record_size];
+    };
+
+    template<typename T>
+    void write(Record& record, const T& event)
+    {
+        static_assert(std::is_base_of<BaseEvent, T>::value, "Events derive from BaseEvent");
+        static_assert(sizeof(T) <= record_size && alignof(T) <= alignof(std::max_align_t), "Event doesn't fit a record");
+        record.event = new (record.storage) T(event);
+    }
+
+    Record* claim();
+    void publish(Record& record);
+
+    EventDispatcher m_dispatcher;
+    std::unique_ptr<Record[]> m_records;
+    alignas(64) std::atomic<size_t> m_enqueue_position{ 0 };
+    alignas(64) size_t m_dequeue_position = 0;
+    std::atomic<u64> m_dropped_events{ 0 };
+    u64 m_coalesced_events = 0;
+};
+
+template<typename T>
+bool EventBus::post(const T& event)
+{
+    Record* record = claim();
+    if (record == nullptr)
+    {
+        return false;
+    }
+    write(*record, event);
+    publish(*record);
+    return true;
+}
+
+}
+
+#endif // EVENT_BUS_HPP
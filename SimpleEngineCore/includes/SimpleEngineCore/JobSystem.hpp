@@ -0,0 +1,152 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SimpleEngine {
+
+struct Job;
+
+// Counts jobs that haven't finished yet. Jobs can be made to start only once
+// a counter drops to zero. Destroy it only after JobSystem::wait() on it
+// returned: a finishing job may still be releasing its dependents until then.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool is_done() const noexcept { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<u32> m_pending{ 0 };
+    std::mutex m_mutex;
+    // Jobs waiting for this counter to reach zero
+    std::vector<Job*> m_dependents;
+};
+
+// Fixed-capacity Chase-Lev deque. The owning thread pushes and pops at the
+// bottom; any other thread steals from the top. push() fails when full.
+class WorkStealingDeque
+{
+public:
+    static constexpr i64 capacity = 4096;
+
+    bool push(Job* job) noexcept;
+    Job* pop() noexcept;
+    Job* steal() noexcept;
+
+private:
+    alignas(64) std::atomic<i64> m_top{ 0 };
+    alignas(64) std::atomic<i64> m_bottom{ 0 };
+    std::atomic<Job*> m_jobs[capacity];
+};
+
+// Runs jobs on a worker thread per hardware thread but one. Each worker, and
+// the thread that first called get(), owns a deque it pushes new jobs to and
+// pops from (most recent first, while its data is in cache); idle workers
+// steal the oldest job of another deque. Other threads submit through a
+// shared locked queue. wait() runs jobs instead of blocking, so waiting
+// inside a job, or nesting parallel_for, doesn't deadlock.
+class JobSystem
+{
+public:
+    using JobFn = std::function<void()>;
+
+    static JobSystem& get();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Replaces the workers so that `threads_count` threads run jobs, counting
+    // the waiting caller; 0 uses every hardware thread. Only while no jobs
+    // are queued or running, e.g. to measure scaling.
+    void start(const u32 threads_count = 0);
+    // Threads that run jobs: the workers and the waiting caller
+    u32 get_threads_count() const noexcept { return static_cast<u32>(m_workers.size()) + 1; }
+
+    // `counter`, if any, is incremented now and decremented when `fn` returns.
+    // With `dependency`, `fn` doesn't start before that counter drops to zero.
+    void run(JobFn fn, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+    // Runs other jobs until `counter` drops to zero
+    void wait(JobCounter& counter);
+
+    // Calls fn(first, last) over [begin, end) in ranges of `grain` items, the
+    // first one on the calling thread, and returns once all are done
+    template <typename RangeFn>
+    void parallel_for(const u32 begin, const u32 end, const u32 grain, const RangeFn& fn);
+
+    // Grain splitting `count` items into a few ranges per thread, or into at
+    // most `max_ranges` when that's not 0
+    u32 get_grain(const u32 count, const u32 max_ranges = 0) const noexcept;
+
+private:
+    JobSystem();
+
+    void stop();
+    void worker_loop(const u32 index);
+    void submit(Job* job);
+    // Finds a job in the caller's deque, the shared queue or another deque
+    Job* find_job();
+    void execute(Job* job);
+    void finish(JobCounter& counter);
+
+    // Index 0 is the thread that created the job system
+    std::vector<std::unique_ptr<WorkStealingDeque>> m_deques;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_shared_mutex;
+    std::deque<Job*> m_shared_jobs;
+    std::atomic<u32> m_shared_count{ 0 };
+
+    // Jobs queued in any deque or the shared queue, for sleeping workers
+    std::atomic<u32> m_queued{ 0 };
+    std::atomic<u32> m_sleeping{ 0 };
+    std::atomic<bool> m_stopping{ false };
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake;
+};
+
+template <typename RangeFn>
+void JobSystem::parallel_for(const u32 begin, const u32 end, const u32 grain, const RangeFn& fn)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+    const u32 step = std::max(grain, 1u);
+    if (end - begin <= step || m_workers.empty())
+    {
+        fn(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+    u32 first = begin + step;
+    while (first < end)
+    {
+        const u32 last = first + std::min(step, end - first);
+        run([&fn, first, last]() { fn(first, last); }, &counter);
+        first = last;
+    }
+    fn(begin, begin + step);
+    wait(counter);
+}
+
+}
+
+#endif // JOB_SYSTEM_HPP
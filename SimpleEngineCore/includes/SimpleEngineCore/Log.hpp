@@ -2,8 +2,20 @@
 #define LOG_HPP
 #include <spdlog/spdlog.h>
 
+#ifdef SIMPLE_ENGINE_TRACE_LOG
+#include "SimpleEngineCore/TraceLog.hpp"
+#endif
+
 namespace SimpleEngine {
-#ifdef NDEBUG
+#if defined(SIMPLE_ENGINE_TRACE_LOG)
+
+// In every build type, through the binary trace log: see TraceLog
+#define LOG_INFO(...)       SIMPLE_ENGINE_TRACE(::SimpleEngine::ETraceLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)       SIMPLE_ENGINE_TRACE(::SimpleEngine::ETraceLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...)      SIMPLE_ENGINE_TRACE(::SimpleEngine::ETraceLevel::Error, __VA_ARGS__)
+#define LOG_CRITICAL(...)   SIMPLE_ENGINE_TRACE(::SimpleEngine::ETraceLevel::Critical, __VA_ARGS__)
+
+#elif defined(NDEBUG)
 
 #define LOG_INFO(...)
 #define LOG_WARN(...)
@@ -17,7 +29,7 @@ namespace SimpleEngine {
 #define LOG_ERROR(...)      spdlog::error(__VA_ARGS__)
 #define LOG_CRITICAL(...)   spdlog::critical(__VA_ARGS__)
 
-#endif // NDEBUG
+#endif // SIMPLE_ENGINE_TRACE_LOG
 }
 
 #endif // LOG_HPP
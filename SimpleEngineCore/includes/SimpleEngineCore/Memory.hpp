@@ -0,0 +1,409 @@
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Who asked for the memory, for the per-subsystem report
+enum class EMemoryTag : u8
+{
+    General,
+    Rendering,
+    Frame,      // blocks of the per-frame arenas; what is carved from them goes to the caller's tag
+    Assets,
+    Streaming,
+    Profiler,
+    Jobs,
+    Editor,     // ImGui and the panels built with it
+    Count
+};
+
+// Heap allocations made by this thread while the scope is alive are
+// reported under `tag` (see AllocationTracker); scopes nest
+class MemoryTagScope
+{
+public:
+    explicit MemoryTagScope(const EMemoryTag tag) noexcept;
+    ~MemoryTagScope();
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+    static EMemoryTag get_current() noexcept;
+
+private:
+    EMemoryTag m_previous;
+};
+
+// Counters per tag, updated by the arenas and pools below. Pools only report
+// the blocks they hold: counting every object would cost what they save.
+class MemoryStats
+{
+public:
+    struct Counters
+    {
+        u64 reserved_bytes = 0;      // held from the heap right now
+        u64 peak_reserved_bytes = 0;
+        u64 allocated_bytes = 0;     // handed out since start
+        u64 allocations_count = 0;
+    };
+
+    static MemoryStats& get();
+    static const char* get_tag_name(const EMemoryTag tag);
+
+    void on_reserve(const EMemoryTag tag, const size_t size);
+    void on_release(const EMemoryTag tag, const size_t size);
+    void on_allocate(const EMemoryTag tag, const size_t size)
+    {
+        TagCounters& counters = m_counters[static_cast<size_t>(tag)];
+        counters.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        counters.allocations_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Counters get_counters(const EMemoryTag tag) const;
+
+private:
+    struct TagCounters
+    {
+        std::atomic<u64> reserved_bytes{ 0 };
+        std::atomic<u64> peak_reserved_bytes{ 0 };
+        std::atomic<u64> allocated_bytes{ 0 };
+        std::atomic<u64> allocations_count{ 0 };
+    };
+
+    std::array<TagCounters, static_cast<size_t>(EMemoryTag::Count)> m_counters;
+};
+
+// Bump allocator over a list of blocks: allocating moves a pointer, nothing
+// is freed on its own. reset() drops everything at once, rewind() back to a
+// marker. Blocks are kept, so an arena that is reset every frame stops
+// touching the heap once it has seen its largest frame. One thread at a time.
+class LinearArena
+{
+public:
+    static constexpr size_t default_block_size = 64 * 1024;
+
+    struct Marker
+    {
+        size_t block = 0;
+        size_t offset = 0;
+    };
+
+    explicit LinearArena(const EMemoryTag tag, const size_t block_size = default_block_size);
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // The calling thread's arena for data that doesn't outlive the frame;
+    // the thread's frame loop resets it once the frame is done
+    static LinearArena& get_frame();
+    // The calling thread's arena for load-time temporaries, used through an
+    // ArenaScope
+    static LinearArena& get_scratch();
+
+    void* allocate(const size_t size, const size_t alignment, const EMemoryTag tag);
+    // Everything allocated is gone. Blocks are merged into one large enough
+    // for what the arena held, so the next round fits in a single block.
+    void reset();
+
+    Marker get_marker() const noexcept { return { m_block, m_offset }; }
+    // Everything allocated after `marker` is gone
+    void rewind(const Marker& marker) noexcept;
+
+    size_t get_used() const noexcept;
+    size_t get_reserved() const noexcept { return m_reserved; }
+
+private:
+    struct Block
+    {
+        u8* data = nullptr;
+        size_t size = 0;
+    };
+
+    void add_block(const size_t size);
+    void release_blocks();
+
+    EMemoryTag m_tag;
+    size_t m_block_size;
+    std::vector<Block> m_blocks;
+    size_t m_block = 0;
+    size_t m_offset = 0;
+    size_t m_reserved = 0;
+};
+
+// Rewinds an arena to where it was when the scope began
+class ArenaScope
+{
+public:
+    explicit ArenaScope(LinearArena& arena) noexcept
+        : m_arena(arena),
+          m_marker(arena.get_marker())
+    {
+    }
+    ~ArenaScope() { m_arena.rewind(m_marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    LinearArena& m_arena;
+    LinearArena::Marker m_marker;
+};
+
+// Standard allocator over a LinearArena. deallocate() does nothing, so a
+// container that grows leaves its old storage behind until the arena resets.
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator(LinearArena& arena, const EMemoryTag tag) noexcept
+        : m_p_arena(&arena),
+          m_tag(tag)
+    {
+    }
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : m_p_arena(other.get_arena()),
+          m_tag(other.get_tag())
+    {
+    }
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(m_p_arena->allocate(sizeof(T) * count, alignof(T), m_tag));
+    }
+    void deallocate(T*, const size_t) noexcept {}
+
+    LinearArena* get_arena() const noexcept { return m_p_arena; }
+    EMemoryTag get_tag() const noexcept { return m_tag; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_p_arena == other.get_arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return m_p_arena != other.get_arena(); }
+
+private:
+    LinearArena* m_p_arena;
+    EMemoryTag m_tag;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename T>
+ArenaAllocator<T> frame_allocator(const EMemoryTag tag)
+{
+    return ArenaAllocator<T>(LinearArena::get_frame(), tag);
+}
+
+// Fixed-size slots for one type, carved from blocks and recycled through a
+// free list. Blocks are only returned when the pool is destroyed, by which
+// time every object must have been destroyed. Any thread may create and
+// destroy: each thread keeps a few free slots of its own and only takes the
+// lock to trade a batch of them with the shared list. Slots cached by a
+// thread that exits stay unused until the pool goes.
+template <typename T>
+class ObjectPool
+{
+public:
+    static constexpr u32 thread_cache_size = 64;
+
+    explicit ObjectPool(const EMemoryTag tag, const size_t objects_per_block = 256)
+        : m_tag(tag),
+          m_objects_per_block(objects_per_block > 0 ? objects_per_block : 1),
+          m_id(s_next_id.fetch_add(1, std::memory_order_relaxed))
+    {
+        // Both outlive a pool that is itself a static
+        MemoryStats::get();
+        LiveIds& live = live_ids();
+        std::lock_guard<std::mutex> lock(live.mutex);
+        live.ids.push_back(m_id);
+    }
+    ~ObjectPool()
+    {
+        {
+            LiveIds& live = live_ids();
+            std::lock_guard<std::mutex> lock(live.mutex);
+            live.ids.erase(std::find(live.ids.begin(), live.ids.end(), m_id));
+        }
+        // Other threads notice on their next call to any pool of this type
+        s_generation.fetch_add(1, std::memory_order_release);
+        ThreadCache& cache = thread_cache();
+        if (cache.pool_id == m_id)
+        {
+            cache = ThreadCache{};
+        }
+
+        for (Slot* block : m_blocks)
+        {
+            ::operator delete(block);
+        }
+        MemoryStats::get().on_release(m_tag, m_blocks.size() * m_objects_per_block * sizeof(Slot));
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        ThreadCache& cache = thread_cache();
+        rebind(cache);
+        Slot* slot = nullptr;
+        if (cache.pool_id == m_id && cache.free != nullptr)
+        {
+            slot = cache.free;
+            cache.free = slot->next;
+            --cache.count;
+        }
+        else
+        {
+            slot = take_shared(cache);
+        }
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* object)
+    {
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        ThreadCache& cache = thread_cache();
+        rebind(cache);
+        if (cache.pool_id == m_id && cache.count < thread_cache_size)
+        {
+            slot->next = cache.free;
+            cache.free = slot;
+            ++cache.count;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        slot->next = m_free;
+        m_free = slot;
+    }
+
+private:
+    union Slot
+    {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Free slots of one pool, the first live one to use it on this thread;
+    // other pools of the same type go through the lock every time
+    struct ThreadCache
+    {
+        u64 pool_id = 0;
+        Slot* free = nullptr;
+        u32 count = 0;
+        u64 generation = 0; // s_generation when pool_id was last known alive
+    };
+
+    struct LiveIds
+    {
+        std::mutex mutex;
+        std::vector<u64> ids;
+    };
+
+    static ThreadCache& thread_cache()
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static LiveIds& live_ids()
+    {
+        static LiveIds live;
+        return live;
+    }
+
+    // Binds the cache to this pool if it is free or its pool was destroyed;
+    // the slots it held went with that pool's blocks. Only looks the pool up
+    // after some pool of this type was destroyed.
+    void rebind(ThreadCache& cache)
+    {
+        const u64 generation = s_generation.load(std::memory_order_acquire);
+        if (cache.pool_id != 0 && cache.generation == generation)
+        {
+            return;
+        }
+        if (cache.pool_id != 0 && cache.pool_id != m_id)
+        {
+            LiveIds& live = live_ids();
+            std::lock_guard<std::mutex> lock(live.mutex);
+            if (std::find(live.ids.begin(), live.ids.end(), cache.pool_id) != live.ids.end())
+            {
+                cache.generation = generation;
+                return;
+            }
+        }
+        if (cache.pool_id != m_id)
+        {
+            cache = ThreadCache{};
+            cache.pool_id = m_id;
+        }
+        cache.generation = generation;
+    }
+
+    // Returns one slot and refills the thread's cache with up to half its size
+    Slot* take_shared(ThreadCache& cache)
+    {
+        const u32 refill = cache.pool_id == m_id ? thread_cache_size / 2 : 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free == nullptr)
+        {
+            add_block();
+        }
+        Slot* slot = m_free;
+        m_free = slot->next;
+        for (u32 i = 0; i < refill && m_free != nullptr; ++i)
+        {
+            Slot* cached = m_free;
+            m_free = cached->next;
+            cached->next = cache.free;
+            cache.free = cached;
+            ++cache.count;
+        }
+        return slot;
+    }
+
+    // Under m_mutex
+    void add_block()
+    {
+        Slot* block = static_cast<Slot*>(::operator new(m_objects_per_block * sizeof(Slot)));
+        for (size_t i = 0; i < m_objects_per_block; ++i)
+        {
+            block[i].next = i + 1 < m_objects_per_block ? &block[i + 1] : m_free;
+        }
+        m_free = block;
+        m_blocks.push_back(block);
+        MemoryStats::get().on_reserve(m_tag, m_objects_per_block * sizeof(Slot));
+    }
+
+    inline static std::atomic<u64> s_next_id{ 1 };
+    // Bumped by every pool of this type that is destroyed
+    inline static std::atomic<u64> s_generation{ 0 };
+
+    EMemoryTag m_tag;
+    size_t m_objects_per_block;
+    u64 m_id;
+    std::mutex m_mutex;
+    Slot* m_free = nullptr;
+    std::vector<Slot*> m_blocks;
+};
+
+}
+
+#endif // MEMORY_HPP
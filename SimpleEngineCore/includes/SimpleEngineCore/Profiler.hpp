@@ -0,0 +1,136 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace SimpleEngine {
+
+struct ProfileEvent
+{
+    const char* name = nullptr; // must outlive the profiler, string literals in practice
+    u64 start_ns = 0;           // since Profiler construction
+    u64 end_ns = 0;
+    u32 thread = 0;             // Profiler thread index, see get_thread_name()
+    u32 depth = 0;
+};
+
+struct ProfiledFrame
+{
+    u64 number = 0;
+    u64 start_ns = 0;
+    u64 end_ns = 0;
+    std::vector<ProfileEvent> cpu_events;
+    // Arrive a few frames late, already on the CPU timeline
+    std::vector<ProfileEvent> gpu_events;
+};
+
+// Collects scoped CPU markers and GPU timings per frame. Each thread writes
+// its markers to its own fixed-size ring without locking; end_frame() on the
+// main thread drains every ring into the frame history.
+class Profiler
+{
+public:
+    static constexpr size_t ring_capacity = 8192;
+    static constexpr size_t history_frames = 240;
+
+    static Profiler& get();
+
+    u64 now_ns() const;
+
+    void begin_frame();
+    void end_frame();
+
+    // Called by ProfileScope; drops the event if the thread's ring is full
+    void record(const ProfileEvent& event);
+    u32& current_depth();
+
+    void set_thread_name(const char* name);
+    const char* get_thread_name(const u32 thread) const;
+
+    // GPU events of an earlier frame, attached by the next end_frame() if it
+    // is still in the history. Callable from any thread.
+    void add_gpu_events(const u64 frame_number, std::vector<ProfileEvent> events);
+
+    void set_enabled(const bool enabled) noexcept { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool is_enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+    void set_paused(const bool paused) noexcept { m_paused = paused; }
+    bool is_paused() const noexcept { return m_paused; }
+
+    const std::deque<ProfiledFrame>& get_frames() const noexcept { return m_frames; }
+    u64 get_frame_number() const noexcept { return m_frame_number; }
+    u64 get_dropped_events() const noexcept { return m_dropped_events.load(std::memory_order_relaxed); }
+
+    // Every frame in the history as Chrome trace JSON (chrome://tracing, Perfetto)
+    bool export_chrome_trace(const char* path) const;
+
+private:
+    struct ThreadRing
+    {
+        u32 index = 0;
+        const char* name = nullptr;
+        u32 depth = 0;
+        std::atomic<size_t> write{ 0 };
+        std::atomic<size_t> read{ 0 };
+        ProfileEvent events[ring_capacity];
+    };
+
+    Profiler();
+    ThreadRing& thread_ring();
+    void drain(std::vector<ProfileEvent>& events);
+
+    u64 m_start_ticks;
+    std::atomic<bool> m_enabled{ true };
+    bool m_paused = false;
+    std::atomic<u64> m_dropped_events{ 0 };
+
+    mutable std::mutex m_rings_mutex; // only taken when a thread writes its first event
+    std::vector<std::shared_ptr<ThreadRing>> m_rings;
+
+    u64 m_frame_number = 0;
+    ProfiledFrame m_current;
+    std::deque<ProfiledFrame> m_frames;
+
+    std::mutex m_gpu_events_mutex;
+    std::vector<std::pair<u64, std::vector<ProfileEvent>>> m_pending_gpu_events;
+};
+
+// Records [construction, destruction) as one event on the calling thread
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    u64 m_start_ns = 0;
+    bool m_active;
+};
+
+#define SIMPLE_ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SIMPLE_ENGINE_PROFILE_CONCAT(a, b) SIMPLE_ENGINE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef SIMPLE_ENGINE_PROFILE
+
+#define PROFILE_SCOPE(name)  ::SimpleEngine::ProfileScope SIMPLE_ENGINE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION()   PROFILE_SCOPE(__func__)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+
+#endif // SIMPLE_ENGINE_PROFILE
+
+}
+
+#endif // PROFILER_HPP
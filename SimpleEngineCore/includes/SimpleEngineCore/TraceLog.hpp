@@ -0,0 +1,271 @@
+#ifndef TRACE_LOG_HPP
+#define TRACE_LOG_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace SimpleEngine {
+
+enum class ETraceLevel : u8
+{
+    Info,
+    Warn,
+    Error,
+    Critical,
+    Off
+};
+
+// Formats a record's encoded arguments with its format string, appending to `out`
+using TraceDecodeFn = void (*)(fmt::memory_buffer& out, const char* format, const unsigned char* args);
+
+// One per log point, static, so a record refers to it instead of carrying
+// where it came from. Also counts what the rate limit dropped there.
+struct TraceSite
+{
+    ETraceLevel level;
+    const char* file;
+    u32 line;
+    std::atomic<i64> window_start_ns{ 0 };
+    std::atomic<u32> window_count{ 0 };
+    std::atomic<u32> suppressed{ 0 };
+};
+
+// Log points write binary records, the site, a format string literal and the
+// raw arguments (strings copied, truncated to max_string_size), into a ring
+// per thread. A background thread formats them and passes them to spdlog a
+// few times per second, so logging never waits for I/O. A full ring drops
+// the record; Critical records are flushed before the log point returns.
+// A log point below the level costs one relaxed load.
+class TraceLog
+{
+public:
+    static constexpr size_t ring_capacity = 64 * 1024;
+    static constexpr size_t max_string_size = 1024;
+    static constexpr size_t max_arguments = 8;
+    static constexpr u32 default_rate_limit = 100;
+    static constexpr std::chrono::milliseconds flush_interval{ 50 };
+
+    static TraceLog& get();
+    ~TraceLog();
+
+    TraceLog(const TraceLog&) = delete;
+    TraceLog& operator=(const TraceLog&) = delete;
+
+    static bool is_enabled(const ETraceLevel level) noexcept
+    {
+        return static_cast<u8>(level) >= s_level.load(std::memory_order_relaxed);
+    }
+    static void set_level(const ETraceLevel level) noexcept { s_level.store(static_cast<u8>(level), std::memory_order_relaxed); }
+
+    // Records per second and site passed on, the rest are counted and
+    // reported with the next one that is; 0 for no limit
+    void set_rate_limit(const u32 per_second) noexcept { m_rate_limit.store(per_second, std::memory_order_relaxed); }
+
+    template<typename... Args>
+    void write(TraceSite& site, const char* format, const Args&... args);
+
+    // Formats everything written so far, from any thread, on the calling one
+    void flush();
+
+    u64 get_dropped_records() const noexcept { return m_dropped_records.load(std::memory_order_relaxed); }
+
+private:
+    struct RecordHeader
+    {
+        const TraceSite* site; // null: skip to the start of the ring
+        const char* format;
+        TraceDecodeFn decode;
+        std::chrono::system_clock::time_point time;
+        u32 size; // of the arguments following the header
+        u32 suppressed;
+    };
+
+    // Records are written in place and never wrap around the end, so neither
+    // side copies them
+    struct ThreadRing
+    {
+        std::atomic<size_t> write{ 0 };
+        std::atomic<size_t> read{ 0 };
+        // Set when the thread exits; the ring is dropped once drained
+        std::atomic<bool> abandoned{ false };
+        size_t reserved = 0; // where the record being written starts
+        alignas(RecordHeader) unsigned char data[ring_capacity];
+    };
+
+    TraceLog();
+    ThreadRing& thread_ring();
+    // False when the site is over its rate limit for this second
+    bool pass_rate_limit(TraceSite& site, const std::chrono::system_clock::time_point time);
+    // Contiguous room for a record of up to `max_size` bytes, or null when
+    // the ring is too full; commit() publishes the `size` bytes used of it
+    unsigned char* reserve(ThreadRing& ring, const size_t max_size);
+    static void commit(ThreadRing& ring, const size_t size) noexcept
+    {
+        // Keeps every header aligned
+        const size_t aligned = (size + alignof(RecordHeader) - 1) & ~(alignof(RecordHeader) - 1);
+        ring.write.store(ring.reserved + aligned, std::memory_order_release);
+    }
+    void flush_loop();
+
+    static inline std::atomic<u8> s_level{ static_cast<u8>(ETraceLevel::Info) };
+
+    std::atomic<u32> m_rate_limit{ default_rate_limit };
+    std::atomic<u64> m_dropped_records{ 0 };
+    u64 m_reported_dropped_records = 0;
+
+    std::mutex m_rings_mutex; // taken when a thread writes its first record and by flush()
+    std::vector<std::shared_ptr<ThreadRing>> m_rings;
+
+    std::mutex m_drain_mutex;
+    fmt::memory_buffer m_message;
+
+    std::mutex m_flush_mutex;
+    std::condition_variable m_flush_wake;
+    bool m_stopping = false;
+    std::thread m_flush_thread;
+};
+
+namespace TraceEncoding {
+
+// What an argument is stored as: string literals become const char*
+template<typename T>
+using Stored = std::decay_t<const T>;
+
+template<typename T>
+struct IsString : std::bool_constant<std::is_same<T, const char*>::value || std::is_same<T, char*>::value ||
+                                     std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value>
+{
+};
+
+// Strings are decoded as views into the record
+template<typename T>
+using Decoded = std::conditional_t<IsString<T>::value, std::string_view, T>;
+
+template<typename T>
+constexpr size_t max_size() noexcept
+{
+    return IsString<T>::value ? sizeof(u32) + TraceLog::max_string_size : sizeof(T);
+}
+
+inline std::string_view to_view(const char* value) noexcept
+{
+    return value != nullptr ? std::string_view(value) : std::string_view("(null)");
+}
+
+inline std::string_view to_view(const std::string_view value) noexcept
+{
+    return value;
+}
+
+template<typename T>
+unsigned char* encode(unsigned char* out, const T& value)
+{
+    if constexpr (IsString<T>::value)
+    {
+        const std::string_view view = to_view(value);
+        const u32 size = static_cast<u32>(std::min(view.size(), TraceLog::max_string_size));
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), view.data(), size);
+        return out + sizeof(size) + size;
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Log arguments are strings or trivially copyable values");
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+}
+
+template<typename T>
+Decoded<T> decode_one(const unsigned char*& in)
+{
+    if constexpr (IsString<T>::value)
+    {
+        u32 size = 0;
+        std::memcpy(&size, in, sizeof(size));
+        const std::string_view view(reinterpret_cast<const char*>(in + sizeof(size)), size);
+        in += sizeof(size) + size;
+        return view;
+    }
+    else
+    {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+}
+
+// `args` is unused by log points without arguments
+template<typename... Args>
+void decode(fmt::memory_buffer& out, const char* format, [[maybe_unused]] const unsigned char* args)
+{
+    // Braced initialization reads the arguments in order
+    const std::tuple<Decoded<Args>...> values{ decode_one<Args>(args)... };
+    // fmt appends straight into a memory_buffer behind a back_inserter
+    std::apply([&out, format](const auto&... arguments) { fmt::vformat_to(std::back_inserter(out), fmt::string_view(format), fmt::make_format_args(arguments...)); }, values);
+}
+
+}
+
+template<typename... Args>
+void TraceLog::write(TraceSite& site, const char* format, const Args&... args)
+{
+    static_assert(sizeof...(Args) <= max_arguments, "Too many log arguments");
+    const std::chrono::system_clock::time_point time = std::chrono::system_clock::now();
+    if (!pass_rate_limit(site, time))
+    {
+        return;
+    }
+
+    constexpr size_t max_size = sizeof(RecordHeader) + (0 + ... + TraceEncoding::max_size<TraceEncoding::Stored<Args>>());
+    ThreadRing& ring = thread_ring();
+    unsigned char* const record = reserve(ring, max_size);
+    if (record == nullptr)
+    {
+        return;
+    }
+    unsigned char* end = record + sizeof(RecordHeader);
+    ((end = TraceEncoding::encode<TraceEncoding::Stored<Args>>(end, args)), ...);
+
+    // Read first: an exchange is a locked instruction even when there's nothing to take
+    const u32 suppressed = site.suppressed.load(std::memory_order_relaxed) > 0 ? site.suppressed.exchange(0, std::memory_order_relaxed) : 0;
+    const RecordHeader header{ &site, format, &TraceEncoding::decode<TraceEncoding::Stored<Args>...>, time,
+                               static_cast<u32>(end - record - sizeof(RecordHeader)), suppressed };
+    std::memcpy(record, &header, sizeof(RecordHeader));
+    commit(ring, static_cast<size_t>(end - record));
+    if (site.level >= ETraceLevel::Critical)
+    {
+        flush();
+    }
+}
+
+}
+
+// A static TraceSite per expansion; the format must be a string literal
+#define SIMPLE_ENGINE_TRACE(level, format, ...)                                                            \
+    do                                                                                                      \
+    {                                                                                                       \
+        if (::SimpleEngine::TraceLog::is_enabled(level))                                                    \
+        {                                                                                                   \
+            static ::SimpleEngine::TraceSite simple_engine_trace_site{ level, __FILE__, __LINE__ };          \
+            ::SimpleEngine::TraceLog::get().write(simple_engine_trace_site, format, ##__VA_ARGS__);        \
+        }                                                                                                   \
+    } while (false)
+
+#endif // TRACE_LOG_HPP
@@ -0,0 +1,10 @@
+#version 460
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec3 vertex_color;
+out vec3 color;
+uniform mat4 view_matrix;
+uniform mat4 model_matrix;
+void main() {
+    color = vertex_color;
+    gl_Position = view_matrix * model_matrix * vec4(vertex_position, 1.0);
+}
@@ -0,0 +1,61 @@
+#version 460
+
+struct DrawData
+{
+	mat4 model_matrix;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	vec4 uv_rect;
+	float layer;
+	float max_lod;
+};
+
+layout(std430, binding = 0) readonly buffer DrawBuffer
+{
+	DrawData draws[];
+};
+
+struct PointLight
+{
+	vec3 position;
+	float intensity;
+	vec3 color;
+	float constant;
+	float linear;
+	float quadratic;
+};
+
+uniform PointLight pointLight;
+uniform sampler2DArray diffuseTex;
+uniform sampler2D specularTex;
+uniform vec3 cameraPos;
+in vec2 texture_coord;
+in vec3 vs_position;
+in vec3 vs_normal;
+flat in int draw_index;
+out vec4 frag_color;
+
+void main() {
+	DrawData draw = draws[draw_index];
+	float distance = length(pointLight.position - vs_position);
+	float attenuation = pointLight.constant / (1.f + pointLight.linear * distance
++ pointLight.quadratic * (distance * distance));
+
+	vec3 posToLightDirVec = normalize(pointLight.position - vs_position);
+	vec3 diffuseFinal = draw.diffuse.rgb * clamp(dot(posToLightDirVec, normalize(vs_normal)), 0, 1);
+
+	vec3 lightToPosDirVec = normalize(vs_position - pointLight.position);
+	vec3 reflectDirVec = normalize(reflect(lightToPosDirVec, normalize(vs_normal)));
+	vec3 posToViewDirVec = normalize(cameraPos - vs_position);
+	float specularConstant = pow(max(dot(posToViewDirVec, reflectDirVec), 0), 35);
+	vec3 specularFinal = draw.specular.rgb * specularConstant * texture(specularTex, texture_coord).rgb;
+
+	// Repeat inside the atlas rectangle; the LOD comes from the unwrapped coordinate so fract() leaves no seams
+	vec2 atlas_coord = draw.uv_rect.xy + fract(texture_coord) * draw.uv_rect.zw;
+	float lod = min(textureQueryLod(diffuseTex, texture_coord * draw.uv_rect.zw).y, draw.max_lod);
+	vec4 diffuseTexel = textureLod(diffuseTex, vec3(atlas_coord, draw.layer), lod);
+
+	vec3 light = (draw.ambient.rgb + diffuseFinal + specularFinal) * attenuation;
+	frag_color = diffuseTexel * vec4(light, 1.f);
+}
@@ -0,0 +1,35 @@
+#version 460
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_texture;
+layout(location = 2) in vec3 vertex_normal;
+
+struct DrawData
+{
+	mat4 model_matrix;
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	vec4 uv_rect;
+	float layer;
+	float max_lod;
+};
+
+layout(std430, binding = 0) readonly buffer DrawBuffer
+{
+	DrawData draws[];
+};
+
+uniform mat4 view_matrix;
+uniform int draw_offset;
+out vec2 texture_coord;
+out vec3 vs_position;
+out vec3 vs_normal;
+flat out int draw_index;
+void main() {
+    draw_index = draw_offset + gl_DrawID;
+    mat4 model_matrix = draws[draw_index].model_matrix;
+    vs_position = vec4(model_matrix * vec4(vertex_position, 1.f)).xyz;
+    vs_normal = mat3(model_matrix) * vertex_normal;
+    texture_coord = vertex_texture;
+    gl_Position = view_matrix * model_matrix * vec4(vertex_position, 1.0);
+}
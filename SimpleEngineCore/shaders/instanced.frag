@@ -0,0 +1,47 @@
+#version 460
+
+struct Material
+{
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	sampler2D diffuseTex;
+	sampler2D specularTex;
+};
+
+struct PointLight
+{
+	vec3 position;
+	float intensity;
+	vec3 color;
+	float constant;
+	float linear;
+	float quadratic;
+};
+
+uniform Material material;
+uniform PointLight pointLight;
+uniform vec3 cameraPos;
+in vec2 texture_coord;
+in vec3 vs_position;
+in vec3 vs_normal;
+in vec4 vs_color;
+out vec4 frag_color;
+
+void main() {
+	float distance = length(pointLight.position - vs_position);
+	float attenuation = pointLight.constant / (1.f + pointLight.linear * distance
++ pointLight.quadratic * (distance * distance));
+
+	vec3 posToLightDirVec = normalize(pointLight.position - vs_position);
+	vec3 diffuseFinal = material.diffuse * clamp(dot(posToLightDirVec, normalize(vs_normal)), 0, 1);
+
+	vec3 lightToPosDirVec = normalize(vs_position - pointLight.position);
+	vec3 reflectDirVec = normalize(reflect(lightToPosDirVec, normalize(vs_normal)));
+	vec3 posToViewDirVec = normalize(cameraPos - vs_position);
+	float specularConstant = pow(max(dot(posToViewDirVec, reflectDirVec), 0), 35);
+	vec3 specularFinal = material.specular * specularConstant * texture(material.specularTex, texture_coord).rgb;
+
+	vec3 light = (material.ambient + diffuseFinal + specularFinal) * attenuation;
+	frag_color = texture(material.diffuseTex, texture_coord) * vs_color * vec4(light, 1.f);
+}
@@ -0,0 +1,20 @@
+#version 460
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_texture;
+layout(location = 2) in vec3 vertex_normal;
+layout(location = 3) in mat4 instance_matrix;
+layout(location = 7) in vec4 instance_color;
+out vec2 texture_coord;
+out vec3 vs_position;
+out vec3 vs_normal;
+out vec4 vs_color;
+uniform mat4 view_matrix;
+uniform mat4 model_matrix;
+void main() {
+    mat4 world_matrix = model_matrix * instance_matrix;
+    vs_position = vec4(world_matrix * vec4(vertex_position, 1.f)).xyz;
+    vs_normal = mat3(world_matrix) * vertex_normal;
+    vs_color = instance_color;
+    texture_coord = vertex_texture;
+    gl_Position = view_matrix * world_matrix * vec4(vertex_position, 1.0);
+}
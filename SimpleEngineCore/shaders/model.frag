@@ -0,0 +1,75 @@
+#version 460
+
+struct Material
+{
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	sampler2D diffuseTex;
+	sampler2D specularTex;
+};
+
+struct PointLight
+{
+	vec3 position;
+	float intensity;
+	vec3 color;
+	float constant;
+	float linear;
+	float quadratic;
+};
+
+uniform Material material;
+uniform PointLight pointLight;
+uniform sampler2D tex0;
+uniform vec3 cameraPos;
+in vec2 texture_coord;
+in vec3 vs_position;
+in vec3 vs_normal;
+out vec4 frag_color;
+
+vec3 calculateAmbient(Material material)
+{
+	return material.ambient;
+}
+
+vec3 calculateDiffuse(Material material, vec3 vs_position, vec3 vs_normal, vec3 lightPos0)
+{
+	vec3 posToLightDirVec = normalize(lightPos0 - vs_position);
+	float diffuse = clamp(dot(posToLightDirVec, normalize(vs_normal)), 0, 1);
+	vec3 diffuseFinal = material.diffuse * diffuse;
+
+	return diffuseFinal;
+}
+
+vec3 calculateSpecular(Material material, vec3 vs_position, vec3 vs_normal, vec3 lightPos0, vec3 cameraPos)
+{
+	vec3 lightToPosDirVec = normalize(vs_position - lightPos0);
+	vec3 reflectDirVec = normalize(reflect(lightToPosDirVec, normalize(vs_normal)));
+	vec3 posToViewDirVec = normalize(cameraPos - vs_position);
+	float specularConstant = pow(max(dot(posToViewDirVec, reflectDirVec), 0), 35);
+	vec3 specularFinal = material.specular * specularConstant * texture(material.specularTex, texture_coord).rgb;
+	//vec3 specularFinal = material.specular * specularConstant;
+
+	return specularFinal;
+}
+void main() {
+	float distance = length(pointLight.position - vs_position);
+	float attenuation = pointLight.constant / (1.f + pointLight.linear * distance
++ pointLight.quadratic * (distance * distance));
+
+	vec3 ambientFinal = calculateAmbient(material);
+	vec3 diffuseFinal = calculateDiffuse(material, vs_position, vs_normal, pointLight.position);
+	vec3 specularFinal = calculateSpecular(material, vs_position, vs_normal, pointLight.position, cameraPos);
+
+	ambientFinal *= attenuation;
+	diffuseFinal *= attenuation;
+	specularFinal *= attenuation;
+
+	frag_color = 
+	texture(material.diffuseTex, texture_coord) * (vec4(ambientFinal, 1.f) 
++ vec4(diffuseFinal, 1.f) + vec4(specularFinal, 1.f));
+
+	//frag_color = (vec4(ambientFinal, 1.f) + vec4(diffuseFinal, 1.f) + vec4(specularFinal, 1.f));
+    //frag_color = texture(tex0, texture_coord);
+}
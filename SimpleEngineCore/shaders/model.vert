@@ -0,0 +1,15 @@
+#version 460
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec2 vertex_texture;
+layout(location = 2) in vec3 vertex_normal;
+out vec2 texture_coord;
+out vec3 vs_position;
+out vec3 vs_normal;
+uniform mat4 view_matrix;
+uniform mat4 model_matrix;
+void main() {
+    vs_position = vec4(model_matrix * vec4(vertex_position, 1.f)).xyz;
+    vs_normal = mat3(model_matrix) * vertex_normal;
+    texture_coord = vertex_texture;
+    gl_Position = view_matrix * model_matrix * vec4(vertex_position, 1.0);
+}
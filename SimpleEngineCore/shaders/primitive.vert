@@ -0,0 +1,10 @@
+#version 460
+layout(location = 0) in vec3 vertex_position;
+layout(location = 1) in vec3 vertex_color;
+out vec3 color;
+uniform mat4 camMatrix;
+uniform mat4 rotationMatrix;
+void main() {
+    color = vertex_color;
+    gl_Position = camMatrix * rotationMatrix * vec4(vertex_position, 1.0);
+}
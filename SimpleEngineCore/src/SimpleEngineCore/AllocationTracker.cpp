@@ -0,0 +1,465 @@
+#include "SimpleEngineCore/AllocationTracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__has_include)
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define SIMPLE_ENGINE_HAS_BACKTRACE
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define SIMPLE_ENGINE_NOINLINE __declspec(noinline)
+#else
+#define SIMPLE_ENGINE_NOINLINE __attribute__((noinline))
+#endif
+
+namespace SimpleEngine {
+
+// Everything below may run inside operator new before main() and after
+// statics are destroyed, so it is all constant-initialized and never frees
+namespace {
+
+struct ThreadCounters
+{
+    std::atomic<u64> counts[AllocationTracker::tags_count];
+    std::atomic<u64> bytes[AllocationTracker::tags_count];
+    std::atomic<u64> frees;
+    std::atomic<bool> frame_thread;
+};
+
+// Threads past the last slot share it
+constexpr u32 max_threads = 128;
+constexpr u32 max_call_sites = 1024;
+
+ThreadCounters s_threads[max_threads];
+std::atomic<u32> s_threads_count{ 0 };
+std::atomic<u32> s_sampling_interval{ AllocationTracker::default_sampling_interval };
+
+AllocationTracker::CallSite s_call_sites[max_call_sites];
+std::atomic_flag s_call_sites_lock = ATOMIC_FLAG_INIT;
+
+thread_local ThreadCounters* t_counters = nullptr;
+
+#ifdef SIMPLE_ENGINE_TRACK_ALLOCATIONS
+constexpr u32 max_call_site_probes = 16;
+// track_allocation() and operator new
+constexpr u32 skipped_frames = 2;
+
+thread_local u32 t_sample_countdown = 0;
+// Set while this thread holds the call site table, so allocations made
+// meanwhile don't try to sample into it
+thread_local bool t_in_call_sites = false;
+#endif
+
+class CallSitesLock
+{
+public:
+    CallSitesLock() noexcept
+    {
+        while (s_call_sites_lock.test_and_set(std::memory_order_acquire))
+        {
+        }
+#ifdef SIMPLE_ENGINE_TRACK_ALLOCATIONS
+        t_in_call_sites = true;
+#endif
+    }
+    ~CallSitesLock()
+    {
+#ifdef SIMPLE_ENGINE_TRACK_ALLOCATIONS
+        t_in_call_sites = false;
+#endif
+        s_call_sites_lock.clear(std::memory_order_release);
+    }
+};
+
+ThreadCounters& thread_counters() noexcept
+{
+    if (t_counters == nullptr)
+    {
+        const u32 index = s_threads_count.fetch_add(1, std::memory_order_relaxed);
+        t_counters = &s_threads[std::min(index, max_threads - 1)];
+    }
+    return *t_counters;
+}
+
+}
+
+#ifdef SIMPLE_ENGINE_TRACK_ALLOCATIONS
+
+static void record_call_site(void* const* frames, const u32 frames_count, const EMemoryTag tag, const size_t size) noexcept
+{
+    // FNV-1a over the return addresses and the tag
+    u64 hash = 14695981039346656037ull ^ static_cast<u64>(tag);
+    for (u32 i = 0; i < frames_count; ++i)
+    {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ull;
+    }
+
+    CallSitesLock lock;
+    for (u32 probe = 0; probe < max_call_site_probes; ++probe)
+    {
+        AllocationTracker::CallSite& site = s_call_sites[(hash + probe) % max_call_sites];
+        if (site.samples == 0)
+        {
+            std::copy(frames, frames + frames_count, site.frames.begin());
+            site.frames_count = frames_count;
+            site.tag = tag;
+        }
+        else if (site.tag != tag || site.frames_count != frames_count
+                 || !std::equal(frames, frames + frames_count, site.frames.begin()))
+        {
+            continue;
+        }
+        ++site.samples;
+        site.bytes += size;
+        return;
+    }
+    // A full neighbourhood drops the sample
+}
+
+// Not inlined, so call stacks start a fixed number of frames above it
+static SIMPLE_ENGINE_NOINLINE void track_allocation(const size_t size) noexcept
+{
+    ThreadCounters& counters = thread_counters();
+    const EMemoryTag tag = MemoryTagScope::get_current();
+    counters.counts[static_cast<size_t>(tag)].fetch_add(1, std::memory_order_relaxed);
+    counters.bytes[static_cast<size_t>(tag)].fetch_add(size, std::memory_order_relaxed);
+
+#ifdef SIMPLE_ENGINE_HAS_BACKTRACE
+    const u32 interval = s_sampling_interval.load(std::memory_order_relaxed);
+    if (interval == 0 || t_in_call_sites || ++t_sample_countdown < interval)
+    {
+        return;
+    }
+    t_sample_countdown = 0;
+    void* frames[AllocationTracker::max_call_site_frames + skipped_frames];
+    const int captured = backtrace(frames, static_cast<int>(AllocationTracker::max_call_site_frames + skipped_frames));
+    if (captured > static_cast<int>(skipped_frames))
+    {
+        record_call_site(frames + skipped_frames, static_cast<u32>(captured) - skipped_frames, tag, size);
+    }
+#endif
+}
+
+static void track_free(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        thread_counters().frees.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void* checked_malloc(const size_t size)
+{
+    for (;;)
+    {
+        if (void* p = std::malloc(size > 0 ? size : 1))
+        {
+            return p;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+static void* aligned_malloc(const size_t size, const std::align_val_t alignment) noexcept
+{
+    const size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size > 0 ? size : 1, align);
+#else
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(align, std::max(align, (size + align - 1) / align * align));
+#endif
+}
+
+static void* checked_aligned_malloc(const size_t size, const std::align_val_t alignment)
+{
+    for (;;)
+    {
+        if (void* p = aligned_malloc(size, alignment))
+        {
+            return p;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+static void aligned_free(void* p) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+#endif
+
+u64 AllocationTracker::FrameAllocations::get_unexpected_count() const noexcept
+{
+    u64 count = 0;
+    for (size_t tag = 0; tag < tags_count; ++tag)
+    {
+        if (!is_expected_in_frame(static_cast<EMemoryTag>(tag)))
+        {
+            count += counts[tag];
+        }
+    }
+    return count;
+}
+
+AllocationTracker& AllocationTracker::get()
+{
+    static AllocationTracker tracker;
+    return tracker;
+}
+
+void AllocationTracker::register_frame_thread()
+{
+    thread_counters().frame_thread.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTracker::end_frame()
+{
+    std::array<u64, tags_count> counts{};
+    std::array<u64, tags_count> bytes{};
+    u64 background_count = 0;
+    u64 background_bytes = 0;
+    u64 frees = 0;
+    const u32 threads_count = std::min(s_threads_count.load(std::memory_order_relaxed), max_threads);
+    for (u32 thread = 0; thread < threads_count; ++thread)
+    {
+        const ThreadCounters& counters = s_threads[thread];
+        const bool frame_thread = counters.frame_thread.load(std::memory_order_relaxed);
+        for (size_t tag = 0; tag < tags_count; ++tag)
+        {
+            const u64 count = counters.counts[tag].load(std::memory_order_relaxed);
+            const u64 size = counters.bytes[tag].load(std::memory_order_relaxed);
+            (frame_thread ? counts[tag] : background_count) += count;
+            (frame_thread ? bytes[tag] : background_bytes) += size;
+        }
+        frees += counters.frees.load(std::memory_order_relaxed);
+    }
+
+    for (size_t tag = 0; tag < tags_count; ++tag)
+    {
+        m_last_frame.counts[tag] = counts[tag] - m_previous_counts[tag];
+        m_last_frame.bytes[tag] = bytes[tag] - m_previous_bytes[tag];
+    }
+    m_last_frame.background_count = background_count - m_previous_background_count;
+    m_last_frame.background_bytes = background_bytes - m_previous_background_bytes;
+    m_last_frame.frees = frees - m_previous_frees;
+
+    m_previous_counts = counts;
+    m_previous_bytes = bytes;
+    m_previous_background_count = background_count;
+    m_previous_background_bytes = background_bytes;
+    m_previous_frees = frees;
+}
+
+void AllocationTracker::set_sampling_interval(const u32 interval)
+{
+    s_sampling_interval.store(interval, std::memory_order_relaxed);
+}
+
+u32 AllocationTracker::get_sampling_interval() const
+{
+    return s_sampling_interval.load(std::memory_order_relaxed);
+}
+
+std::vector<AllocationTracker::CallSite> AllocationTracker::get_call_sites(const size_t max_count) const
+{
+    // Allocated up front: the table is locked while copying
+    std::vector<CallSite> call_sites;
+    call_sites.reserve(max_call_sites);
+    {
+        CallSitesLock lock;
+        for (const CallSite& site : s_call_sites)
+        {
+            if (site.samples > 0)
+            {
+                call_sites.push_back(site);
+            }
+        }
+    }
+    std::sort(call_sites.begin(), call_sites.end(), [](const CallSite& left, const CallSite& right)
+    {
+        return left.samples > right.samples;
+    });
+    if (call_sites.size() > max_count)
+    {
+        call_sites.resize(max_count);
+    }
+    return call_sites;
+}
+
+void AllocationTracker::clear_call_sites()
+{
+    CallSitesLock lock;
+    std::fill(std::begin(s_call_sites), std::end(s_call_sites), CallSite());
+}
+
+std::string AllocationTracker::describe(const CallSite& call_site)
+{
+    std::string text;
+#ifdef SIMPLE_ENGINE_HAS_BACKTRACE
+    void* frames[max_call_site_frames];
+    std::copy(call_site.frames.begin(), call_site.frames.begin() + call_site.frames_count, frames);
+    if (char** symbols = backtrace_symbols(frames, static_cast<int>(call_site.frames_count)))
+    {
+        for (u32 i = 0; i < call_site.frames_count; ++i)
+        {
+            text += symbols[i];
+            text += '\n';
+        }
+        std::free(symbols);
+    }
+#else
+    (void)call_site;
+#endif
+    return text;
+}
+
+}
+
+#ifdef SIMPLE_ENGINE_TRACK_ALLOCATIONS
+
+using SimpleEngine::track_allocation;
+using SimpleEngine::track_free;
+
+void* operator new(std::size_t size)
+{
+    track_allocation(size);
+    return SimpleEngine::checked_malloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    track_allocation(size);
+    return SimpleEngine::checked_malloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    track_allocation(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    track_allocation(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    track_allocation(size);
+    return SimpleEngine::checked_aligned_malloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    track_allocation(size);
+    return SimpleEngine::checked_aligned_malloc(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    track_allocation(size);
+    return SimpleEngine::aligned_malloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    track_allocation(size);
+    return SimpleEngine::aligned_malloc(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+    track_free(p);
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    track_free(p);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    track_free(p);
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    track_free(p);
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    track_free(p);
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    track_free(p);
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    track_free(p);
+    SimpleEngine::aligned_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    track_free(p);
+    SimpleEngine::aligned_free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    track_free(p);
+    SimpleEngine::aligned_free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    track_free(p);
+    SimpleEngine::aligned_free(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    track_free(p);
+    SimpleEngine::aligned_free(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    track_free(p);
+    SimpleEngine::aligned_free(p);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Counts heap allocations per thread and per EMemoryTag by replacing the
+// global operator new/delete. Compiled in with SIMPLE_ENGINE_TRACK_ALLOCATIONS;
+// without it nothing is counted and every frame reads as allocation free.
+// One allocation in get_sampling_interval() also records its call stack.
+class AllocationTracker
+{
+public:
+    static constexpr size_t tags_count = static_cast<size_t>(EMemoryTag::Count);
+    static constexpr u32 max_call_site_frames = 8;
+    static constexpr u32 default_sampling_interval = 64;
+
+    // Made by the frame threads (see register_frame_thread) between two end_frame()
+    struct FrameAllocations
+    {
+        std::array<u64, tags_count> counts{};
+        std::array<u64, tags_count> bytes{};
+        // Every other thread: asset imports, the log writer, job workers
+        u64 background_count = 0;
+        u64 background_bytes = 0;
+        u64 frees = 0;
+
+        // Allocations a steady-state frame should not make
+        u64 get_unexpected_count() const noexcept;
+    };
+
+    struct CallSite
+    {
+        std::array<void*, max_call_site_frames> frames{};
+        u32 frames_count = 0;
+        EMemoryTag tag = EMemoryTag::General;
+        u64 samples = 0;
+        u64 bytes = 0;
+    };
+
+    static AllocationTracker& get();
+    // ImGui's and the profiler's, which measure the frame, are let through
+    static bool is_expected_in_frame(const EMemoryTag tag) noexcept
+    {
+        return tag == EMemoryTag::Editor || tag == EMemoryTag::Profiler;
+    }
+    static constexpr bool is_compiled_in() noexcept
+    {
+#ifdef SIMPLE_ENGINE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // The calling thread's allocations count toward frames: the main loop and
+    // the render thread
+    static void register_frame_thread();
+
+    // Main thread, once the frame is done
+    void end_frame();
+    const FrameAllocations& get_last_frame() const noexcept { return m_last_frame; }
+
+    // 0 stops sampling
+    void set_sampling_interval(const u32 interval);
+    u32 get_sampling_interval() const;
+    // Most sampled first
+    std::vector<CallSite> get_call_sites(const size_t max_count) const;
+    void clear_call_sites();
+    // One symbolized frame per line
+    static std::string describe(const CallSite& call_site);
+
+private:
+    AllocationTracker() = default;
+
+    std::array<u64, tags_count> m_previous_counts{};
+    std::array<u64, tags_count> m_previous_bytes{};
+    u64 m_previous_background_count = 0;
+    u64 m_previous_background_bytes = 0;
+    u64 m_previous_frees = 0;
+    FrameAllocations m_last_frame;
+};
+
+}
+
+#endif // ALLOCATION_TRACKER_HPP
@@ -4,7 +4,20 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/AllocationTracker.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
 #include "SimpleEngineCore/Window.hpp"
+#include "SimpleEngineCore/FramePacer.hpp"
+#include "SimpleEngineCore/BenchmarkReport.hpp"
+#include "SimpleEngineCore/Rendering/NullRenderBackend.hpp"
+#include "SimpleEngineCore/Rendering/RecordingRenderBackend.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/OpenGLRenderBackend.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/RenderStats.hpp"
+
+#include <algorithm>
+#include <glm/trigonometric.hpp>
+#include <glm/gtc/constants.hpp>
 
 namespace SimpleEngine {
 
@@ -20,21 +33,23 @@ Application::~Application()
 
 i32 Application::start(u32 window_width, u32 window_height, const char* title)
 {
+    Profiler::get().set_thread_name("Main");
+    AllocationTracker::register_frame_thread();
     m_pWindow = std::make_unique<Window>(title, window_width, window_height);
 
-    m_event_dispatcher.add_event_listener<EventMouseMoved>(
+    m_event_bus.add_event_listener<EventMouseMoved>(
         [](EventMouseMoved& event)
         {
             //LOG_INFO("[MouseMoved] Mouse moved to {0}x{1}", event.x, event.y);
         });
 
-    m_event_dispatcher.add_event_listener<EventWindowResize>(
+    m_event_bus.add_event_listener<EventWindowResize>(
         [](EventWindowResize& event)
         {
             LOG_INFO("[Resized] Change size to {0}x{1}", event.width, event.height);
         });
 
-    m_event_dispatcher.add_event_listener<EventWindowClose>(
+    m_event_bus.add_event_listener<EventWindowClose>(
         [&](EventWindowClose& event)
         {
             LOG_INFO("[WindowClose]");
@@ -44,29 +59,242 @@ i32 Application::start(u32 window_width, u32 window_height, const char* title)
     m_pWindow->set_event_callback(
         [&](BaseEvent& event)
         {
-            m_event_dispatcher.dispatch(event);
+            m_event_bus.post(event);
         });
 
-    m_event_dispatcher.add_event_listener<EventKeyPressed>(
+    m_event_bus.add_event_listener<EventKeyPressed>(
         [&](EventKeyPressed& event)
         {
             //LOG_INFO("Pressed key {0} | scancode {1} | action {2} | mods {3}", event.key, event.scancode, event.action, event.mods);
         });
 
-    m_event_dispatcher.add_event_listener<EventKeyReleased>(
+    m_event_bus.add_event_listener<EventKeyReleased>(
         [&](EventKeyReleased& event)
         {
             //LOG_INFO("Released key {0} | scancode {1} | action {2} | mods {3}", event.key, event.scancode, event.action, event.mods);
         });
 
+    m_p_frame_pacer = std::make_unique<FramePacer>();
+    m_p_frame_pacer->set_target_fps(m_loop_settings.target_fps);
+    m_pWindow->set_frame_pacer(m_p_frame_pacer.get());
+    m_pWindow->set_swap_interval(m_loop_settings.swap_interval);
+    if (m_loop_settings.render_thread)
+    {
+        m_pWindow->start_render_thread();
+    }
+
+    using clock = FramePacer::clock;
+    const double step = 1.0 / m_loop_settings.simulation_rate;
+    double accumulator = 0.0;
+    clock::time_point previous_frame = clock::now();
     while(!m_bCloseWindow)
     {
+        const clock::time_point frame_start = m_p_frame_pacer->wait();
+        // Clamped so a breakpoint or a stalled window doesn't queue up seconds of steps
+        accumulator += std::min(std::chrono::duration<double>(frame_start - previous_frame).count(), 0.25);
+        previous_frame = frame_start;
+
+        Profiler::get().begin_frame();
+        {
+            PROFILE_SCOPE("Dispatch events");
+            m_event_bus.dispatch_pending();
+        }
+        u32 steps = 0;
+        while (accumulator >= step && steps < m_loop_settings.max_steps_per_frame)
+        {
+            m_pWindow->simulate(static_cast<float>(step));
+            {
+                PROFILE_SCOPE("Application::on_fixed_update");
+                on_fixed_update(step);
+            }
+            accumulator -= step;
+            ++steps;
+        }
+        if (steps == m_loop_settings.max_steps_per_frame)
+        {
+            accumulator = std::min(accumulator, step);
+        }
+
+        m_pWindow->on_update(static_cast<float>(accumulator / step));
+        {
+            PROFILE_SCOPE("Application::on_update");
+            on_update();
+        }
+        Profiler::get().end_frame();
+        AllocationTracker::get().end_frame();
+        LinearArena::get_frame().reset();
+    }
+
+    const FramePacingStats pacing = m_p_frame_pacer->get_stats();
+    LOG_INFO("Frame pacing: {0:.2f} ms mean interval, {1:.3f} ms jitter, {2:.2f} ms max", pacing.mean_ms, pacing.jitter_ms, pacing.max_ms);
+    m_pWindow->stop_render_thread();
+    m_pWindow = nullptr;
+    m_p_frame_pacer = nullptr;
+
+    return 0;
+}
+
+// One slow orbit around the Zelda scene over `t` in [0, 1], swinging in and
+// out and up and down so the frustum and texture streaming see varied views
+static void benchmark_camera_pose(const float t, glm::vec3& position, glm::vec3& target)
+{
+    const float angle = t * glm::two_pi<float>();
+    const float radius = 3.f + 1.5f * glm::sin(2.f * angle);
+    target = glm::vec3(0.f, -0.5f, -1.f);
+    position = target + glm::vec3(radius * glm::sin(angle), 0.5f + 0.75f * glm::sin(3.f * angle), radius * glm::cos(angle));
+}
+
+// What the first frame allocating after warm-up allocated, and from where
+static void log_frame_allocations(const u32 frame, const AllocationTracker& tracker)
+{
+    const AllocationTracker::FrameAllocations& allocations = tracker.get_last_frame();
+    LOG_ERROR("Benchmark: frame {0} made {1} heap allocations", frame, allocations.get_unexpected_count());
+    for (size_t tag = 0; tag < AllocationTracker::tags_count; ++tag)
+    {
+        if (allocations.counts[tag] > 0 && !AllocationTracker::is_expected_in_frame(static_cast<EMemoryTag>(tag)))
+        {
+            LOG_ERROR("  {0}: {1} allocations, {2} bytes", MemoryStats::get_tag_name(static_cast<EMemoryTag>(tag)),
+                      allocations.counts[tag], allocations.bytes[tag]);
+        }
+    }
+    for (const AllocationTracker::CallSite& call_site : tracker.get_call_sites(20))
+    {
+        if (AllocationTracker::is_expected_in_frame(call_site.tag))
+        {
+            continue;
+        }
+        LOG_ERROR("  {0} samples under {1}, allocated from:\n{2}", call_site.samples, MemoryStats::get_tag_name(call_site.tag),
+                  AllocationTracker::describe(call_site));
+    }
+}
+
+i32 Application::run_benchmark(const BenchmarkSettings& settings)
+{
+    Profiler& profiler = Profiler::get();
+    profiler.set_thread_name("Main");
+    AllocationTracker& allocation_tracker = AllocationTracker::get();
+    AllocationTracker::register_frame_thread();
+    if (settings.fail_on_frame_allocations && !AllocationTracker::is_compiled_in())
+    {
+        LOG_CRITICAL("Benchmark: checking frame allocations needs a build with SIMPLE_ENGINE_TRACK_ALLOCATIONS");
+        return -3;
+    }
+    profiler.set_enabled(true);
+    profiler.set_paused(false);
+
+    // Every GPU resource of the run is created after this, so all of them use it
+    std::unique_ptr<RenderBackend> backend;
+    if (settings.backend == EBenchmarkBackend::Null)
+    {
+        backend = std::make_unique<NullRenderBackend>();
+    }
+    else
+    {
+        backend = std::make_unique<OpenGLRenderBackend>();
+    }
+    RecordingRenderBackend* p_recorder = nullptr;
+    if (!settings.commands_path.empty())
+    {
+        auto recorder = std::make_unique<RecordingRenderBackend>(std::move(backend));
+        p_recorder = recorder.get();
+        backend = std::move(recorder);
+    }
+    RenderBackend::set(std::move(backend));
+
+    m_pWindow = std::make_unique<Window>("SimpleEngine benchmark", settings.width, settings.height, EWindowMode::Headless);
+    if (!m_pWindow->is_initialized())
+    {
+        LOG_CRITICAL("Benchmark: no OpenGL 4.6 context, see README for running on Mesa");
+        m_pWindow = nullptr;
+        RenderBackend::release();
+        return -1;
+    }
+    m_pWindow->set_event_callback([](BaseEvent&) {});
+    m_pWindow->set_torch_instances(settings.torch_instances);
+    const std::string renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    const std::string version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+    LOG_INFO("Benchmark: {0} warmup + {1} frames at {2}x{3} on {4}, {5} backend",
+             settings.warmup_frames, settings.frames, settings.width, settings.height, renderer, RenderBackend::get().get_name());
+
+    BenchmarkReport report;
+    u32 allocating_frames = 0;
+    const u32 frames_count = settings.warmup_frames + settings.frames;
+    for (u32 frame = 0; frame < frames_count; ++frame)
+    {
+        const bool measured = frame >= settings.warmup_frames;
+        const float t = measured ? static_cast<float>(frame - settings.warmup_frames) / static_cast<float>(settings.frames) : 0.f;
+        glm::vec3 position;
+        glm::vec3 target;
+        benchmark_camera_pose(t, position, target);
+        m_pWindow->set_camera_override(position, target);
+        // The new pose stands in for a mouse move, timed from here to the frame being done
+        m_pWindow->get_input_latency().on_input(EventType::MouseMoved, profiler.now_ns());
+        if (frame == settings.warmup_frames)
+        {
+            m_pWindow->get_input_latency().reset();
+            // Only what the measured frames allocate, every allocation when checking
+            allocation_tracker.clear_call_sites();
+            if (settings.fail_on_frame_allocations)
+            {
+                allocation_tracker.set_sampling_interval(1);
+            }
+        }
+
+        RenderStats::get().reset();
+        profiler.begin_frame();
+        // One step per frame at the nominal rate, so every run takes the same path
+        const double step = 1.0 / m_loop_settings.simulation_rate;
+        m_pWindow->simulate(static_cast<float>(step));
+        {
+            PROFILE_SCOPE("Application::on_fixed_update");
+            on_fixed_update(step);
+        }
         m_pWindow->on_update();
-        on_update();
+        {
+            PROFILE_SCOPE("Application::on_update");
+            on_update();
+        }
+        profiler.end_frame();
+        allocation_tracker.end_frame();
+
+        if (measured)
+        {
+            const MemoryTagScope memory_tag(EMemoryTag::Profiler);
+            report.add_frame(profiler.get_frames().back(), RenderStats::get());
+            report.add_frame_allocations(allocation_tracker.get_last_frame());
+            if (allocation_tracker.get_last_frame().get_unexpected_count() > 0)
+            {
+                ++allocating_frames;
+                if (settings.fail_on_frame_allocations && allocating_frames == 1)
+                {
+                    log_frame_allocations(frame, allocation_tracker);
+                }
+            }
+        }
+        LinearArena::get_frame().reset();
     }
 
+    report.set_input_latency(EventType::MouseMoved, m_pWindow->get_input_latency().get_histogram(EventType::MouseMoved));
     m_pWindow = nullptr;
 
+    if (p_recorder != nullptr)
+    {
+        LOG_INFO("Benchmark: {0} backend commands, {1} bytes", p_recorder->get_commands_count(), p_recorder->get_commands().size());
+        p_recorder->save(settings.commands_path.c_str());
+    }
+    RenderBackend::release();
+
+    if (!report.write(settings.report_path.c_str(), settings, renderer.c_str(), version.c_str()))
+    {
+        return -2;
+    }
+    LOG_INFO("Benchmark: report written to {0}", settings.report_path);
+    if (settings.fail_on_frame_allocations && allocating_frames > 0)
+    {
+        LOG_ERROR("Benchmark: {0} of {1} frames allocated after warm-up", allocating_frames, settings.frames);
+        return -3;
+    }
     return 0;
 }
 
@@ -0,0 +1,103 @@
+#include "SimpleEngineCore/AssetReloader.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+
+#include <chrono>
+
+namespace fs = std::filesystem;
+
+namespace SimpleEngine {
+
+AssetReloader::AssetReloader(const fs::path& directory)
+    : m_watcher(directory)
+{
+    m_import_thread = std::thread(&AssetReloader::import_loop, this);
+}
+
+AssetReloader::~AssetReloader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_import_thread.join();
+}
+
+void AssetReloader::watch(const fs::path& path, ImportFn import)
+{
+    m_importers[path.lexically_normal()].push_back(std::move(import));
+}
+
+void AssetReloader::update()
+{
+    PROFILE_SCOPE("AssetReloader::update");
+    const MemoryTagScope memory_tag(EMemoryTag::Assets);
+    const std::vector<fs::path> changed = m_watcher.poll();
+    std::vector<Import> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const fs::path& path : changed)
+        {
+            const auto importers = m_importers.find(path);
+            if (importers == m_importers.end())
+            {
+                continue;
+            }
+            for (const ImportFn& import : importers->second)
+            {
+                m_queued.push_back({ path, &import, {}, 0.0 });
+            }
+        }
+        finished.swap(m_finished);
+    }
+    if (!changed.empty())
+    {
+        m_wake.notify_one();
+    }
+
+    for (Import& import : finished)
+    {
+        if (!import.apply)
+        {
+            LOG_ERROR("AssetReloader: failed to import '{0}', keeping the loaded one", import.path.string());
+            ++m_stats.failures;
+            continue;
+        }
+        import.apply();
+        ++m_stats.reloads;
+        m_stats.last_import_ms = import.import_ms;
+        LOG_INFO("AssetReloader: reloaded '{0}' ({1:.1f} ms import)", import.path.string(), import.import_ms);
+    }
+}
+
+void AssetReloader::import_loop()
+{
+    Profiler::get().set_thread_name("Asset import");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [this]() { return m_stopping || !m_queued.empty(); });
+        if (m_stopping)
+        {
+            return;
+        }
+        Import import = std::move(m_queued.front());
+        m_queued.pop_front();
+        lock.unlock();
+
+        // m_importers doesn't change once update() runs, so the function stays put
+        const auto start = std::chrono::steady_clock::now();
+        {
+            PROFILE_SCOPE("Asset import");
+            import.apply = (*import.import)();
+        }
+        import.import_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        m_finished.push_back(std::move(import));
+    }
+}
+
+}
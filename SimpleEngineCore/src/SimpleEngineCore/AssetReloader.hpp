@@ -0,0 +1,77 @@
+#ifndef ASSET_RELOADER_HPP
+#define ASSET_RELOADER_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/FileWatcher.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Re-imports the assets whose files change on disk. Owners register an import
+// function per file; when the file changes it runs on the reloader's own
+// thread (file reads and decoding would stall the frame) and returns what to
+// do with the result on the thread owning the GL context, or an empty
+// function when the import failed. update() runs those between two frames,
+// so a frame sees either every part of a reload or none of it.
+class AssetReloader
+{
+public:
+    using ApplyFn = std::function<void()>;
+    using ImportFn = std::function<ApplyFn()>;
+
+    struct Stats
+    {
+        u32 reloads = 0;
+        u32 failures = 0;
+        double last_import_ms = 0.0;
+    };
+
+    explicit AssetReloader(const std::filesystem::path& directory);
+    ~AssetReloader();
+
+    AssetReloader(const AssetReloader&) = delete;
+    AssetReloader& operator=(const AssetReloader&) = delete;
+
+    // Before the first update(). Several importers may watch one file.
+    void watch(const std::filesystem::path& path, ImportFn import);
+
+    // Thread owning the GL context, once per frame before anything is drawn:
+    // starts imports for changed files and applies the finished ones in order
+    void update();
+
+    bool is_watching() const noexcept { return m_watcher.is_watching(); }
+    const Stats& get_stats() const noexcept { return m_stats; }
+
+private:
+    struct Import
+    {
+        std::filesystem::path path;
+        const ImportFn* import = nullptr;
+        ApplyFn apply;
+        double import_ms = 0.0;
+    };
+
+    void import_loop();
+
+    FileWatcher m_watcher;
+    std::map<std::filesystem::path, std::vector<ImportFn>> m_importers;
+    Stats m_stats;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::deque<Import> m_queued;
+    std::vector<Import> m_finished;
+    std::thread m_import_thread;
+};
+
+}
+
+#endif // ASSET_RELOADER_HPP
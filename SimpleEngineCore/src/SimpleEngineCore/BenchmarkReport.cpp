@@ -0,0 +1,194 @@
+#include "BenchmarkReport.hpp"
+#include "SimpleEngineCore/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+namespace SimpleEngine {
+
+void BenchmarkReport::add_frame(const ProfiledFrame& frame, const RenderStats& stats)
+{
+    const size_t index = m_frame_ms.size();
+    m_frame_ms.push_back((frame.end_ns - frame.start_ns) / 1e6);
+    m_draw_calls.push_back(static_cast<double>(stats.draw_calls));
+    m_triangles.push_back(static_cast<double>(stats.triangles));
+
+    for (const ProfileEvent& event : frame.cpu_events)
+    {
+        std::vector<double>& phase = m_phase_ms[event.name];
+        phase.resize(index + 1, 0.0);
+        phase[index] += (event.end_ns - event.start_ns) / 1e6;
+    }
+    for (auto& phase : m_phase_ms)
+    {
+        phase.second.resize(index + 1, 0.0);
+    }
+}
+
+void BenchmarkReport::add_frame_allocations(const AllocationTracker::FrameAllocations& allocations)
+{
+    for (size_t tag = 0; tag < AllocationTracker::tags_count; ++tag)
+    {
+        m_allocations[tag].push_back(static_cast<double>(allocations.counts[tag]));
+    }
+    m_background_allocations.push_back(static_cast<double>(allocations.background_count));
+}
+
+void BenchmarkReport::set_input_latency(const EventType type, const LatencyHistogram& histogram)
+{
+    m_input_latency[get_event_type_name(type)] = histogram;
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const std::vector<double>& sorted, const double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+static void write_summary(std::ofstream& out, std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const double mean = values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    out << "{\"mean\":" << mean
+        << ",\"min\":" << (values.empty() ? 0.0 : values.front())
+        << ",\"p50\":" << percentile(values, 0.5)
+        << ",\"p90\":" << percentile(values, 0.9)
+        << ",\"p95\":" << percentile(values, 0.95)
+        << ",\"p99\":" << percentile(values, 0.99)
+        << ",\"max\":" << (values.empty() ? 0.0 : values.back()) << "}";
+}
+
+static void write_histogram(std::ofstream& out, const LatencyHistogram& histogram)
+{
+    out << "{\"samples\":" << histogram.get_count()
+        << ",\"mean\":" << histogram.get_mean_ms()
+        << ",\"p50\":" << histogram.get_percentile_ms(0.5)
+        << ",\"p90\":" << histogram.get_percentile_ms(0.9)
+        << ",\"p95\":" << histogram.get_percentile_ms(0.95)
+        << ",\"p99\":" << histogram.get_percentile_ms(0.99)
+        << ",\"max\":" << histogram.get_max_ms()
+        << ",\"buckets_1ms\":[";
+    const auto& buckets = histogram.get_buckets();
+    // Trailing empty buckets left out
+    size_t used = buckets.size();
+    while (used > 0 && buckets[used - 1] == 0)
+    {
+        --used;
+    }
+    for (size_t i = 0; i < used; ++i)
+    {
+        out << (i > 0 ? "," : "") << buckets[i];
+    }
+    out << "]}";
+}
+
+// Standard deviation of the frame times
+static double jitter(const std::vector<double>& values)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    double variance = 0.0;
+    for (const double value : values)
+    {
+        variance += (value - mean) * (value - mean);
+    }
+    return std::sqrt(variance / values.size());
+}
+
+static void write_json_string(std::ofstream& out, const char* text)
+{
+    out << '"';
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+bool BenchmarkReport::write(const char* path, const BenchmarkSettings& settings, const char* renderer, const char* version) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        LOG_ERROR("Benchmark: can't write '{0}'", path);
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"renderer\": ";
+    write_json_string(out, renderer);
+    out << ",\n  \"gl_version\": ";
+    write_json_string(out, version);
+    out << ",\n  \"backend\": \"" << (settings.backend == EBenchmarkBackend::Null ? "Null" : "OpenGL") << "\""
+        << ",\n  \"width\": " << settings.width
+        << ",\n  \"height\": " << settings.height
+        << ",\n  \"warmup_frames\": " << settings.warmup_frames
+        << ",\n  \"frames\": " << m_frame_ms.size()
+        << ",\n  \"torch_instances\": " << settings.torch_instances
+#ifdef SIMPLE_ENGINE_PROFILE
+        << ",\n  \"profile_markers\": true"
+#else
+        << ",\n  \"profile_markers\": false"
+#endif
+        << ",\n  \"frame_ms\": ";
+    write_summary(out, m_frame_ms);
+    out << ",\n  \"frame_jitter_ms\": " << jitter(m_frame_ms);
+    out << ",\n  \"draw_calls\": ";
+    write_summary(out, m_draw_calls);
+    out << ",\n  \"triangles\": ";
+    write_summary(out, m_triangles);
+    out << ",\n  \"phases_ms\": {";
+    bool first = true;
+    for (const auto& phase : m_phase_ms)
+    {
+        out << (first ? "\n    " : ",\n    ");
+        first = false;
+        write_json_string(out, phase.first.c_str());
+        out << ": ";
+        write_summary(out, phase.second);
+    }
+    out << "\n  },\n  \"input_latency_ms\": {";
+    first = true;
+    for (const auto& latency : m_input_latency)
+    {
+        out << (first ? "\n    " : ",\n    ");
+        first = false;
+        write_json_string(out, latency.first.c_str());
+        out << ": ";
+        write_histogram(out, latency.second);
+    }
+    out << "\n  }";
+    if (AllocationTracker::is_compiled_in())
+    {
+        out << ",\n  \"allocations_per_frame\": {";
+        for (size_t tag = 0; tag < AllocationTracker::tags_count; ++tag)
+        {
+            out << (tag > 0 ? ",\n    " : "\n    ");
+            write_json_string(out, MemoryStats::get_tag_name(static_cast<EMemoryTag>(tag)));
+            out << ": ";
+            write_summary(out, m_allocations[tag]);
+        }
+        out << ",\n    \"Background threads\": ";
+        write_summary(out, m_background_allocations);
+        out << "\n  }";
+    }
+    out << "\n}\n";
+    return static_cast<bool>(out);
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef BENCHMARK_REPORT_HPP
+#define BENCHMARK_REPORT_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Application.hpp"
+#include "SimpleEngineCore/AllocationTracker.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+#include "SimpleEngineCore/InputLatency.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/RenderStats.hpp"
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Per-frame measurements of a benchmark run, written out as JSON: frame time
+// percentiles, CPU time per profiler scope, draw/triangle counts and input
+// latency, and heap allocations per frame when they are tracked
+class BenchmarkReport
+{
+public:
+    // `frame` is the profiler's record of the frame, `stats` what it submitted
+    void add_frame(const ProfiledFrame& frame, const RenderStats& stats);
+    void add_frame_allocations(const AllocationTracker::FrameAllocations& allocations);
+    void set_input_latency(const EventType type, const LatencyHistogram& histogram);
+
+    bool write(const char* path, const BenchmarkSettings& settings, const char* renderer, const char* version) const;
+
+    size_t get_frames_count() const noexcept { return m_frame_ms.size(); }
+
+private:
+    std::vector<double> m_frame_ms;
+    std::vector<double> m_draw_calls;
+    std::vector<double> m_triangles;
+    // Milliseconds per frame spent in scopes of that name, summed over threads
+    // and nesting; 0 in frames where the scope did not run
+    std::map<std::string, std::vector<double>> m_phase_ms;
+    std::map<std::string, LatencyHistogram> m_input_latency;
+    // Per EMemoryTag, on the main and render threads
+    std::array<std::vector<double>, AllocationTracker::tags_count> m_allocations;
+    std::vector<double> m_background_allocations;
+};
+
+}
+
+#endif // BENCHMARK_REPORT_HPP
@@ -0,0 +1,108 @@
+#include "SimpleEngineCore/EventBus.hpp"
+
+namespace SimpleEngine {
+
+static_assert((EventBus::capacity & (EventBus::capacity - 1)) == 0, "Capacity must be a power of two");
+
+EventBus::EventBus()
+    : m_records(std::make_unique<Record[]>(capacity))
+{
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        m_records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+EventBus::Record* EventBus::claim()
+{
+    size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Record& record = m_records[position & (capacity - 1)];
+        const size_t sequence = record.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0)
+        {
+            if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                return &record;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The consumer hasn't freed this record since the last lap
+            m_dropped_events.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else
+        {
+            position = m_enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void EventBus::publish(Record& record)
+{
+    const size_t position = record.sequence.load(std::memory_order_relaxed);
+    record.sequence.store(position + 1, std::memory_order_release);
+}
+
+bool EventBus::post(const BaseEvent& event)
+{
+    switch (event.get_type())
+    {
+        case EventType::WindowResize: return post(static_cast<const EventWindowResize&>(event));
+        case EventType::WindowClose: return post(static_cast<const EventWindowClose&>(event));
+        case EventType::KeyPressed: return post(static_cast<const EventKeyPressed&>(event));
+        case EventType::KeyReleased: return post(static_cast<const EventKeyReleased&>(event));
+        case EventType::MouseMoved: return post(static_cast<const EventMouseMoved&>(event));
+        default: return false;
+    }
+}
+
+void EventBus::dispatch_pending()
+{
+    // Only what was posted before this call, so listeners that post can't keep it going
+    const size_t end = m_enqueue_position.load(std::memory_order_acquire);
+
+    EventMouseMoved mouse_moved(0.0, 0.0);
+    bool has_mouse_moved = false;
+    while (m_dequeue_position != end)
+    {
+        Record& record = m_records[m_dequeue_position & (capacity - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != m_dequeue_position + 1)
+        {
+            // Claimed but still being written; it goes out with the next batch
+            break;
+        }
+
+        BaseEvent& event = *record.event;
+        if (event.get_type() == EventType::MouseMoved)
+        {
+            m_coalesced_events += has_mouse_moved ? 1 : 0;
+            mouse_moved = static_cast<EventMouseMoved&>(event);
+            has_mouse_moved = true;
+        }
+        else
+        {
+            // Flushed first, so a click still sees the cursor where it happened
+            if (has_mouse_moved)
+            {
+                m_dispatcher.dispatch(mouse_moved);
+                has_mouse_moved = false;
+            }
+            m_dispatcher.dispatch(event);
+        }
+
+        event.~BaseEvent();
+        record.sequence.store(m_dequeue_position + capacity, std::memory_order_release);
+        ++m_dequeue_position;
+    }
+
+    if (has_mouse_moved)
+    {
+        m_dispatcher.dispatch(mouse_moved);
+    }
+}
+
+}
@@ -0,0 +1,170 @@
+#include "SimpleEngineCore/FileWatcher.hpp"
+#include "SimpleEngineCore/Log.hpp"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace SimpleEngine {
+
+#ifdef __linux__
+static constexpr u32 watch_mask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE;
+#endif
+
+FileWatcher::FileWatcher(const fs::path& directory)
+    : m_directory(directory.lexically_normal())
+{
+    std::error_code error;
+    if (!fs::is_directory(m_directory, error))
+    {
+        LOG_ERROR("FileWatcher: '{0}' is not a directory", m_directory.string());
+        return;
+    }
+#ifdef __linux__
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0)
+    {
+        LOG_ERROR("FileWatcher: inotify is not available");
+        return;
+    }
+#else
+    m_last_scan = clock::now();
+#endif
+    m_watching = true;
+    add_directory(m_directory);
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+#endif
+}
+
+void FileWatcher::add_directory(const fs::path& directory)
+{
+    std::error_code error;
+#ifdef __linux__
+    // Watches aren't recursive: one per directory
+    const int watch = inotify_add_watch(m_fd, directory.c_str(), watch_mask);
+    if (watch < 0)
+    {
+        LOG_WARN("FileWatcher: can't watch '{0}'", directory.string());
+        return;
+    }
+    m_watches[watch] = directory;
+    for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+        if (it->is_directory(error))
+        {
+            add_directory(it->path());
+        }
+    }
+#else
+    for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+        if (it->is_regular_file(error))
+        {
+            m_write_times[it->path().lexically_normal()] = it->last_write_time(error);
+        }
+    }
+#endif
+}
+
+void FileWatcher::read_changes(const clock::time_point now)
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    for (;;)
+    {
+        const ssize_t size = read(m_fd, buffer, sizeof(buffer));
+        if (size <= 0)
+        {
+            // EAGAIN once everything queued has been read
+            break;
+        }
+        for (ssize_t offset = 0; offset < size;)
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                LOG_WARN("FileWatcher: events were lost, some changes may be missed");
+                continue;
+            }
+            const auto watch = m_watches.find(event->wd);
+            if (watch == m_watches.end() || event->len == 0)
+            {
+                continue;
+            }
+            const fs::path path = (watch->second / event->name).lexically_normal();
+            if ((event->mask & IN_ISDIR) != 0)
+            {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+                {
+                    add_directory(path);
+                }
+                continue;
+            }
+            m_pending[path] = now;
+        }
+    }
+#else
+    if (now - m_last_scan < scan_interval)
+    {
+        return;
+    }
+    m_last_scan = now;
+
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+    {
+        if (!it->is_regular_file(error))
+        {
+            continue;
+        }
+        const fs::path path = it->path().lexically_normal();
+        const fs::file_time_type write_time = it->last_write_time(error);
+        const auto [known, inserted] = m_write_times.emplace(path, write_time);
+        if (inserted || known->second != write_time)
+        {
+            known->second = write_time;
+            m_pending[path] = now;
+        }
+    }
+#endif
+}
+
+std::vector<fs::path> FileWatcher::poll()
+{
+    std::vector<fs::path> changed;
+    if (!m_watching)
+    {
+        return changed;
+    }
+
+    const clock::time_point now = clock::now();
+    read_changes(now);
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+        if (now - it->second >= settle_time)
+        {
+            changed.push_back(it->first);
+            it = m_pending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return changed;
+}
+
+}
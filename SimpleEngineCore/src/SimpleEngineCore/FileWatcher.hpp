@@ -0,0 +1,59 @@
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Reports files written, created or moved into a directory tree, including
+// directories created after it started. Linux gets the changes from inotify;
+// elsewhere modification times are compared every scan_interval. Editors
+// often save a file in several writes, so a change is only reported once the
+// file has been left alone for settle_time.
+class FileWatcher
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds settle_time{ 100 };
+    static constexpr std::chrono::milliseconds scan_interval{ 500 };
+
+    explicit FileWatcher(const std::filesystem::path& directory);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // False when the directory can't be watched; poll() then reports nothing
+    bool is_watching() const noexcept { return m_watching; }
+
+    // Never blocks. Changed files that have settled since the last call, as
+    // lexically normal paths.
+    std::vector<std::filesystem::path> poll();
+
+private:
+    void read_changes(const clock::time_point now);
+    void add_directory(const std::filesystem::path& directory);
+
+    std::filesystem::path m_directory;
+    bool m_watching = false;
+    // Last time each changed file was touched
+    std::map<std::filesystem::path, clock::time_point> m_pending;
+
+#ifdef __linux__
+    int m_fd = -1;
+    std::map<int, std::filesystem::path> m_watches;
+#else
+    clock::time_point m_last_scan;
+    std::map<std::filesystem::path, std::filesystem::file_time_type> m_write_times;
+#endif
+};
+
+}
+
+#endif // FILE_WATCHER_HPP
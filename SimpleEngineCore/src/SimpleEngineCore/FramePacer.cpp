@@ -0,0 +1,93 @@
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace SimpleEngine {
+
+void FramePacer::set_target_fps(const double fps)
+{
+    m_target_fps = std::max(fps, 0.0);
+    m_deadline = clock::now();
+}
+
+FramePacer::clock::time_point FramePacer::wait()
+{
+    if (m_target_fps > 0.0)
+    {
+        const clock::duration interval = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / m_target_fps));
+        const clock::duration spin = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::milli>(m_spin_ms));
+        m_deadline += interval;
+
+        clock::time_point now = clock::now();
+        if (now > m_deadline)
+        {
+            // Missed it; pace from here on rather than run short frames
+            m_deadline = now;
+        }
+        else
+        {
+            if (m_deadline - now > spin)
+            {
+                std::this_thread::sleep_for(m_deadline - now - spin);
+            }
+            while (clock::now() < m_deadline)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    const clock::time_point frame_start = clock::now();
+    if (m_started)
+    {
+        const float interval_ms = std::chrono::duration<float, std::milli>(frame_start - m_last_frame).count();
+        if (m_intervals_ms.size() < history_frames)
+        {
+            m_intervals_ms.push_back(interval_ms);
+        }
+        else
+        {
+            m_intervals_ms[m_next_interval] = interval_ms;
+            m_next_interval = (m_next_interval + 1) % history_frames;
+        }
+    }
+    else
+    {
+        m_deadline = frame_start;
+        m_started = true;
+    }
+    m_last_frame = frame_start;
+    return frame_start;
+}
+
+FramePacingStats FramePacer::get_stats() const
+{
+    FramePacingStats stats;
+    if (m_intervals_ms.empty())
+    {
+        return stats;
+    }
+
+    double sum = 0.0;
+    stats.min_ms = m_intervals_ms.front();
+    stats.max_ms = m_intervals_ms.front();
+    for (const float interval : m_intervals_ms)
+    {
+        sum += interval;
+        stats.min_ms = std::min<double>(stats.min_ms, interval);
+        stats.max_ms = std::max<double>(stats.max_ms, interval);
+    }
+    stats.mean_ms = sum / m_intervals_ms.size();
+
+    double variance = 0.0;
+    for (const float interval : m_intervals_ms)
+    {
+        variance += (interval - stats.mean_ms) * (interval - stats.mean_ms);
+    }
+    stats.jitter_ms = std::sqrt(variance / m_intervals_ms.size());
+    return stats;
+}
+
+}
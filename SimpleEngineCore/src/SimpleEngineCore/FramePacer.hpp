@@ -0,0 +1,58 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace SimpleEngine {
+
+struct FramePacingStats
+{
+    double mean_ms = 0.0;
+    // Standard deviation of the frame-to-frame interval
+    double jitter_ms = 0.0;
+    double min_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// Holds frames to a target rate without burning a core: sleeps until
+// `spin_ms` before the deadline, then yields until it passes, since sleeps
+// can overshoot by a scheduler tick. Deadlines advance by whole intervals so
+// the rate doesn't drift; after a long hitch they restart from now instead
+// of rushing frames to catch up. Also measures the interval between frames.
+class FramePacer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr size_t history_frames = 240;
+
+    // 0 doesn't wait (vsync or nothing paces the loop)
+    void set_target_fps(const double fps);
+    double get_target_fps() const noexcept { return m_target_fps; }
+    void set_spin_ms(const double spin_ms) noexcept { m_spin_ms = spin_ms; }
+
+    // Waits for the next frame's start and returns it
+    clock::time_point wait();
+
+    // Over the last history_frames intervals
+    FramePacingStats get_stats() const;
+    const std::vector<float>& get_intervals_ms() const noexcept { return m_intervals_ms; }
+    // Index of the oldest interval in get_intervals_ms()
+    size_t get_intervals_offset() const noexcept { return m_next_interval; }
+
+private:
+    double m_target_fps = 0.0;
+    double m_spin_ms = 2.0;
+    clock::time_point m_deadline;
+    clock::time_point m_last_frame;
+    bool m_started = false;
+    // Ring of the last history_frames intervals, oldest at m_next_interval once full
+    std::vector<float> m_intervals_ms;
+    size_t m_next_interval = 0;
+};
+
+}
+
+#endif // FRAME_PACER_HPP
@@ -0,0 +1,178 @@
+#include "InputLatency.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <algorithm>
+
+namespace SimpleEngine {
+
+const char* get_event_type_name(const EventType type)
+{
+    switch (type)
+    {
+        case EventType::WindowResize: return "WindowResize";
+        case EventType::WindowClose: return "WindowClose";
+        case EventType::KeyPressed: return "KeyPressed";
+        case EventType::KeyReleased: return "KeyReleased";
+        case EventType::MouseButtonPressed: return "MouseButtonPressed";
+        case EventType::MouseButtonReleased: return "MouseButtonReleased";
+        case EventType::MouseMoved: return "MouseMoved";
+        default: return "Unknown";
+    }
+}
+
+void LatencyHistogram::add(const double ms)
+{
+    const double clamped = std::max(ms, 0.0);
+    const u32 bucket = std::min(static_cast<u32>(clamped), buckets_count - 1);
+    ++m_buckets[bucket];
+    ++m_count;
+    m_sum_ms += clamped;
+    m_max_ms = std::max(m_max_ms, clamped);
+}
+
+double LatencyHistogram::get_percentile_ms(const double percentile) const
+{
+    if (m_count == 0)
+    {
+        return 0.0;
+    }
+    const double rank = percentile * static_cast<double>(m_count);
+    u64 below = 0;
+    for (u32 bucket = 0; bucket < buckets_count; ++bucket)
+    {
+        if (below + m_buckets[bucket] >= rank && m_buckets[bucket] > 0)
+        {
+            const double within = (rank - static_cast<double>(below)) / m_buckets[bucket];
+            return std::min(bucket + within, m_max_ms);
+        }
+        below += m_buckets[bucket];
+    }
+    return m_max_ms;
+}
+
+void InputTimes::add(const EventType type, const u64 time_ns)
+{
+    u64& earliest = ns[static_cast<size_t>(type)];
+    if (earliest == 0 || time_ns < earliest)
+    {
+        earliest = time_ns;
+    }
+}
+
+void InputTimes::merge(const InputTimes& other)
+{
+    for (size_t i = 0; i < ns.size(); ++i)
+    {
+        if (other.ns[i] != 0)
+        {
+            add(static_cast<EventType>(i), other.ns[i]);
+        }
+    }
+}
+
+bool InputTimes::empty() const
+{
+    return std::all_of(ns.begin(), ns.end(), [](const u64 time_ns) { return time_ns == 0; });
+}
+
+InputTimes InputLatencyTracker::take_pending()
+{
+    const InputTimes pending = m_pending;
+    m_pending = InputTimes();
+    return pending;
+}
+
+void InputLatencyTracker::on_frame_submitted(const InputTimes& inputs)
+{
+    if (inputs.empty())
+    {
+        return;
+    }
+
+    RenderBackend& backend = RenderBackend::get();
+    if (!m_created)
+    {
+        for (Frame& frame : m_frames)
+        {
+            frame.query = backend.create_query();
+        }
+        m_created = true;
+    }
+
+    const auto free_frame = std::find_if(m_frames.begin(), m_frames.end(), [](const Frame& frame) { return !frame.pending; });
+    if (free_frame == m_frames.end())
+    {
+        return;
+    }
+    free_frame->inputs = inputs;
+    backend.query_timestamp(free_frame->query);
+    free_frame->fence = backend.insert_fence();
+    free_frame->pending = true;
+}
+
+void InputLatencyTracker::collect()
+{
+    if (std::none_of(m_frames.begin(), m_frames.end(), [](const Frame& frame) { return frame.pending; }))
+    {
+        return;
+    }
+
+    RenderBackend& backend = RenderBackend::get();
+    // Reading GL_TIMESTAMP does not wait for queued work
+    const i64 gpu_to_cpu_ns = static_cast<i64>(Profiler::get().now_ns()) - static_cast<i64>(backend.get_timestamp());
+    for (Frame& frame : m_frames)
+    {
+        if (!frame.pending || !backend.is_fence_signaled(frame.fence))
+        {
+            continue;
+        }
+
+        const i64 done_ns = static_cast<i64>(backend.get_query_result(frame.query)) + gpu_to_cpu_ns;
+        {
+            std::lock_guard<std::mutex> lock(m_histograms_mutex);
+            for (size_t i = 0; i < frame.inputs.ns.size(); ++i)
+            {
+                if (frame.inputs.ns[i] != 0)
+                {
+                    m_histograms[i].add((done_ns - static_cast<i64>(frame.inputs.ns[i])) / 1e6);
+                }
+            }
+        }
+        backend.delete_fence(frame.fence);
+        frame.pending = false;
+    }
+}
+
+void InputLatencyTracker::release()
+{
+    if (!m_created)
+    {
+        return;
+    }
+    RenderBackend& backend = RenderBackend::get();
+    for (Frame& frame : m_frames)
+    {
+        if (frame.pending)
+        {
+            backend.delete_fence(frame.fence);
+            frame.pending = false;
+        }
+        backend.delete_query(frame.query);
+    }
+    m_created = false;
+}
+
+LatencyHistogram InputLatencyTracker::get_histogram(const EventType type) const
+{
+    std::lock_guard<std::mutex> lock(m_histograms_mutex);
+    return m_histograms[static_cast<size_t>(type)];
+}
+
+void InputLatencyTracker::reset()
+{
+    std::lock_guard<std::mutex> lock(m_histograms_mutex);
+    m_histograms = {};
+}
+
+}
@@ -0,0 +1,99 @@
+#ifndef INPUT_LATENCY_HPP
+#define INPUT_LATENCY_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Event.hpp"
+
+#include <array>
+#include <mutex>
+
+namespace SimpleEngine {
+
+const char* get_event_type_name(const EventType type);
+
+// Latencies in fixed 1 ms buckets up to buckets_count ms, the last bucket
+// also holding everything slower
+class LatencyHistogram
+{
+public:
+    static constexpr u32 buckets_count = 100;
+
+    void add(const double ms);
+
+    u64 get_count() const noexcept { return m_count; }
+    double get_mean_ms() const noexcept { return m_count > 0 ? m_sum_ms / static_cast<double>(m_count) : 0.0; }
+    double get_max_ms() const noexcept { return m_max_ms; }
+    // Interpolated within the bucket it falls in
+    double get_percentile_ms(const double percentile) const;
+    const std::array<u32, buckets_count>& get_buckets() const noexcept { return m_buckets; }
+
+private:
+    std::array<u32, buckets_count> m_buckets{};
+    u64 m_count = 0;
+    double m_sum_ms = 0.0;
+    double m_max_ms = 0.0;
+};
+
+// Earliest not yet handled input of each type, in Profiler::now_ns(); 0 if none
+struct InputTimes
+{
+    std::array<u64, static_cast<size_t>(EventType::EventsCount)> ns{};
+
+    void add(const EventType type, const u64 time_ns);
+    void merge(const InputTimes& other);
+    bool empty() const;
+};
+
+// Follows input events from their GLFW callback to the GPU finishing the
+// frame they first affected. The main thread collects input times and hands
+// them to the first simulation step after them; the frame built from that
+// step carries them to the renderer, which puts a timestamp query and a fence
+// after its swap. Once the fence signals, the timestamp, moved onto the CPU
+// clock, ends the latency. That is when the frame is ready to scan out, so
+// with vsync the photons follow up to one refresh later.
+class InputLatencyTracker
+{
+public:
+    static constexpr u32 frames_in_flight = 8;
+
+    InputLatencyTracker() = default;
+
+    InputLatencyTracker(const InputLatencyTracker&) = delete;
+    InputLatencyTracker& operator=(const InputLatencyTracker&) = delete;
+
+    // Main thread: from the input callbacks, and once a simulation step ran
+    void on_input(const EventType type, const u64 time_ns) { m_pending.add(type, time_ns); }
+    InputTimes take_pending();
+
+    // Thread owning the GL context: right after the frame's swap, then every
+    // frame to finish the ones the GPU is done with. Frames that would exceed
+    // frames_in_flight aren't tracked.
+    void on_frame_submitted(const InputTimes& inputs);
+    void collect();
+    // Before the context goes away
+    void release();
+
+    // Any thread
+    LatencyHistogram get_histogram(const EventType type) const;
+    void reset();
+
+private:
+    struct Frame
+    {
+        InputTimes inputs;
+        u32 query = 0;
+        u32 fence = 0;
+        bool pending = false;
+    };
+
+    InputTimes m_pending;
+
+    std::array<Frame, frames_in_flight> m_frames{};
+    bool m_created = false;
+
+    mutable std::mutex m_histograms_mutex;
+    std::array<LatencyHistogram, static_cast<size_t>(EventType::EventsCount)> m_histograms;
+};
+
+}
+
+#endif // INPUT_LATENCY_HPP
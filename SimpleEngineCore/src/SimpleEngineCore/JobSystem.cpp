@@ -0,0 +1,296 @@
+#include "SimpleEngineCore/JobSystem.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+
+namespace SimpleEngine {
+
+struct Job
+{
+    JobSystem::JobFn fn;
+    JobCounter* counter = nullptr;
+};
+
+// The deque the current thread owns, if it is a worker or the creating thread
+static thread_local WorkStealingDeque* t_deque = nullptr;
+
+// Jobs are created and retired at a high rate from every thread; recycling
+// their slots keeps that off the general heap
+static ObjectPool<Job>& job_pool()
+{
+    static ObjectPool<Job> pool(EMemoryTag::Jobs, 1024);
+    return pool;
+}
+
+// Spins before a worker sleeps, to catch jobs submitted right after it ran dry
+static constexpr u32 idle_spins = 64;
+
+bool WorkStealingDeque::push(Job* job) noexcept
+{
+    const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+    const i64 top = m_top.load(std::memory_order_acquire);
+    if (bottom - top >= capacity)
+    {
+        return false;
+    }
+    m_jobs[bottom & (capacity - 1)].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Job* WorkStealingDeque::pop() noexcept
+{
+    const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    i64 top = m_top.load(std::memory_order_relaxed);
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = m_jobs[bottom & (capacity - 1)].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // The last job: race the thieves for it
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* WorkStealingDeque::steal() noexcept
+{
+    i64 top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const i64 bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+    {
+        return nullptr;
+    }
+
+    Job* job = m_jobs[top & (capacity - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return job;
+}
+
+JobSystem& JobSystem::get()
+{
+    static JobSystem job_system;
+    return job_system;
+}
+
+JobSystem::JobSystem()
+{
+    // Workers record profile scopes and retire jobs, so the profiler and the
+    // job pool have to outlive them
+    Profiler::get();
+    job_pool();
+    m_deques.push_back(std::make_unique<WorkStealingDeque>());
+    t_deque = m_deques.front().get();
+    start();
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+void JobSystem::start(const u32 threads_count)
+{
+    stop();
+    const u32 threads = threads_count > 0 ? threads_count : std::max(1u, std::thread::hardware_concurrency());
+    const u32 count = threads - 1;
+
+    m_stopping.store(false);
+    m_deques.resize(1);
+    for (u32 i = 0; i < count; ++i)
+    {
+        m_deques.push_back(std::make_unique<WorkStealingDeque>());
+    }
+    // Every deque exists before any worker starts stealing from them
+    m_workers.reserve(count);
+    for (u32 i = 0; i < count; ++i)
+    {
+        m_workers.emplace_back(&JobSystem::worker_loop, this, i + 1);
+    }
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stopping.store(true);
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+u32 JobSystem::get_grain(const u32 count, const u32 max_ranges) const noexcept
+{
+    // A few ranges per thread, so threads that finish early can steal the rest
+    const u32 ranges = max_ranges > 0 ? max_ranges : get_threads_count() * 4;
+    return std::max(1u, (count + ranges - 1) / ranges);
+}
+
+void JobSystem::run(JobFn fn, JobCounter* counter, JobCounter* dependency)
+{
+    if (counter != nullptr)
+    {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job* job = job_pool().create(Job{ std::move(fn), counter });
+
+    if (dependency != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(dependency->m_mutex);
+        if (dependency->m_pending.load(std::memory_order_acquire) != 0)
+        {
+            dependency->m_dependents.push_back(job);
+            return;
+        }
+    }
+    submit(job);
+}
+
+void JobSystem::submit(Job* job)
+{
+    // Counted before it is visible, so the count never drops below zero
+    m_queued.fetch_add(1);
+    if (t_deque == nullptr || !t_deque->push(job))
+    {
+        std::lock_guard<std::mutex> lock(m_shared_mutex);
+        m_shared_jobs.push_back(job);
+        m_shared_count.fetch_add(1, std::memory_order_release);
+    }
+
+    if (m_sleeping.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_wake.notify_one();
+    }
+}
+
+Job* JobSystem::find_job()
+{
+    Job* job = t_deque != nullptr ? t_deque->pop() : nullptr;
+
+    if (job == nullptr && m_shared_count.load(std::memory_order_acquire) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_shared_mutex);
+        if (!m_shared_jobs.empty())
+        {
+            job = m_shared_jobs.front();
+            m_shared_jobs.pop_front();
+            m_shared_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (job == nullptr)
+    {
+        // Start from a different victim each time, so thieves spread out
+        static thread_local u32 t_victim = 0;
+        const size_t deques_count = m_deques.size();
+        for (size_t i = 0; i < deques_count && job == nullptr; ++i)
+        {
+            WorkStealingDeque* deque = m_deques[(t_victim + i) % deques_count].get();
+            if (deque != t_deque)
+            {
+                job = deque->steal();
+            }
+        }
+        ++t_victim;
+    }
+
+    if (job != nullptr)
+    {
+        m_queued.fetch_sub(1);
+    }
+    return job;
+}
+
+void JobSystem::execute(Job* job)
+{
+    job->fn();
+    JobCounter* counter = job->counter;
+    job_pool().destroy(job);
+    if (counter != nullptr)
+    {
+        finish(*counter);
+    }
+}
+
+void JobSystem::finish(JobCounter& counter)
+{
+    std::vector<Job*> released;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            released.swap(counter.m_dependents);
+        }
+    }
+    for (Job* job : released)
+    {
+        submit(job);
+    }
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    while (!counter.is_done())
+    {
+        if (Job* job = find_job())
+        {
+            execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    // Returns only once the last finish() has let go of the counter
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::worker_loop(const u32 index)
+{
+    t_deque = m_deques[index].get();
+    Profiler::get().set_thread_name("Worker");
+
+    u32 idle = 0;
+    while (!m_stopping.load(std::memory_order_relaxed))
+    {
+        if (Job* job = find_job())
+        {
+            execute(job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < idle_spins)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleeping.fetch_add(1);
+        m_wake.wait(lock, [this]() { return m_queued.load() > 0 || m_stopping.load(); });
+        m_sleeping.fetch_sub(1);
+        idle = 0;
+    }
+    t_deque = nullptr;
+}
+
+}
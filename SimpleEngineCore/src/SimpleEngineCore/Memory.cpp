@@ -0,0 +1,170 @@
+#include "SimpleEngineCore/Memory.hpp"
+
+#include <algorithm>
+
+namespace SimpleEngine {
+
+static thread_local EMemoryTag t_memory_tag = EMemoryTag::General;
+
+MemoryTagScope::MemoryTagScope(const EMemoryTag tag) noexcept
+    : m_previous(t_memory_tag)
+{
+    t_memory_tag = tag;
+}
+
+MemoryTagScope::~MemoryTagScope()
+{
+    t_memory_tag = m_previous;
+}
+
+EMemoryTag MemoryTagScope::get_current() noexcept
+{
+    return t_memory_tag;
+}
+
+MemoryStats& MemoryStats::get()
+{
+    static MemoryStats stats;
+    return stats;
+}
+
+const char* MemoryStats::get_tag_name(const EMemoryTag tag)
+{
+    switch (tag)
+    {
+        case EMemoryTag::General: return "General";
+        case EMemoryTag::Rendering: return "Rendering";
+        case EMemoryTag::Frame: return "Frame";
+        case EMemoryTag::Assets: return "Assets";
+        case EMemoryTag::Streaming: return "Streaming";
+        case EMemoryTag::Profiler: return "Profiler";
+        case EMemoryTag::Jobs: return "Jobs";
+        case EMemoryTag::Editor: return "Editor";
+        case EMemoryTag::Count: break;
+    }
+    return "Unknown";
+}
+
+void MemoryStats::on_reserve(const EMemoryTag tag, const size_t size)
+{
+    TagCounters& counters = m_counters[static_cast<size_t>(tag)];
+    const u64 reserved = counters.reserved_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    u64 peak = counters.peak_reserved_bytes.load(std::memory_order_relaxed);
+    while (reserved > peak
+        && !counters.peak_reserved_bytes.compare_exchange_weak(peak, reserved, std::memory_order_relaxed))
+    {
+    }
+}
+
+void MemoryStats::on_release(const EMemoryTag tag, const size_t size)
+{
+    m_counters[static_cast<size_t>(tag)].reserved_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+MemoryStats::Counters MemoryStats::get_counters(const EMemoryTag tag) const
+{
+    const TagCounters& counters = m_counters[static_cast<size_t>(tag)];
+    Counters result;
+    result.reserved_bytes = counters.reserved_bytes.load(std::memory_order_relaxed);
+    result.peak_reserved_bytes = counters.peak_reserved_bytes.load(std::memory_order_relaxed);
+    result.allocated_bytes = counters.allocated_bytes.load(std::memory_order_relaxed);
+    result.allocations_count = counters.allocations_count.load(std::memory_order_relaxed);
+    return result;
+}
+
+LinearArena::LinearArena(const EMemoryTag tag, const size_t block_size)
+    : m_tag(tag),
+      m_block_size(block_size > 0 ? block_size : default_block_size)
+{
+}
+
+LinearArena::~LinearArena()
+{
+    release_blocks();
+}
+
+LinearArena& LinearArena::get_frame()
+{
+    thread_local LinearArena arena(EMemoryTag::Frame);
+    return arena;
+}
+
+LinearArena& LinearArena::get_scratch()
+{
+    thread_local LinearArena arena(EMemoryTag::Assets, 1024 * 1024);
+    return arena;
+}
+
+void* LinearArena::allocate(const size_t size, const size_t alignment, const EMemoryTag tag)
+{
+    MemoryStats::get().on_allocate(tag, size);
+    // Later blocks are kept across rewind() and reset(); reuse them first
+    for (; m_block < m_blocks.size(); ++m_block, m_offset = 0)
+    {
+        const Block& block = m_blocks[m_block];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        const size_t aligned = static_cast<size_t>(((base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+        if (aligned + size <= block.size)
+        {
+            m_offset = aligned + size;
+            return block.data + aligned;
+        }
+    }
+
+    // Blocks come from operator new, aligned for anything up to max_align_t
+    add_block(std::max(m_block_size, size + alignment));
+    m_block = m_blocks.size() - 1;
+    const Block& block = m_blocks.back();
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+    const size_t aligned = static_cast<size_t>(((base + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+    m_offset = aligned + size;
+    return block.data + aligned;
+}
+
+void LinearArena::reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        const size_t reserved = m_reserved;
+        release_blocks();
+        add_block(reserved);
+    }
+    m_block = 0;
+    m_offset = 0;
+}
+
+void LinearArena::rewind(const Marker& marker) noexcept
+{
+    m_block = marker.block;
+    m_offset = marker.offset;
+}
+
+size_t LinearArena::get_used() const noexcept
+{
+    size_t used = m_offset;
+    for (size_t i = 0; i < m_block && i < m_blocks.size(); ++i)
+    {
+        used += m_blocks[i].size;
+    }
+    return used;
+}
+
+void LinearArena::add_block(const size_t size)
+{
+    m_blocks.push_back({ static_cast<u8*>(::operator new(size)), size });
+    m_reserved += size;
+    MemoryStats::get().on_reserve(m_tag, size);
+}
+
+void LinearArena::release_blocks()
+{
+    for (const Block& block : m_blocks)
+    {
+        ::operator delete(block.data);
+    }
+    m_blocks.clear();
+    MemoryStats::get().on_release(m_tag, m_reserved);
+    m_reserved = 0;
+}
+
+}
@@ -0,0 +1,247 @@
+#include "SimpleEngineCore/Profiler.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace SimpleEngine {
+
+static u64 steady_ticks_ns()
+{
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler& Profiler::get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : m_start_ticks(steady_ticks_ns())
+{
+}
+
+u64 Profiler::now_ns() const
+{
+    return steady_ticks_ns() - m_start_ticks;
+}
+
+Profiler::ThreadRing& Profiler::thread_ring()
+{
+    // A plain pointer keeps the hot path free of TLS wrapper calls; m_rings
+    // owns the ring, so end_frame() can still drain it after its thread exits
+    thread_local ThreadRing* ring = nullptr;
+    if (ring == nullptr)
+    {
+        std::shared_ptr<ThreadRing> new_ring = std::make_shared<ThreadRing>();
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        new_ring->index = static_cast<u32>(m_rings.size());
+        m_rings.push_back(new_ring);
+        ring = new_ring.get();
+    }
+    return *ring;
+}
+
+u32& Profiler::current_depth()
+{
+    return thread_ring().depth;
+}
+
+void Profiler::record(const ProfileEvent& event)
+{
+    ThreadRing& ring = thread_ring();
+    const size_t write = ring.write.load(std::memory_order_relaxed);
+    if (write - ring.read.load(std::memory_order_acquire) >= ring_capacity)
+    {
+        m_dropped_events.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring.events[write % ring_capacity] = event;
+    ring.events[write % ring_capacity].thread = ring.index;
+    ring.write.store(write + 1, std::memory_order_release);
+}
+
+void Profiler::set_thread_name(const char* name)
+{
+    thread_ring().name = name;
+}
+
+const char* Profiler::get_thread_name(const u32 thread) const
+{
+    std::lock_guard<std::mutex> lock(m_rings_mutex);
+    return thread < m_rings.size() && m_rings[thread]->name != nullptr ? m_rings[thread]->name : "Thread";
+}
+
+void Profiler::drain(std::vector<ProfileEvent>& events)
+{
+    LinearArena& frame_arena = LinearArena::get_frame();
+    const ArenaScope frame_scope(frame_arena);
+    ArenaVector<std::shared_ptr<ThreadRing>> rings(ArenaAllocator<std::shared_ptr<ThreadRing>>(frame_arena, EMemoryTag::Profiler));
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        rings.assign(m_rings.begin(), m_rings.end());
+    }
+    for (const std::shared_ptr<ThreadRing>& ring : rings)
+    {
+        const size_t read = ring->read.load(std::memory_order_relaxed);
+        const size_t write = ring->write.load(std::memory_order_acquire);
+        for (size_t i = read; i < write; ++i)
+        {
+            events.push_back(ring->events[i % ring_capacity]);
+        }
+        ring->read.store(write, std::memory_order_release);
+    }
+}
+
+void Profiler::begin_frame()
+{
+    m_current = ProfiledFrame();
+    m_current.number = ++m_frame_number;
+    m_current.start_ns = now_ns();
+}
+
+void Profiler::end_frame()
+{
+    const MemoryTagScope memory_tag(EMemoryTag::Profiler);
+    m_current.end_ns = now_ns();
+    drain(m_current.cpu_events);
+    std::vector<std::pair<u64, std::vector<ProfileEvent>>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_gpu_events_mutex);
+        pending.swap(m_pending_gpu_events);
+    }
+    if (m_paused || !is_enabled())
+    {
+        return;
+    }
+
+    m_frames.push_back(std::move(m_current));
+    while (m_frames.size() > history_frames)
+    {
+        m_frames.pop_front();
+    }
+    for (auto& [frame_number, events] : pending)
+    {
+        for (auto it = m_frames.rbegin(); it != m_frames.rend(); ++it)
+        {
+            if (it->number == frame_number)
+            {
+                it->gpu_events = std::move(events);
+                break;
+            }
+        }
+    }
+}
+
+void Profiler::add_gpu_events(const u64 frame_number, std::vector<ProfileEvent> events)
+{
+    std::lock_guard<std::mutex> lock(m_gpu_events_mutex);
+    m_pending_gpu_events.emplace_back(frame_number, std::move(events));
+}
+
+static void write_json_string(std::ofstream& out, const char* text)
+{
+    out << '"';
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+bool Profiler::export_chrome_trace(const char* path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        LOG_ERROR("Profiler: can't write '{0}'", path);
+        return false;
+    }
+
+    // Timestamps are microseconds; the GPU gets a track of its own
+    constexpr u32 gpu_thread = 1000000;
+    bool first = true;
+    const auto separate = [&]()
+    {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    const auto write_thread_name = [&](const u32 thread, const char* name)
+    {
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+        write_json_string(out, name);
+        out << "}}";
+    };
+    const auto write_event = [&](const ProfileEvent& event, const u32 thread, const char* category)
+    {
+        separate();
+        out << "{\"name\":";
+        write_json_string(out, event.name);
+        out << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+            << ",\"ts\":" << event.start_ns / 1000.0
+            << ",\"dur\":" << (event.end_ns - event.start_ns) / 1000.0 << "}";
+    };
+
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    u32 threads_count = 0;
+    for (const ProfiledFrame& frame : m_frames)
+    {
+        for (const ProfileEvent& event : frame.cpu_events)
+        {
+            write_event(event, event.thread, "cpu");
+            threads_count = std::max(threads_count, event.thread + 1);
+        }
+        for (const ProfileEvent& event : frame.gpu_events)
+        {
+            write_event(event, gpu_thread, "gpu");
+        }
+    }
+    for (u32 thread = 0; thread < threads_count; ++thread)
+    {
+        write_thread_name(thread, get_thread_name(thread));
+    }
+    write_thread_name(gpu_thread, "GPU");
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return static_cast<bool>(out);
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : m_name(name),
+      m_active(Profiler::get().is_enabled())
+{
+    if (m_active)
+    {
+        ++Profiler::get().current_depth();
+        m_start_ns = Profiler::get().now_ns();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (!m_active)
+    {
+        return;
+    }
+    Profiler& profiler = Profiler::get();
+    u32& depth = profiler.current_depth();
+    --depth;
+
+    ProfileEvent event;
+    event.name = m_name;
+    event.start_ns = m_start_ns;
+    event.end_ns = profiler.now_ns();
+    event.depth = depth;
+    profiler.record(event);
+}
+
+}
@@ -0,0 +1,45 @@
+#include "RenderSnapshot.hpp"
+
+#include <cstring>
+
+namespace SimpleEngine {
+
+template <typename T>
+static void copy_buffer(ImVector<T>& target, const ImVector<T>& source)
+{
+    target.resize(source.Size);
+    if (source.Size > 0)
+    {
+        std::memcpy(target.Data, source.Data, sizeof(T) * source.Size);
+    }
+}
+
+ImGuiDrawSnapshot::~ImGuiDrawSnapshot()
+{
+    for (ImDrawList* list : m_lists)
+    {
+        IM_DELETE(list);
+    }
+}
+
+void ImGuiDrawSnapshot::capture(const ImDrawData& draw_data)
+{
+    for (int i = m_lists.Size; i < draw_data.CmdListsCount; ++i)
+    {
+        m_lists.push_back(IM_NEW(ImDrawList)(draw_data.CmdLists[i]->_Data));
+    }
+    for (int i = 0; i < draw_data.CmdListsCount; ++i)
+    {
+        const ImDrawList& source = *draw_data.CmdLists[i];
+        ImDrawList& target = *m_lists[i];
+        copy_buffer(target.CmdBuffer, source.CmdBuffer);
+        copy_buffer(target.IdxBuffer, source.IdxBuffer);
+        copy_buffer(target.VtxBuffer, source.VtxBuffer);
+        target.Flags = source.Flags;
+    }
+
+    m_draw_data = draw_data;
+    m_draw_data.CmdLists = m_lists.Data;
+}
+
+}
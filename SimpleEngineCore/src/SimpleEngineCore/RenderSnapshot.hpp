@@ -0,0 +1,82 @@
+#ifndef RENDER_SNAPSHOT_HPP
+#define RENDER_SNAPSHOT_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/InputLatency.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Camera.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Material.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureStreamer.hpp"
+
+#include <array>
+#include <glm/vec3.hpp>
+#include <imgui/imgui.h>
+
+namespace SimpleEngine {
+
+// Copy of a frame's ImGui draw lists, so the next ImGui frame can be built
+// while this one is rendered. Buffers are reused between captures.
+class ImGuiDrawSnapshot
+{
+public:
+    ImGuiDrawSnapshot() = default;
+    ~ImGuiDrawSnapshot();
+    ImGuiDrawSnapshot(const ImGuiDrawSnapshot&) = delete;
+    ImGuiDrawSnapshot& operator=(const ImGuiDrawSnapshot&) = delete;
+
+    void capture(const ImDrawData& draw_data);
+    // nullptr before the first capture. The OpenGL backend takes a mutable
+    // pointer but only reads through it.
+    ImDrawData* get_draw_data() const { return m_draw_data.Valid ? &m_draw_data : nullptr; }
+
+private:
+    mutable ImDrawData m_draw_data;
+    ImVector<ImDrawList*> m_lists;
+};
+
+// What the editor panels set, applied to the scene by the renderer
+struct SceneSettings
+{
+    static constexpr size_t materials_count = 7;
+
+    std::array<float, 4> background_color{ 0.271f, 0.232f, 0.451f, 1.f };
+    glm::vec3 scale{ 1.f };
+    glm::vec3 rotation{ 0.f };
+    glm::vec3 location{ 0.f };
+    glm::vec3 light_position{ 0.f };
+    size_t torch_instances = 0;
+    bool indirect_rendering = false;
+    std::array<Material, materials_count> materials;
+    TextureStreamer::Settings streaming;
+};
+
+// Everything the render thread needs for one frame. Built by the simulation
+// thread and never changed once published.
+struct RenderSnapshot
+{
+    u64 frame_number = 0;
+    u32 window_width = 0;
+    u32 window_height = 0;
+    u32 framebuffer_width = 0;
+    u32 framebuffer_height = 0;
+    i32 swap_interval = 1;
+    CameraPose previous_camera;
+    CameraPose camera;
+    // How far from previous_camera to camera to render
+    float alpha = 1.f;
+    // Inputs this frame is the first to show
+    InputTimes inputs;
+    SceneSettings scene;
+    ImGuiDrawSnapshot imgui;
+};
+
+// What the renderer reports back for the panels, a frame or two late
+struct RenderFeedback
+{
+    size_t visible_torches = 0;
+    size_t indirect_draws = 0;
+    size_t indirect_submit_calls = 0;
+    TextureStreamer::Stats streaming;
+};
+
+}
+
+#endif // RENDER_SNAPSHOT_HPP
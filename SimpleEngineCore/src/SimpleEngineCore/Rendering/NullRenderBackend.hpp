@@ -0,0 +1,89 @@
+#ifndef NULL_RENDER_BACKEND_HPP
+#define NULL_RENDER_BACKEND_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+namespace SimpleEngine {
+
+// Accepts every call and only counts it, so what remains of a frame is the
+// renderer's own CPU cost with no driver underneath. Needs no context.
+// Object names are handed out in order, uniforms are all at location 0,
+// programs always build, queries are always available and read 0, fences
+// are always signaled.
+class NullRenderBackend final : public RenderBackend
+{
+public:
+    struct Stats
+    {
+        u64 calls = 0;
+        u64 draw_calls = 0;
+        u64 uploaded_bytes = 0;
+    };
+
+    const char* get_name() const override { return "Null"; }
+
+    const Stats& get_stats() const noexcept { return m_stats; }
+    void reset_stats() { m_stats = Stats(); }
+
+    u32 create_buffer(const GLenum, const size_t size, const void*, const GLenum) override { upload(size); return new_name(); }
+    void delete_buffer(const u32) override { call(); }
+    void bind_buffer(const GLenum, const u32) override { call(); }
+    void bind_buffer_base(const GLenum, const u32, const u32) override { call(); }
+    void buffer_data(const GLenum, const u32, const size_t size, const void*, const GLenum) override { upload(size); }
+    void buffer_sub_data(const GLenum, const u32, const size_t, const size_t size, const void*) override { upload(size); }
+
+    u32 create_vertex_array() override { return new_name(); }
+    void delete_vertex_array(const u32) override { call(); }
+    void bind_vertex_array(const u32) override { call(); }
+    void vertex_array_attribute(const u32, const u32, const u32, const u32, const GLenum, const u32) override { call(); }
+    void vertex_array_binding_divisor(const u32, const u32, const u32) override { call(); }
+    void vertex_array_vertex_buffer(const u32, const u32, const u32, const size_t, const u32) override { call(); }
+    void vertex_array_element_buffer(const u32, const u32) override { call(); }
+
+    u32 create_texture(const GLenum, const u32, const GLenum, const u32, const u32, const u32) override { return new_name(); }
+    void delete_texture(const u32) override { call(); }
+    void active_texture(const u32) override { call(); }
+    void bind_texture(const GLenum, const u32) override { call(); }
+    void texture_parameter(const GLenum, const u32, const GLenum, const i32) override { call(); }
+    void texture_sub_image(const TextureRegion&, const GLenum, const GLenum, const size_t size, const void*) override { upload(size); }
+    void copy_texture_region(const TextureRegion&, const TextureRegion&) override { call(); }
+
+    u32 begin_program(const char*, const char*) override { return new_name(); }
+    bool is_program_ready(const u32) override { call(); return true; }
+    bool finish_program(const u32, std::string&) override { call(); return true; }
+    void delete_program(const u32) override { call(); }
+    void use_program(const u32) override { call(); }
+    i32 get_uniform_location(const u32, const char*) override { call(); return 0; }
+    void set_uniform(const i32, const i32) override { call(); }
+    void set_uniform(const i32, const float) override { call(); }
+    void set_uniform(const i32, const glm::vec3&) override { call(); }
+    void set_uniform(const i32, const glm::mat4&) override { call(); }
+
+    void draw_arrays(const GLenum, const u32, const u32, const u32) override { draw(); }
+    void draw_elements(const GLenum, const u32, const size_t, const u32) override { draw(); }
+    void multi_draw_elements_indirect(const GLenum, const size_t, const u32) override { draw(); }
+
+    u32 create_query() override { return new_name(); }
+    void delete_query(const u32) override { call(); }
+    void query_timestamp(const u32) override { call(); }
+    bool is_query_available(const u32) override { call(); return true; }
+    u64 get_query_result(const u32) override { call(); return 0; }
+    u64 get_timestamp() override { call(); return 0; }
+
+    u32 insert_fence() override { return new_name(); }
+    bool is_fence_signaled(const u32) override { call(); return true; }
+    void delete_fence(const u32) override { call(); }
+
+private:
+    void call() { ++m_stats.calls; }
+    void draw() { ++m_stats.calls; ++m_stats.draw_calls; }
+    void upload(const size_t size) { ++m_stats.calls; m_stats.uploaded_bytes += size; }
+    u32 new_name() { ++m_stats.calls; return m_next_name++; }
+
+    u32 m_next_name = 1;
+    Stats m_stats;
+};
+
+}
+
+#endif // NULL_RENDER_BACKEND_HPP
@@ -0,0 +1,218 @@
+#ifndef BAKED_PRIMITIVES_HPP
+#define BAKED_PRIMITIVES_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Vertex.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ParametricMesh.hpp"
+
+#include <array>
+#include <glad/glad.h>
+
+// Compile-time counterpart of generate_surface(): for tessellation levels
+// known at compile time the whole mesh is evaluated by the compiler and
+// lands in read-only data, ready to be uploaded as is.
+namespace SimpleEngine {
+
+constexpr double constexpr_pi = 3.14159265358979323846;
+
+// Taylor series on [-pi/2, pi/2] after range reduction, accurate to ~1e-9
+constexpr double constexpr_sin(double x)
+{
+    const double two_pi = 2.0 * constexpr_pi;
+    const i64 turns = static_cast<i64>(x / two_pi + (x < 0.0 ? -0.5 : 0.5));
+    x -= static_cast<double>(turns) * two_pi;
+    if (x > constexpr_pi / 2.0)
+    {
+        x = constexpr_pi - x;
+    }
+    else if (x < -constexpr_pi / 2.0)
+    {
+        x = -constexpr_pi - x;
+    }
+
+    const double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (i32 n = 1; n < 12; ++n)
+    {
+        term *= -x2 / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexpr_cos(const double x)
+{
+    return constexpr_sin(x + constexpr_pi / 2.0);
+}
+
+template<size_t VerticesCount, size_t IndicesCount>
+struct BakedMesh
+{
+    std::array<ColoredVertex, VerticesCount> vertices{};
+    std::array<GLuint, IndicesCount> indices{};
+    ETopology topology = ETopology::Lines;
+};
+
+template<u32 U, u32 V, bool UClosed, bool VClosed, bool SouthPole, bool NorthPole, ETopology Topology, typename VertexFn>
+constexpr auto bake_surface(const VertexFn& vertex_fn, const ColoredVertex& south_pole = {}, const ColoredVertex& north_pole = {})
+{
+    static_assert(U > 0 && V > 0, "Baked surface needs at least one sample");
+    constexpr SurfaceDesc desc{ U, V, UClosed, VClosed, SouthPole, NorthPole };
+    constexpr size_t u_edges = surface_u_edges(desc);
+    constexpr size_t v_edges = surface_v_edges(desc);
+
+    BakedMesh<surface_vertices_count(desc), surface_indices_count(desc, Topology)> mesh;
+    mesh.topology = Topology;
+
+    auto grid_index = [](const u32 u, const u32 v) -> GLuint
+    {
+        return static_cast<GLuint>((v % V) * U + (u % U));
+    };
+
+    size_t out = 0;
+    for (u32 v = 0; v < V; ++v)
+    {
+        for (u32 u = 0; u < U; ++u)
+        {
+            mesh.vertices[size_t(v) * U + u] = vertex_fn(u, v);
+        }
+
+        if (Topology == ETopology::Lines)
+        {
+            for (u32 u = 0; u < u_edges; ++u)
+            {
+                mesh.indices[out++] = grid_index(u, v);
+                mesh.indices[out++] = grid_index(u + 1, v);
+            }
+            if (v < v_edges)
+            {
+                for (u32 u = 0; u < U; ++u)
+                {
+                    mesh.indices[out++] = grid_index(u, v);
+                    mesh.indices[out++] = grid_index(u, v + 1);
+                }
+            }
+        }
+        else if (v < v_edges)
+        {
+            for (u32 u = 0; u < u_edges; ++u)
+            {
+                const GLuint a = grid_index(u, v);
+                const GLuint b = grid_index(u + 1, v);
+                const GLuint c = grid_index(u + 1, v + 1);
+                const GLuint d = grid_index(u, v + 1);
+                mesh.indices[out++] = a; mesh.indices[out++] = b; mesh.indices[out++] = c;
+                mesh.indices[out++] = a; mesh.indices[out++] = c; mesh.indices[out++] = d;
+            }
+        }
+    }
+
+    size_t next_vertex = size_t(U) * V;
+    auto add_pole = [&](const ColoredVertex& pole, const u32 row, const bool facing_down)
+    {
+        const GLuint pole_index = static_cast<GLuint>(next_vertex);
+        mesh.vertices[next_vertex++] = pole;
+        if (Topology == ETopology::Lines)
+        {
+            for (u32 u = 0; u < U; ++u)
+            {
+                mesh.indices[out++] = pole_index;
+                mesh.indices[out++] = grid_index(u, row);
+            }
+            return;
+        }
+        for (u32 u = 0; u < u_edges; ++u)
+        {
+            mesh.indices[out++] = pole_index;
+            mesh.indices[out++] = grid_index(facing_down ? u + 1 : u, row);
+            mesh.indices[out++] = grid_index(facing_down ? u : u + 1, row);
+        }
+    };
+    if (SouthPole)
+    {
+        add_pole(south_pole, 0, true);
+    }
+    if (NorthPole)
+    {
+        add_pole(north_pole, V - 1, false);
+    }
+
+    return mesh;
+}
+
+// Same shapes as generate_primitive(), see the matching make_*_key()
+
+template<u32 MainSegments, u32 CircleSegments, ETopology Topology = ETopology::Lines>
+constexpr auto bake_torus(const float main_radius, const float circle_radius, const glm::vec3& color, const glm::vec3& center)
+{
+    return bake_surface<MainSegments, CircleSegments, true, true, false, false, Topology>(
+        [=](const u32 u, const u32 v)
+        {
+            const double main_angle = 2.0 * constexpr_pi * u / MainSegments;
+            const double tube_angle = 2.0 * constexpr_pi * v / CircleSegments;
+            const float ring_radius = main_radius + circle_radius * static_cast<float>(constexpr_cos(tube_angle));
+            return ColoredVertex{ glm::vec3(ring_radius * static_cast<float>(constexpr_cos(main_angle)),
+                                            ring_radius * static_cast<float>(constexpr_sin(main_angle)),
+                                            circle_radius * static_cast<float>(constexpr_sin(tube_angle))) + center, color };
+        });
+}
+
+template<u32 Segments, u32 Rows, ETopology Topology>
+constexpr auto bake_capped_tube(const float height, const float radius, const glm::vec3& color, const glm::vec3& center)
+{
+    const float row_height = Rows > 1 ? height / static_cast<float>(Rows - 1) : 0.f;
+    return bake_surface<Segments, Rows, true, false, true, true, Topology>(
+        [=](const u32 u, const u32 v)
+        {
+            const double angle = 2.0 * constexpr_pi * u / Segments;
+            return ColoredVertex{ glm::vec3(radius * static_cast<float>(constexpr_cos(angle)),
+                                            radius * static_cast<float>(constexpr_sin(angle)),
+                                            row_height * v) + center, color };
+        },
+        { center, color },
+        { center + glm::vec3(0.f, 0.f, height), color });
+}
+
+template<u32 Segments, ETopology Topology = ETopology::Lines>
+constexpr auto bake_cone(const float height, const float radius, const glm::vec3& color, const glm::vec3& center)
+{
+    return bake_capped_tube<Segments, 1, Topology>(height, radius, color, center);
+}
+
+template<u32 Segments, ETopology Topology = ETopology::Lines>
+constexpr auto bake_cylinder(const float height, const float radius, const glm::vec3& color, const glm::vec3& center)
+{
+    return bake_capped_tube<Segments, 2, Topology>(height, radius, color, center);
+}
+
+template<u32 Segments>
+constexpr auto bake_spiral(const glm::vec3& color, const glm::vec3& center)
+{
+    return bake_surface<Segments, 1, false, false, false, false, ETopology::Lines>(
+        [=](const u32 u, const u32)
+        {
+            const double b = 2.0 * u * constexpr_pi / 180.0;
+            const float x = static_cast<float>(constexpr_cos(b));
+            const float y = static_cast<float>(constexpr_sin(b));
+            const float z = u == 0 ? 0.f : static_cast<float>(u - 1) / 360.f;
+            return ColoredVertex{ glm::vec3(center.x + x, center.z + z, center.y + y),
+                                  glm::vec3(0.5f + x, 0.5f + y, 0.5f + z) * color };
+        });
+}
+
+template<ETopology Topology = ETopology::Lines>
+constexpr auto bake_trapezoid(const float up_length, const float down_length, const glm::vec3& color, const glm::vec3& center)
+{
+    return bake_surface<4, 2, true, false, false, false, Topology>(
+        [=](const u32 u, const u32 v)
+        {
+            constexpr float corner_x[4] = { 1.f, 1.f, -1.f, -1.f };
+            constexpr float corner_y[4] = { 1.f, -1.f, -1.f, 1.f };
+            const float half = (v == 0 ? down_length : up_length) * 0.5f;
+            return ColoredVertex{ glm::vec3(corner_x[u] * half, corner_y[u] * half, half) + center, color };
+        });
+}
+
+}
+
+#endif // BAKED_PRIMITIVES_HPP
@@ -7,76 +7,122 @@
 #include <glm/gtx/vector_angle.hpp>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <algorithm>
 
 namespace SimpleEngine {
 
 Camera::Camera(Window& w, glm::vec3 position)
     : m_window(w),
-      m_position(position)
+      m_position(position),
+      m_previous_position(position),
+      m_render_position(position),
+      m_viewport_width(w.get_width()),
+      m_viewport_height(w.get_height())
 {
 }
 
-void Camera::update_matrix(float FOVdeg, float nearPlane, float farPlane)
+void Camera::update_matrix(float FOVdeg, float nearPlane, float farPlane, const float alpha)
 {
     glm::mat4 view(1.0f);
     glm::mat4 projection(1.0f);
 
-    view = glm::lookAt(m_position, m_position + m_orientation, m_up);
+    m_render_position = glm::mix(m_previous_position, m_position, alpha);
+    const glm::vec3 orientation = glm::normalize(glm::mix(m_previous_orientation, m_orientation, alpha));
+    view = glm::lookAt(m_render_position, m_render_position + orientation, m_up);
     projection = glm::perspective(glm::radians(FOVdeg),
-                                  static_cast<float>(m_window.get_width())
-                                  / static_cast<float>(m_window.get_height()),
+                                  static_cast<float>(m_viewport_width)
+                                  / static_cast<float>(m_viewport_height),
                                   nearPlane,
                                   farPlane);
     camera_matrix = projection * view;
+    m_fov = glm::radians(FOVdeg);
+}
+
+float Camera::get_projected_radius(const glm::vec3& center, const float radius) const
+{
+    const float viewport_height = static_cast<float>(m_viewport_height);
+    const float distance = glm::length(center - m_render_position);
+    if (distance <= radius)
+    {
+        return viewport_height;
+    }
+    return radius / (distance * glm::tan(m_fov * 0.5f)) * viewport_height * 0.5f;
 }
 
 void Camera::set_matrix(const ShaderProgram& shaderProgram, const char* uniform) const
 {
     shaderProgram.bind();
-    glUniformMatrix4fv(shaderProgram.get_uniform_location(uniform), 1, GL_FALSE,
-        glm::value_ptr(camera_matrix));
+    RenderBackend::get().set_uniform(shaderProgram.get_uniform_location(uniform), camera_matrix);
 }
 
 void Camera::set_position(const ShaderProgram& shaderProgram, const char* uniform) const
 {
     shaderProgram.bind();
-    glUniform3fv(shaderProgram.get_uniform_location(uniform), 1,
-        glm::value_ptr(m_position));
+    RenderBackend::get().set_uniform(shaderProgram.get_uniform_location(uniform), m_render_position);
+}
+
+void Camera::look_at(const glm::vec3& position, const glm::vec3& target)
+{
+    m_position = position;
+    m_orientation = glm::normalize(target - position);
+}
+
+void Camera::save_previous_pose()
+{
+    m_previous_position = m_position;
+    m_previous_orientation = m_orientation;
+}
+
+void Camera::set_poses(const CameraPose& previous, const CameraPose& current)
+{
+    m_previous_position = previous.position;
+    m_previous_orientation = previous.orientation;
+    m_position = current.position;
+    m_orientation = current.orientation;
 }
 
-void Camera::inputs()
+void Camera::set_viewport(const u32 width, const u32 height)
 {
+    m_viewport_width = std::max(width, 1u);
+    m_viewport_height = std::max(height, 1u);
+}
+
+void Camera::inputs(const float dt)
+{
+    if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
+    {
+        SetSpeed(24.0f);
+    }
+    if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_LEFT_SHIFT) == GLFW_RELEASE)
+    {
+        SetSpeed(6.0f);
+    }
+    const float distance = m_speed * dt;
     if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_W) == GLFW_PRESS)
     {
-        MoveForward();
+        MoveForward(distance);
     }
     if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_S) == GLFW_PRESS)
     {
-        MovaBackward();
+        MovaBackward(distance);
     }
     if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_A) == GLFW_PRESS)
     {
-        MoveLeft();
+        MoveLeft(distance);
     }
     if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_D) == GLFW_PRESS)
     {
-        MovaRight();
+        MovaRight(distance);
     }
     if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_SPACE) == GLFW_PRESS)
     {
-        MoveUp();
+        MoveUp(distance);
     }
     if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS)
     {
-        MoveDown();
-    }
-    if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)
-    {
-        SetSpeed(0.4f);
-    }
-    if(glfwGetKey(m_window.get_window_ptr(), GLFW_KEY_LEFT_SHIFT) == GLFW_RELEASE)
-    {
-        SetSpeed(0.1f);
+        MoveDown(distance);
     }
 
     if(glfwGetMouseButton(m_window.get_window_ptr(), GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS)
@@ -118,34 +164,34 @@ void Camera::inputs()
     }
 }
 
-void Camera::MoveForward()
+void Camera::MoveForward(const float distance)
 {
-    m_position += m_speed * m_orientation;
+    m_position += distance * m_orientation;
 }
 
-void Camera::MovaBackward()
+void Camera::MovaBackward(const float distance)
 {
-    m_position += m_speed * -m_orientation;
+    m_position += distance * -m_orientation;
 }
 
-void Camera::MoveLeft()
+void Camera::MoveLeft(const float distance)
 {
-    m_position += m_speed * -glm::normalize(glm::cross(m_orientation, m_up));
+    m_position += distance * -glm::normalize(glm::cross(m_orientation, m_up));
 }
 
-void Camera::MovaRight()
+void Camera::MovaRight(const float distance)
 {
-    m_position += m_speed * glm::normalize(glm::cross(m_orientation, m_up));
+    m_position += distance * glm::normalize(glm::cross(m_orientation, m_up));
 }
 
-void Camera::MoveUp()
+void Camera::MoveUp(const float distance)
 {
-    m_position += m_speed * m_up;
+    m_position += distance * m_up;
 }
 
-void Camera::MoveDown()
+void Camera::MoveDown(const float distance)
 {
-    m_position += m_speed * -m_up;
+    m_position += distance * -m_up;
 }
 
 }
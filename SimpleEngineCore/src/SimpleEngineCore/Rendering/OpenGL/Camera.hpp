@@ -5,28 +5,59 @@
 
 namespace SimpleEngine {
 
+struct CameraPose
+{
+    glm::vec3 position{ 0.f };
+    glm::vec3 orientation{ 0.f, 0.f, -1.f };
+};
+
 class Camera
 {
 public:
     Camera(class Window& w, glm::vec3 position);
-    void update_matrix(float FOVdeg, float nearPlane, float farPlane);
+    // Views from the pose `alpha` of the way from the previous simulation step to the current one
+    void update_matrix(float FOVdeg, float nearPlane, float farPlane, const float alpha = 1.f);
     void set_matrix(const ShaderProgram& shaderProgram, const char* uniform) const;
     void set_position(const ShaderProgram& shaderProgram, const char* uniform) const;
-    void inputs();
+    // Call before moving the camera in a simulation step, so renders can interpolate
+    void save_previous_pose();
+    CameraPose get_pose() const { return { m_position, m_orientation }; }
+    CameraPose get_previous_pose() const { return { m_previous_position, m_previous_orientation }; }
+    // For a camera that only renders poses simulated elsewhere
+    void set_poses(const CameraPose& previous, const CameraPose& current);
+    // Size update_matrix() projects to; the window's size at construction
+    void set_viewport(const u32 width, const u32 height);
+    // Keyboard moves by m_speed units per second over `dt`; mouse look follows the cursor
+    void inputs(const float dt);
+    // Places the camera directly, for scripted paths instead of inputs()
+    void look_at(const glm::vec3& position, const glm::vec3& target);
     void SetSpeed(float speed) { m_speed = speed; }
-    void MoveForward();
-    void MovaBackward();
-    void MoveLeft();
-    void MovaRight();
-    void MoveUp();
-    void MoveDown();
+    void MoveForward(const float distance);
+    void MovaBackward(const float distance);
+    void MoveLeft(const float distance);
+    void MovaRight(const float distance);
+    void MoveUp(const float distance);
+    void MoveDown(const float distance);
+
+    const glm::mat4& get_matrix() const { return camera_matrix; }
+    // Where the last update_matrix() viewed from
+    glm::vec3 get_position() const { return m_render_position; }
+
+    // On-screen radius in pixels of a world-space sphere under the last update_matrix() projection
+    float get_projected_radius(const glm::vec3& center, const float radius) const;
 private:
     const Window& m_window;
     glm::vec3 m_position;
     glm::vec3 m_orientation = glm::vec3(0.0f, 0.0f, -1.0f);
+    glm::vec3 m_previous_position;
+    glm::vec3 m_previous_orientation = glm::vec3(0.0f, 0.0f, -1.0f);
+    glm::vec3 m_render_position;
+    u32 m_viewport_width;
+    u32 m_viewport_height;
     glm::vec3 m_up = glm::vec3(0.0f, 1.0f, 0.0f);
     glm::mat4 camera_matrix = glm::mat4(1.0f);
-    float m_speed = 0.1f;
+    float m_fov = glm::radians(45.0f);
+    float m_speed = 6.0f;
     float m_sensivity = 100.0f;
     bool m_firstClick = true;
 };
@@ -1,20 +1,87 @@
 #include "ComplexModel.hpp"
+#include "SimpleEngineCore/AssetReloader.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/GpuProfiler.hpp"
+
+#include <set>
 
 namespace SimpleEngine
 {
 	ComplexModel::ComplexModel(const std::vector<ModelData>& model_paths)
+		: parts(model_paths)
 	{
+		PROFILE_SCOPE("ComplexModel load");
+		std::vector<std::vector<Vertex>> part_vertices;
+		std::vector<std::string> texture_paths;
+		size_t vertices_count = 0;
 		for (auto& e : model_paths)
 		{
-			models.push_back(std::make_unique<Model>(e.model_path.c_str(), e.texture_path.c_str()));
+			part_vertices.push_back(loadOBJ(e.model_path.c_str()));
+			texture_paths.push_back(e.texture_path);
+			vertices_count += part_vertices.back().size();
+		}
+
+		// Twice the room, so reloaded meshes can grow
+		m_p_mesh_pool = std::make_unique<StaticMeshPool>(vertices_count * 2, vertices_count * 2);
+		for (size_t i = 0; i < part_vertices.size(); ++i)
+		{
+			// Drawn from the pool: the part's own vertex buffer waits until something draws from it
+			models.push_back(std::make_unique<Model>(part_vertices[i], model_paths[i].texture_path.c_str(), !indirect_rendering));
+			meshes.push_back(m_p_mesh_pool->add_mesh(part_vertices[i]));
 		}
+		m_p_draw_batch = std::make_unique<IndirectDrawBatch>(*m_p_mesh_pool);
+		m_p_texture_atlas = std::make_unique<TextureAtlas>(texture_paths);
 	}
 
 	void ComplexModel::Render()
 	{
-		for (auto& e : models)
+		PROFILE_GPU_SCOPE("ComplexModel::Render");
+		if (!indirect_rendering)
+		{
+			for (auto& e : models)
+			{
+				e->render();
+			}
+			return;
+		}
+
+		m_p_draw_batch->begin(Frustum(view_projection));
+		{
+			PROFILE_SCOPE("Culling");
+			for (size_t i = 0; i < models.size(); ++i)
+			{
+				const TextureSlot& slot = m_p_texture_atlas->get_slot(i);
+				m_p_draw_batch->add_draw(meshes[i], models[i]->get_model_matrix(), models[i]->get_material(),
+					&m_p_texture_atlas->get_array(slot.array), slot);
+			}
+		}
+		m_p_draw_batch->submit();
+	}
+
+	Model& ComplexModel::get_model(size_t number)
+	{
+		upload_model_mesh(number);
+		return *models[number];
+	}
+
+	void ComplexModel::set_indirect_rendering(bool enabled)
+	{
+		if (!enabled)
+		{
+			for (size_t i = 0; i < models.size(); ++i)
+			{
+				upload_model_mesh(i);
+			}
+		}
+		indirect_rendering = enabled;
+	}
+
+	void ComplexModel::upload_model_mesh(size_t number)
+	{
+		if (!models[number]->has_vertex_buffer())
 		{
-			e->render();
+			PROFILE_SCOPE("ComplexModel part upload");
+			models[number]->upload_mesh(loadOBJ(parts[number].model_path.c_str()));
 		}
 	}
 
@@ -55,21 +122,131 @@ namespace SimpleEngine
 		rotation = new_rotation;
 	}
 
-	void ComplexModel::update_camera(const Camera& camera, const std::string& view_name, const std::string& pos_name) const
+	void ComplexModel::watch_assets(AssetReloader& reloader)
 	{
+		for (size_t i = 0; i < parts.size(); ++i)
+		{
+			const std::string& model_path = parts[i].model_path;
+			const AssetReloader::ImportFn import_mesh = [this, i, model_path]() -> AssetReloader::ApplyFn
+			{
+				std::vector<Vertex> vertices = loadOBJ(model_path.c_str());
+				if (vertices.empty())
+				{
+					return {};
+				}
+				std::vector<Vertex> welded_vertices;
+				std::vector<u32> indices;
+				weld_vertices(vertices, welded_vertices, indices);
+				return [this, i, vertices = std::move(vertices), welded_vertices = std::move(welded_vertices), indices = std::move(indices)]()
+				{
+					replace_mesh(i, vertices, welded_vertices, indices);
+				};
+			};
+			reloader.watch(model_path, import_mesh);
+			// loadOBJ doesn't read materials, but exporters write both files
+			reloader.watch(std::filesystem::path(model_path).replace_extension(".mtl"), import_mesh);
+		}
+
+		std::set<std::string> texture_paths;
+		for (const ModelData& part : parts)
+		{
+			texture_paths.insert(part.texture_path);
+		}
+		for (const std::string& texture_path : texture_paths)
+		{
+			const AssetReloader::ImportFn import_texture = [this, texture_path]() -> AssetReloader::ApplyFn
+			{
+				TextureSource source;
+				if (!load_texture_source(texture_path.c_str(), source))
+				{
+					return {};
+				}
+				return [this, texture_path, source = std::move(source)]() mutable
+				{
+					replace_texture(texture_path, std::move(source));
+				};
+			};
+			reloader.watch(texture_path, import_texture);
+			// A cooked texture replaces the PNG it was made from
+			reloader.watch(compressed_texture_path(texture_path.c_str()), import_texture);
+		}
+	}
+
+	void ComplexModel::replace_mesh(size_t number, const std::vector<Vertex>& vertices,
+		const std::vector<Vertex>& welded_vertices, const std::vector<u32>& indices)
+	{
+		models[number]->set_mesh(vertices);
+		m_p_mesh_pool->replace_mesh(meshes[number], welded_vertices, indices);
+	}
+
+	void ComplexModel::replace_texture(const std::string& texture_path, TextureSource source)
+	{
+		std::vector<std::string> texture_paths;
+		for (size_t i = 0; i < parts.size(); ++i)
+		{
+			texture_paths.push_back(parts[i].texture_path);
+			if (parts[i].texture_path == texture_path && models[i]->get_texture() != nullptr)
+			{
+				models[i]->get_texture()->set_source(source);
+			}
+		}
+		if (!m_p_texture_atlas->replace_texture(texture_path, std::move(source)))
+		{
+			// A new size or format needs a new packing
+			LOG_INFO("ComplexModel: '{0}' changed size or format, rebuilding the texture atlas", texture_path);
+			m_p_texture_atlas = std::make_unique<TextureAtlas>(texture_paths);
+		}
+	}
+
+	void ComplexModel::update_camera(const Camera& camera, const char* view_name, const char* pos_name)
+	{
+		PROFILE_SCOPE("Uniform upload");
+		view_projection = camera.get_matrix();
+		request_texture_levels(camera);
 		for (auto& e : models)
 		{
-			camera.set_matrix(e->get_shader_program(), view_name.c_str());
-			camera.set_position(e->get_shader_program(), pos_name.c_str());
+			camera.set_matrix(e->get_shader_program(), view_name);
+			camera.set_position(e->get_shader_program(), pos_name);
+		}
+		camera.set_matrix(m_p_draw_batch->get_shader_program(), view_name);
+		camera.set_position(m_p_draw_batch->get_shader_program(), pos_name);
+	}
+
+	void ComplexModel::request_texture_levels(const Camera& camera) const
+	{
+		// Texel density from the projected bounding sphere; the streamer brings the levels in later
+		for (size_t i = 0; i < models.size(); ++i)
+		{
+			const glm::mat4& model_matrix = models[i]->get_model_matrix();
+			const BoundingSphere& bounds = models[i]->get_bounds();
+			const glm::vec3 center(model_matrix * glm::vec4(bounds.center, 1.f));
+			const float scale = glm::max(glm::length(glm::vec3(model_matrix[0])),
+								glm::max(glm::length(glm::vec3(model_matrix[1])),
+										 glm::length(glm::vec3(model_matrix[2]))));
+			const float pixels = 2.f * camera.get_projected_radius(center, bounds.radius * scale);
+
+			if (indirect_rendering)
+			{
+				const TextureSlot& slot = m_p_texture_atlas->get_slot(i);
+				const TextureArray& array = m_p_texture_atlas->get_array(slot.array);
+				const u32 texture_size = static_cast<u32>(slot.uv_rect.z * array.get_width());
+				array.request_level(texture_level_for_screen_size(texture_size, pixels));
+			}
+			else if (models[i]->get_texture() != nullptr)
+			{
+				models[i]->get_texture()->request_screen_size(pixels);
+			}
 		}
 	}
 
 	void ComplexModel::update_light(const Light& light) const
 	{
+		PROFILE_SCOPE("Uniform upload");
 		for (auto& e : models)
 		{
 			light.update_shader(e->get_shader_program());
 		}
+		light.update_shader(m_p_draw_batch->get_shader_program());
 	}
 
 }
\ No newline at end of file
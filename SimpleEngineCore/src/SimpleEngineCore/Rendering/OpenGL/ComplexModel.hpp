@@ -4,9 +4,14 @@
 #include <SimpleEngineCore/Rendering/OpenGL/Model.hpp>
 #include <SimpleEngineCore/Rendering/OpenGL/Camera.hpp>
 #include <SimpleEngineCore/Rendering/OpenGL/Light.hpp>
+#include <SimpleEngineCore/Rendering/OpenGL/MeshPool.hpp>
+#include <SimpleEngineCore/Rendering/OpenGL/IndirectDrawBatch.hpp>
+#include <SimpleEngineCore/Rendering/OpenGL/TextureArray.hpp>
 
 namespace SimpleEngine
 {
+class AssetReloader;
+
 struct ModelData
 {
 	using string = std::string;
@@ -26,6 +31,8 @@ public:
 	const Material& get_material(size_t number) const noexcept;
 
 	size_t get_models_count() const noexcept { return models.size(); }
+	// Gives the part its own vertex buffer first: an InstancedModel of it draws from that
+	Model& get_model(size_t number);
 
 	glm::vec3 get_scale() const noexcept { return scale; }
 	glm::vec3 get_location() const noexcept { return location; }
@@ -35,12 +42,40 @@ public:
 	void set_location(glm::vec3 new_location);
 	void set_rotation(glm::vec3 new_rotation);
 
-	void update_camera(const Camera& camera, const std::string& view_name, const std::string& pos_name) const;
+	// Indirect rendering draws all parts from one shared mesh pool with multi-draw indirect,
+	// sampling their textures from the arrays of one TextureAtlas. Turning it off
+	// re-reads the parts' OBJs for the per-part vertex buffers it draws from.
+	void set_indirect_rendering(bool enabled);
+	bool is_indirect_rendering() const noexcept { return indirect_rendering; }
+	const IndirectDrawBatch& get_draw_batch() const { return *m_p_draw_batch; }
+	const TextureAtlas& get_texture_atlas() const { return *m_p_texture_atlas; }
+
+	// Re-imports a part when its OBJ, the MTL next to it or its texture change.
+	// Everything drawing the parts (the draw batch, InstancedModels) follows.
+	void watch_assets(AssetReloader& reloader);
+	// `vertices` is the triangle soup, `welded_vertices` and `indices` the same welded
+	void replace_mesh(size_t number, const std::vector<Vertex>& vertices,
+		const std::vector<Vertex>& welded_vertices, const std::vector<u32>& indices);
+	// Every part using `texture_path`
+	void replace_texture(const std::string& texture_path, TextureSource source);
+
+	void update_camera(const Camera& camera, const char* view_name, const char* pos_name);
 	void update_light(const Light& light) const;
 	const ShaderProgram& get_shader_program() const { return models[0]->get_shader_program(); }
 	
 private:
+	// Asks the texture streamer for the mips each part needs at its on-screen size
+	void request_texture_levels(const Camera& camera) const;
+	void upload_model_mesh(size_t number);
+
+	std::vector<ModelData> parts;
 	std::vector<std::unique_ptr<Model>> models;
+	std::vector<StaticMeshPool::MeshHandle> meshes;
+	std::unique_ptr<StaticMeshPool> m_p_mesh_pool;
+	std::unique_ptr<IndirectDrawBatch> m_p_draw_batch;
+	std::unique_ptr<TextureAtlas> m_p_texture_atlas;
+	glm::mat4 view_projection{ 1.f };
+	bool indirect_rendering = true;
 	glm::vec3 scale{ 1.f, 1.f, 1.f };
 	glm::vec3 rotation{ 0.f, 0.f, 0.f };
 	glm::vec3 location{ 0.f, 0.f, 0.f };
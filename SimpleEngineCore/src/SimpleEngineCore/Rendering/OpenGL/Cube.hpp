@@ -47,9 +47,10 @@ private:
     2,6,
     3,7};
 
-    i32 model_matrix_uniform_loc;
-    std::unique_ptr<ShaderProgram> m_p_shader_program;
-    std::unique_ptr<VertexArray>   m_p_vao;
+    i32 model_matrix_uniform_loc = -1;
+    std::shared_ptr<ShaderProgram> m_p_shader_program;
+    u32 m_shader_generation = 0;
+    VertexArray*                   m_p_vao = nullptr;
     std::unique_ptr<VertexBuffer>  m_p_positions_colors_vbo;
     std::unique_ptr<IndexBuffer>   m_p_index_buffer;
 };
@@ -88,9 +89,10 @@ private:
     0,4,5
     };
 
-    i32 model_matrix_uniform_loc;
-    std::unique_ptr<ShaderProgram> m_p_shader_program;
-    std::unique_ptr<VertexArray>   m_p_vao;
+    i32 model_matrix_uniform_loc = -1;
+    std::shared_ptr<ShaderProgram> m_p_shader_program;
+    u32 m_shader_generation = 0;
+    VertexArray*                   m_p_vao = nullptr;
     std::unique_ptr<VertexBuffer>  m_p_positions_colors_vbo;
     std::unique_ptr<IndexBuffer>   m_p_index_buffer;
 };
@@ -6,6 +6,7 @@
 #include "SimpleEngineCore/Rendering/OpenGL/VertexBuffer.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/IndexBuffer.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/VertexArray.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ParametricMesh.hpp"
 
 #include <memory>
 #include <vector>
@@ -27,22 +28,15 @@ public:
     const ShaderProgram& getShaderProgram() const { return *m_p_shader_program; }
 
 private:
+    void bind_shader();
+
     float rotAngle = 0;
-    void generate(const GLfloat height, const float r, const float cx, const float cy, const float cz, const u32 num_segments);
-    std::vector<GLfloat> positionsColors;
-    std::vector<GLuint> indices;
-    i32 rotationUniformLoc;
-    glm::vec3 m_color;
-    std::unique_ptr<ShaderProgram> m_p_shader_program;
-    std::unique_ptr<VertexArray> m_p_vao;
-    std::unique_ptr<VertexBuffer> m_p_positions_colors_vbo;
-    std::unique_ptr<IndexBuffer> m_p_index_buffer;
-
-    const BufferLayout buffer_layout_2_vec3
-    {
-        ShaderDataType::Float3,
-        ShaderDataType::Float3
-    };
+    i32 rotationUniformLoc = -1;
+    std::shared_ptr<ShaderProgram> m_p_shader_program;
+    u32 m_shader_generation = 0;
+    VertexArray* m_p_vao = nullptr;
+    glm::mat4 m_rotation_matrix{ 1.f };
+    std::shared_ptr<PrimitiveMesh> m_p_mesh;
 };
 
 }
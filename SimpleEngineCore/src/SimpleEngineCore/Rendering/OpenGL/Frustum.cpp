@@ -0,0 +1,64 @@
+#include "Frustum.hpp"
+#include <glm/geometric.hpp>
+
+namespace SimpleEngine {
+
+BoundingSphere compute_bounding_sphere(const float* positions, const size_t count, const size_t stride)
+{
+    BoundingSphere sphere;
+    if (count == 0)
+    {
+        return sphere;
+    }
+
+    glm::vec3 min_corner(positions[0], positions[1], positions[2]);
+    glm::vec3 max_corner = min_corner;
+    for (size_t i = 1; i < count; ++i)
+    {
+        const glm::vec3 position(positions[i * stride], positions[i * stride + 1], positions[i * stride + 2]);
+        min_corner = glm::min(min_corner, position);
+        max_corner = glm::max(max_corner, position);
+    }
+
+    sphere.center = (min_corner + max_corner) * 0.5f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const glm::vec3 position(positions[i * stride], positions[i * stride + 1], positions[i * stride + 2]);
+        sphere.radius = glm::max(sphere.radius, glm::length(position - sphere.center));
+    }
+    return sphere;
+}
+
+Frustum::Frustum(const glm::mat4& view_projection)
+{
+    const glm::vec4 row0(view_projection[0][0], view_projection[1][0], view_projection[2][0], view_projection[3][0]);
+    const glm::vec4 row1(view_projection[0][1], view_projection[1][1], view_projection[2][1], view_projection[3][1]);
+    const glm::vec4 row2(view_projection[0][2], view_projection[1][2], view_projection[2][2], view_projection[3][2]);
+    const glm::vec4 row3(view_projection[0][3], view_projection[1][3], view_projection[2][3], view_projection[3][3]);
+
+    m_planes[0] = row3 + row0; // left
+    m_planes[1] = row3 - row0; // right
+    m_planes[2] = row3 + row1; // bottom
+    m_planes[3] = row3 - row1; // top
+    m_planes[4] = row3 + row2; // near
+    m_planes[5] = row3 - row2; // far
+
+    for (auto& plane : m_planes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+bool Frustum::intersects_sphere(const glm::vec3& center, const float radius) const
+{
+    for (const auto& plane : m_planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,32 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include <glm/mat4x4.hpp>
+#include <array>
+
+namespace SimpleEngine {
+
+struct BoundingSphere
+{
+    glm::vec3 center{ 0.f, 0.f, 0.f };
+    float radius = 0.f;
+};
+
+// Sphere around the axis-aligned box of `count` positions laid out every `stride` floats
+BoundingSphere compute_bounding_sphere(const float* positions, const size_t count, const size_t stride);
+
+class Frustum
+{
+public:
+    // Extracts the six clip planes from a projection * view matrix (Gribb/Hartmann)
+    explicit Frustum(const glm::mat4& view_projection);
+
+    bool intersects_sphere(const glm::vec3& center, const float radius) const;
+
+private:
+    std::array<glm::vec4, 6> m_planes;
+};
+
+}
+
+#endif // FRUSTUM_HPP
@@ -0,0 +1,143 @@
+#include "GpuProfiler.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <memory>
+
+namespace SimpleEngine {
+
+static std::unique_ptr<GpuProfiler> s_p_gpu_profiler;
+
+GpuProfiler& GpuProfiler::get_shared()
+{
+    if (s_p_gpu_profiler == nullptr)
+    {
+        s_p_gpu_profiler.reset(new GpuProfiler());
+    }
+    return *s_p_gpu_profiler;
+}
+
+void GpuProfiler::release_shared()
+{
+    s_p_gpu_profiler.reset();
+}
+
+GpuProfiler::GpuProfiler()
+{
+    for (Frame& frame : m_frames)
+    {
+        for (u32& query : frame.queries)
+        {
+            query = RenderBackend::get().create_query();
+        }
+        frame.scopes.reserve(max_scopes_per_frame);
+    }
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    for (Frame& frame : m_frames)
+    {
+        for (const u32 query : frame.queries)
+        {
+            RenderBackend::get().delete_query(query);
+        }
+    }
+}
+
+void GpuProfiler::collect(Frame& frame)
+{
+    // Timestamps finish in order, so the last one being ready means all are
+    RenderBackend& backend = RenderBackend::get();
+    if (!backend.is_query_available(frame.last_query))
+    {
+        return;
+    }
+
+    std::vector<ProfileEvent> events;
+    events.reserve(frame.scopes.size());
+    for (size_t i = 0; i < frame.scopes.size(); ++i)
+    {
+        const u64 start = backend.get_query_result(frame.queries[2 * i]);
+        const u64 end = backend.get_query_result(frame.queries[2 * i + 1]);
+
+        ProfileEvent event;
+        event.name = frame.scopes[i].name;
+        event.start_ns = static_cast<u64>(static_cast<i64>(start) + m_gpu_to_cpu_ns);
+        event.end_ns = static_cast<u64>(static_cast<i64>(end) + m_gpu_to_cpu_ns);
+        event.depth = frame.scopes[i].depth;
+        events.push_back(event);
+    }
+    Profiler::get().add_gpu_events(frame.number, std::move(events));
+    frame.pending = false;
+}
+
+void GpuProfiler::begin_frame(const u64 frame_number)
+{
+    const MemoryTagScope memory_tag(EMemoryTag::Profiler);
+    // Reading GL_TIMESTAMP does not wait for queued work
+    const u64 gpu_now = RenderBackend::get().get_timestamp();
+    m_gpu_to_cpu_ns = static_cast<i64>(Profiler::get().now_ns()) - static_cast<i64>(gpu_now);
+
+    // The frame recorded last can be read once its queries are done
+    m_frames[m_current].pending = m_recording && !m_frames[m_current].scopes.empty() && m_depth == 0;
+    for (Frame& frame : m_frames)
+    {
+        if (frame.pending)
+        {
+            collect(frame);
+        }
+    }
+
+    m_current = (m_current + 1) % frames_in_flight;
+    Frame& frame = m_frames[m_current];
+    if (frame.pending)
+    {
+        // The GPU is more than frames_in_flight behind; lose the frame rather than stall
+        ++m_dropped_frames;
+    }
+    frame.number = frame_number;
+    frame.pending = false;
+    frame.scopes.clear();
+    m_depth = 0;
+    m_recording = Profiler::get().is_enabled();
+}
+
+u32 GpuProfiler::begin_scope(const char* name)
+{
+    Frame& frame = m_frames[m_current];
+    if (!m_recording || frame.scopes.size() >= max_scopes_per_frame)
+    {
+        return invalid_scope;
+    }
+
+    const u32 scope = static_cast<u32>(frame.scopes.size());
+    frame.scopes.push_back({ name, m_depth++ });
+    RenderBackend::get().query_timestamp(frame.queries[2 * scope]);
+    return scope;
+}
+
+void GpuProfiler::end_scope(const u32 scope)
+{
+    if (scope == invalid_scope)
+    {
+        return;
+    }
+    Frame& frame = m_frames[m_current];
+    --m_depth;
+    frame.last_query = frame.queries[2 * scope + 1];
+    RenderBackend::get().query_timestamp(frame.last_query);
+}
+
+GpuProfileScope::GpuProfileScope(const char* name)
+    : m_cpu_scope(name),
+      m_scope(GpuProfiler::get_shared().begin_scope(name))
+{
+}
+
+GpuProfileScope::~GpuProfileScope()
+{
+    GpuProfiler::get_shared().end_scope(m_scope);
+}
+
+}
@@ -0,0 +1,95 @@
+#ifndef GPU_PROFILER_HPP
+#define GPU_PROFILER_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+
+#include <array>
+#include <vector>
+#include <glad/glad.h>
+
+namespace SimpleEngine {
+
+// Timestamp queries around scopes, read back frames_in_flight frames
+// later once they are available, so the CPU never waits on the GPU. Results
+// go to Profiler::add_gpu_events() on the CPU timeline.
+class GpuProfiler
+{
+public:
+    static constexpr u32 frames_in_flight = 4;
+    static constexpr u32 max_scopes_per_frame = 256;
+
+    static GpuProfiler& get_shared();
+    static void release_shared();
+
+    ~GpuProfiler();
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // Collects every finished frame, then starts recording `frame_number`
+    void begin_frame(const u64 frame_number);
+
+    // Returns the scope index for end_scope, or invalid_scope when out of queries
+    u32 begin_scope(const char* name);
+    void end_scope(const u32 scope);
+
+    u64 get_dropped_frames() const noexcept { return m_dropped_frames; }
+
+    static constexpr u32 invalid_scope = ~0u;
+
+private:
+    GpuProfiler();
+
+    struct Scope
+    {
+        const char* name;
+        u32 depth;
+    };
+
+    struct Frame
+    {
+        u64 number = 0;
+        bool pending = false;
+        std::vector<Scope> scopes;
+        u32 last_query = 0;
+        std::array<u32, 2 * max_scopes_per_frame> queries{};
+    };
+
+    void collect(Frame& frame);
+
+    std::array<Frame, frames_in_flight> m_frames;
+    u32 m_current = 0;
+    u32 m_depth = 0;
+    bool m_recording = false;
+    // CPU ns = GPU ns + offset, measured every frame
+    i64 m_gpu_to_cpu_ns = 0;
+    u64 m_dropped_frames = 0;
+};
+
+// CPU marker plus GPU timestamps for the same scope
+class GpuProfileScope
+{
+public:
+    explicit GpuProfileScope(const char* name);
+    ~GpuProfileScope();
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    ProfileScope m_cpu_scope;
+    u32 m_scope;
+};
+
+#ifdef SIMPLE_ENGINE_PROFILE
+
+#define PROFILE_GPU_SCOPE(name) ::SimpleEngine::GpuProfileScope SIMPLE_ENGINE_PROFILE_CONCAT(gpu_profile_scope_, __LINE__)(name)
+
+#else
+
+#define PROFILE_GPU_SCOPE(name)
+
+#endif // SIMPLE_ENGINE_PROFILE
+
+}
+
+#endif // GPU_PROFILER_HPP
@@ -1,36 +1,20 @@
 #include "IndexBuffer.hpp"
-#include "SimpleEngineCore/Log.hpp"
-#include <glad/glad.h>
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
 
 namespace SimpleEngine {
 
-constexpr GLenum usage_to_GLenum(const VertexBuffer::EUsage usage)
-{
-    switch (usage)
-    {
-    case SimpleEngine::VertexBuffer::EUsage::Static:
-        return GL_STATIC_DRAW;
-    case SimpleEngine::VertexBuffer::EUsage::Dynamic:
-        return GL_DYNAMIC_DRAW;
-    case SimpleEngine::VertexBuffer::EUsage::Stream:
-        return GL_STREAM_DRAW;
-    }
-
-    LOG_ERROR("Unknown VertexBuffer usage");
-    return GL_STREAM_DRAW;
-}
-
 IndexBuffer::IndexBuffer(const void* data, const size_t count, const VertexBuffer::EUsage usage)
     : m_count(count)
 {
-    glGenBuffers(1, &m_id);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLuint), data, usage_to_GLenum(usage));
+    m_id = RenderBackend::get().create_buffer(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLuint), data, usage_to_GLenum(usage));
 }
 
 IndexBuffer::~IndexBuffer()
 {
-    glDeleteBuffers(1, &m_id);
+    if (m_id != 0)
+    {
+        RenderBackend::get().delete_buffer(m_id);
+    }
 }
 
 IndexBuffer& IndexBuffer::operator=(IndexBuffer&& index_buffer) noexcept
@@ -52,12 +36,17 @@ IndexBuffer::IndexBuffer(IndexBuffer&& index_buffer) noexcept
 
 void IndexBuffer::bind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+    RenderBackend::get().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
 }
 
 void IndexBuffer::unbind()
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    RenderBackend::get().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void IndexBuffer::update_buffer(const void* data, const size_t count, const size_t first_index) const
+{
+    RenderBackend::get().buffer_sub_data(GL_ELEMENT_ARRAY_BUFFER, m_id, first_index * sizeof(GLuint), count * sizeof(GLuint), data);
 }
 
 }
@@ -18,7 +18,9 @@ public:
 
     void bind() const;
     static void unbind();
+    void update_buffer(const void* data, const size_t count, const size_t first_index = 0) const;
     size_t get_count() const { return m_count; }
+    u32 get_id() const { return m_id; }
 
 private:
     u32 m_id = 0;
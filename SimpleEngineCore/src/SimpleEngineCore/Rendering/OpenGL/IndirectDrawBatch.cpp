@@ -0,0 +1,137 @@
+#include "IndirectDrawBatch.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/GpuProfiler.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/RenderStats.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace SimpleEngine {
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(u32), "Indirect command must match the GL layout");
+static_assert(sizeof(DrawData) % 16 == 0, "DrawData must follow std430 array stride");
+
+IndirectDrawBatch::IndirectDrawBatch(const StaticMeshPool& mesh_pool)
+    : m_mesh_pool(mesh_pool)
+{
+    m_p_shader_program = ShaderProgram::get_shared("indirect");
+
+    const size_t initial_draws = std::max<size_t>(mesh_pool.get_meshes_count(), 1);
+    m_p_indirect_buffer = std::make_unique<StorageBuffer>(
+        StorageBuffer::ETarget::DrawIndirect,
+        sizeof(DrawElementsIndirectCommand) * initial_draws);
+    m_p_draw_data_buffer = std::make_unique<StorageBuffer>(
+        StorageBuffer::ETarget::ShaderStorage,
+        sizeof(DrawData) * initial_draws);
+}
+
+void IndirectDrawBatch::begin(const Frustum& frustum)
+{
+    m_frustum = frustum;
+    m_pending.clear();
+}
+
+bool IndirectDrawBatch::add_draw(const StaticMeshPool::MeshHandle mesh, const glm::mat4& model_matrix, const Material& material,
+                                 const TextureArray* textures, const TextureSlot& slot)
+{
+    if (mesh == StaticMeshPool::invalid_mesh)
+    {
+        return false;
+    }
+
+    const MeshRange& range = m_mesh_pool.get_mesh(mesh);
+    const glm::vec3 center(model_matrix * glm::vec4(range.bounds.center, 1.f));
+    const float scale = glm::max(glm::length(glm::vec3(model_matrix[0])),
+                        glm::max(glm::length(glm::vec3(model_matrix[1])),
+                                 glm::length(glm::vec3(model_matrix[2]))));
+    if (!m_frustum.intersects_sphere(center, range.bounds.radius * scale))
+    {
+        return false;
+    }
+
+    PendingDraw draw;
+    draw.command = { range.index_count, 1, range.first_index, range.base_vertex, 0 };
+    draw.data = {
+        model_matrix,
+        glm::vec4(material.get_ambient(), 0.f),
+        glm::vec4(material.get_diffuse(), 0.f),
+        glm::vec4(material.get_specular(), 0.f),
+        slot.uv_rect,
+        static_cast<float>(slot.layer),
+        // The shader's LOD counts from the finest resident level
+        glm::max(0.f, slot.max_lod - (textures != nullptr ? static_cast<float>(textures->get_resident_level()) : 0.f)),
+        { 0.f, 0.f } };
+    draw.textures = textures;
+    draw.order = static_cast<u32>(m_pending.size());
+    m_pending.push_back(draw);
+    return true;
+}
+
+void IndirectDrawBatch::submit()
+{
+    PROFILE_GPU_SCOPE("IndirectDrawBatch::submit");
+    m_submit_calls_count = 0;
+    m_commands.clear();
+    m_draws.clear();
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    // Group by texture array so each group is one multi-draw call
+    std::sort(m_pending.begin(), m_pending.end(), [](const PendingDraw& left, const PendingDraw& right)
+    {
+        return left.textures != right.textures ? left.textures < right.textures : left.order < right.order;
+    });
+
+    for (const PendingDraw& draw : m_pending)
+    {
+        m_commands.push_back(draw.command);
+        m_draws.push_back(draw.data);
+    }
+    m_p_indirect_buffer->update_buffer(m_commands.data(), sizeof(DrawElementsIndirectCommand) * m_commands.size());
+    m_p_draw_data_buffer->update_buffer(m_draws.data(), sizeof(DrawData) * m_draws.size());
+
+    m_p_shader_program->bind();
+    if (m_p_shader_program->is_relinked(m_shader_generation))
+    {
+        // Sampler units are program state too
+        draw_offset_uniform_loc = m_p_shader_program->get_uniform_location("draw_offset");
+        RenderBackend::get().set_uniform(m_p_shader_program->get_uniform_location("diffuseTex"), 0);
+        RenderBackend::get().set_uniform(m_p_shader_program->get_uniform_location("specularTex"), 1);
+    }
+    m_mesh_pool.bind();
+    m_p_draw_data_buffer->bind_base(0);
+    m_p_indirect_buffer->bind();
+
+    u64 triangles_count = 0;
+    for (const DrawElementsIndirectCommand& command : m_commands)
+    {
+        triangles_count += u64(command.count / 3) * command.instance_count;
+    }
+
+    size_t first = 0;
+    while (first < m_pending.size())
+    {
+        const TextureArray* textures = m_pending[first].textures;
+        size_t last = first + 1;
+        while (last < m_pending.size() && m_pending[last].textures == textures)
+        {
+            ++last;
+        }
+
+        if (textures != nullptr)
+        {
+            RenderBackend::get().active_texture(0);
+            textures->bind();
+        }
+        RenderBackend::get().set_uniform(draw_offset_uniform_loc, static_cast<GLint>(first));
+        RenderBackend::get().multi_draw_elements_indirect(GL_TRIANGLES,
+            first * sizeof(DrawElementsIndirectCommand),
+            static_cast<u32>(last - first));
+        ++m_submit_calls_count;
+        first = last;
+    }
+    RenderStats::get().add_draw(triangles_count, m_submit_calls_count);
+}
+
+}
@@ -0,0 +1,85 @@
+#ifndef INDIRECT_DRAW_BATCH_HPP
+#define INDIRECT_DRAW_BATCH_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/MeshPool.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/StorageBuffer.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ShaderProgram.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Material.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureArray.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Frustum.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace SimpleEngine {
+
+struct DrawElementsIndirectCommand
+{
+    u32 count;
+    u32 instance_count;
+    u32 first_index;
+    i32 base_vertex;
+    u32 base_instance;
+};
+
+// Per-draw shader data, std430 layout; fetched in the shader by draw ID
+struct DrawData
+{
+    glm::mat4 model_matrix;
+    glm::vec4 ambient;
+    glm::vec4 diffuse;
+    glm::vec4 specular;
+    glm::vec4 uv_rect;
+    float layer;
+    float max_lod;
+    float padding[2];
+};
+
+// Collects the visible draws of meshes from one StaticMeshPool and submits
+// them with glMultiDrawElementsIndirect, one call per bound texture array.
+// Each draw samples its own layer and atlas rectangle, so all draws whose
+// textures share an array go out in a single call.
+class IndirectDrawBatch
+{
+public:
+    explicit IndirectDrawBatch(const StaticMeshPool& mesh_pool);
+
+    IndirectDrawBatch(const IndirectDrawBatch&) = delete;
+    IndirectDrawBatch& operator=(const IndirectDrawBatch&) = delete;
+
+    void begin(const Frustum& frustum);
+    // Returns false when the mesh is outside the frustum and was skipped
+    bool add_draw(const StaticMeshPool::MeshHandle mesh, const glm::mat4& model_matrix, const Material& material,
+                  const TextureArray* textures, const TextureSlot& slot);
+    void submit();
+
+    const ShaderProgram& get_shader_program() const { return *m_p_shader_program; }
+    size_t get_draws_count() const noexcept { return m_commands.size(); }
+    size_t get_submit_calls_count() const noexcept { return m_submit_calls_count; }
+
+private:
+    struct PendingDraw
+    {
+        DrawElementsIndirectCommand command;
+        DrawData data;
+        const TextureArray* textures;
+        // Submission order, keeps the grouping stable without stable_sort's scratch buffer
+        u32 order;
+    };
+
+    const StaticMeshPool& m_mesh_pool;
+    Frustum m_frustum{ glm::mat4(1.f) };
+    std::vector<PendingDraw> m_pending;
+    std::vector<DrawElementsIndirectCommand> m_commands;
+    std::vector<DrawData> m_draws;
+    size_t m_submit_calls_count = 0;
+    i32 draw_offset_uniform_loc = -1;
+    std::shared_ptr<ShaderProgram> m_p_shader_program;
+    u32 m_shader_generation = 0;
+    std::unique_ptr<StorageBuffer> m_p_indirect_buffer;
+    std::unique_ptr<StorageBuffer> m_p_draw_data_buffer;
+};
+
+}
+
+#endif // INDIRECT_DRAW_BATCH_HPP
@@ -0,0 +1,163 @@
+#include "InstancedModel.hpp"
+#include "Frustum.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/GpuProfiler.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/RenderStats.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+#include <glm/gtc/type_ptr.hpp>
+
+namespace SimpleEngine
+{
+
+static constexpr u32 instance_binding = 1;
+
+InstancedModel::InstancedModel(const Model& model, const size_t capacity)
+    : m_model(model),
+      m_capacity(capacity > 0 ? capacity : 1)
+{
+    m_p_shader_program = ShaderProgram::get_shared("instanced");
+    set_material(model.get_material());
+
+    if (!(model.get_vertex_buffer().get_layout() == Vertex::Layout::layout))
+    {
+        LOG_ERROR("InstancedModel: mesh must have position, texcoord and normal attributes");
+    }
+
+    m_instances.reserve(m_capacity);
+    m_visible.reserve(m_capacity);
+
+    m_p_vao = std::make_unique<VertexArray>();
+    m_p_vao->add_vertex_buffer(m_model.get_vertex_buffer());
+    if (m_model.get_index_buffer() != nullptr)
+    {
+        m_p_vao->set_index_buffer(*m_model.get_index_buffer());
+    }
+    create_instance_buffer();
+    m_p_vao->add_vertex_format(m_p_instance_vbo->get_layout(), 1);
+    m_p_vao->bind_vertex_buffer(*m_p_instance_vbo, instance_binding);
+}
+
+void InstancedModel::create_instance_buffer()
+{
+    m_p_instance_vbo = std::make_unique<VertexBuffer>(
+        nullptr,
+        sizeof(InstanceData) * m_capacity,
+        InstanceData::Layout::layout,
+        VertexBuffer::EUsage::Stream);
+}
+
+void InstancedModel::upload_visible()
+{
+    if (m_visible.size() > m_capacity)
+    {
+        while (m_capacity < m_visible.size())
+        {
+            m_capacity *= 2;
+        }
+        // Only the buffer attached to the instance binding changes, the format stays
+        create_instance_buffer();
+        m_p_vao->bind_vertex_buffer(*m_p_instance_vbo, instance_binding);
+    }
+    m_p_instance_vbo->update_buffer(m_visible.data(), sizeof(InstanceData) * m_visible.size());
+}
+
+void InstancedModel::set_instances(std::vector<InstanceData> instances)
+{
+    m_instances = std::move(instances);
+    m_visible = m_instances;
+    upload_visible();
+}
+
+void InstancedModel::add_instance(const InstanceData& instance)
+{
+    m_instances.push_back(instance);
+    m_visible.push_back(instance);
+    upload_visible();
+}
+
+void InstancedModel::clear_instances()
+{
+    m_instances.clear();
+    m_visible.clear();
+}
+
+void InstancedModel::cull(const Camera& camera)
+{
+    PROFILE_SCOPE("InstancedModel::cull");
+    const Frustum frustum(camera.get_matrix());
+    const glm::vec4 bounds_center(m_model.get_bounds().center, 1.f);
+    const float bounds_radius = m_model.get_bounds().radius;
+
+    m_visible.clear();
+    float max_pixels = 0.f;
+    for (const InstanceData& instance : m_instances)
+    {
+        const glm::mat4 world_matrix = model_matrix * instance.transform;
+        const glm::vec3 center(world_matrix * bounds_center);
+        const float scale = glm::max(glm::length(glm::vec3(world_matrix[0])),
+                            glm::max(glm::length(glm::vec3(world_matrix[1])),
+                                     glm::length(glm::vec3(world_matrix[2]))));
+
+        if (frustum.intersects_sphere(center, bounds_radius * scale))
+        {
+            m_visible.push_back(instance);
+            max_pixels = glm::max(max_pixels, 2.f * camera.get_projected_radius(center, bounds_radius * scale));
+        }
+    }
+    upload_visible();
+
+    // The closest visible instance decides which mips the shared texture needs
+    if (!m_visible.empty() && m_model.get_texture() != nullptr)
+    {
+        m_model.get_texture()->request_screen_size(max_pixels);
+    }
+}
+
+void InstancedModel::render()
+{
+    PROFILE_GPU_SCOPE("InstancedModel::render");
+    if (m_visible.empty())
+    {
+        return;
+    }
+
+    m_p_shader_program->bind();
+    if (m_p_shader_program->is_relinked(m_shader_generation))
+    {
+        model_matrix_uniform_loc = m_p_shader_program->get_uniform_location("model_matrix");
+        material.init_shader(*m_p_shader_program);
+    }
+    m_p_vao->bind();
+    material.update_shader(*m_p_shader_program);
+
+    RenderBackend::get().set_uniform(model_matrix_uniform_loc, model_matrix);
+
+    if (m_model.get_texture() != nullptr)
+    {
+        RenderBackend::get().active_texture(0);
+        m_model.get_texture()->bind();
+    }
+
+    const u32 instances_count = static_cast<u32>(m_visible.size());
+    if (m_model.get_index_buffer() == nullptr)
+    {
+        RenderBackend::get().draw_arrays(GL_TRIANGLES, 0, static_cast<u32>(m_model.get_vertex_count()), instances_count);
+        RenderStats::get().add_draw(m_model.get_vertex_count() / 3 * m_visible.size());
+    }
+    else
+    {
+        RenderBackend::get().draw_elements(GL_TRIANGLES, static_cast<u32>(m_p_vao->get_indices_count()), 0, instances_count);
+        RenderStats::get().add_draw(m_p_vao->get_indices_count() / 3 * m_visible.size());
+    }
+}
+
+void InstancedModel::set_material(const Material& new_material)
+{
+    material.set_ambient(new_material.get_ambient());
+    material.set_diffuse(new_material.get_diffuse());
+    material.set_specular(new_material.get_specular());
+    material.set_diffuseTex(new_material.get_diffuseTex());
+    material.set_specularTex(new_material.get_specularTex());
+}
+
+}
@@ -0,0 +1,75 @@
+#ifndef INSTANCED_MODEL_HPP
+#define INSTANCED_MODEL_HPP
+
+#include "Shape.hpp"
+
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Model.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Camera.hpp"
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <glad/glad.h>
+
+namespace SimpleEngine
+{
+
+struct InstanceData
+{
+    glm::mat4 transform{ 1.f };
+    glm::vec4 color{ 1.f };
+
+    // The transform is passed as four vec4 columns
+    using Layout = VertexLayout<glm::vec4, glm::vec4, glm::vec4, glm::vec4, glm::vec4>;
+};
+
+static_assert(InstanceData::Layout::stride == sizeof(InstanceData), "InstanceData layout stride mismatch");
+static_assert(InstanceData::Layout::offset(4) == offsetof(InstanceData, color), "InstanceData::color offset mismatch");
+
+// Draws many copies of one Model's mesh with a single instanced draw call.
+// The mesh buffers and texture stay owned by the source Model.
+class InstancedModel : public Shape
+{
+public:
+    InstancedModel(const Model& model, const size_t capacity = 1024);
+    virtual ~InstancedModel() override = default;
+    virtual void render() override;
+    const ShaderProgram& get_shader_program() const { return *m_p_shader_program; }
+
+    void set_instances(std::vector<InstanceData> instances);
+    void add_instance(const InstanceData& instance);
+    void clear_instances();
+
+    // Rebuilds the instance buffer from the instances inside the camera frustum
+    void cull(const Camera& camera);
+
+    size_t get_instances_count() const noexcept { return m_instances.size(); }
+    size_t get_visible_count() const noexcept { return m_visible.size(); }
+
+    void set_material(const Material& new_material);
+    const Material& get_material() const noexcept { return material; }
+
+    InstancedModel(const InstancedModel&) = delete;
+    InstancedModel& operator=(const InstancedModel&) = delete;
+    InstancedModel& operator=(InstancedModel&&) = delete;
+
+private:
+    void create_instance_buffer();
+    void upload_visible();
+
+    const Model& m_model;
+    Material material;
+    std::vector<InstanceData> m_instances;
+    std::vector<InstanceData> m_visible;
+    size_t m_capacity;
+    i32 model_matrix_uniform_loc = -1;
+    std::shared_ptr<ShaderProgram> m_p_shader_program;
+    u32 m_shader_generation = 0;
+    std::unique_ptr<VertexArray>   m_p_vao;
+    std::unique_ptr<VertexBuffer>  m_p_instance_vbo;
+};
+
+}
+
+#endif // INSTANCED_MODEL_HPP
@@ -1,6 +1,7 @@
 #include "Light.hpp"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
 
 namespace SimpleEngine
 {
@@ -23,23 +24,41 @@ namespace SimpleEngine
 	void PointLight::update_shader(const ShaderProgram& program) const
 	{
 		program.bind();
-		glUniform3fv(uniform_loc_position, 1, glm::value_ptr(position));
-		glUniform1f(uniform_loc_intensity, intensity);
-		glUniform3fv(uniform_loc_color, 1, glm::value_ptr(color));
-		glUniform1f(uniform_loc_constant, constant);
-		glUniform1f(uniform_loc_linear, linear);
-		glUniform1f(uniform_loc_quadratic, quadratic);
+		UniformLocations& locations = get_uniform_locations(program);
+		if (program.is_relinked(locations.shader_generation))
+		{
+			init_shader(program, locations);
+		}
+		RenderBackend::get().set_uniform(locations.uniform_loc_position, position);
+		RenderBackend::get().set_uniform(locations.uniform_loc_intensity, intensity);
+		RenderBackend::get().set_uniform(locations.uniform_loc_color, color);
+		RenderBackend::get().set_uniform(locations.uniform_loc_constant, constant);
+		RenderBackend::get().set_uniform(locations.uniform_loc_linear, linear);
+		RenderBackend::get().set_uniform(locations.uniform_loc_quadratic, quadratic);
 	}
 
-	void PointLight::init_shader(const ShaderProgram& program)
+	void PointLight::init_shader(const ShaderProgram& program, UniformLocations& locations)
 	{
-		program.bind();
-		uniform_loc_position	= program.get_uniform_location("pointLight.position");
-		uniform_loc_intensity	= program.get_uniform_location("pointLight.intensity");
-		uniform_loc_color		= program.get_uniform_location("pointLight.color");
-		uniform_loc_constant	= program.get_uniform_location("pointLight.constant");
-		uniform_loc_linear		= program.get_uniform_location("pointLight.linear");
-		uniform_loc_quadratic	= program.get_uniform_location("pointLight.quadratic");
+		locations.uniform_loc_position	= program.get_uniform_location("pointLight.position");
+		locations.uniform_loc_intensity	= program.get_uniform_location("pointLight.intensity");
+		locations.uniform_loc_color		= program.get_uniform_location("pointLight.color");
+		locations.uniform_loc_constant	= program.get_uniform_location("pointLight.constant");
+		locations.uniform_loc_linear	= program.get_uniform_location("pointLight.linear");
+		locations.uniform_loc_quadratic	= program.get_uniform_location("pointLight.quadratic");
+	}
+
+	PointLight::UniformLocations& PointLight::get_uniform_locations(const ShaderProgram& program) const
+	{
+		for (UniformLocations& locations : m_uniform_locations)
+		{
+			if (locations.p_program == &program)
+			{
+				return locations;
+			}
+		}
+		UniformLocations& locations = m_uniform_locations.emplace_back();
+		locations.p_program = &program;
+		return locations;
 	}
 
 	void PointLight::set_position(const glm::vec3& position)
@@ -1,6 +1,7 @@
 #ifndef LIGHT_HPP
 #define LIGHT_HPP
 #include <glm/vec3.hpp>
+#include <vector>
 #include "SimpleEngineCore/Rendering/OpenGL/ShaderProgram.hpp"
 
 namespace SimpleEngine
@@ -25,21 +26,32 @@ public:
 		float constant = 1.f, float linear = 0.045f, float quadratic = 0.0075f);
 	virtual ~PointLight() override = default;
 
+	// Uniform locations are cached per program, so one light can feed several shaders
 	virtual void update_shader(const ShaderProgram& program) const override;
-	void init_shader(const ShaderProgram& program);
 	void set_position(const glm::vec3& position);
 	glm::vec3 get_position() const { return position; }
 protected:
+	struct UniformLocations
+	{
+		const ShaderProgram* p_program = nullptr;
+		u32 shader_generation = 0;
+		i32 uniform_loc_position  = -1;
+		i32 uniform_loc_intensity = -1;
+		i32 uniform_loc_color     = -1;
+		i32 uniform_loc_constant  = -1;
+		i32 uniform_loc_linear    = -1;
+		i32 uniform_loc_quadratic = -1;
+	};
+
+	// Looked up again when is_relinked() reports a new program
+	static void init_shader(const ShaderProgram& program, UniformLocations& locations);
+	UniformLocations& get_uniform_locations(const ShaderProgram& program) const;
+
 	glm::vec3 position;
 	float constant;
 	float linear;
 	float quadratic;
-	i32 uniform_loc_position  = -1;
-	i32 uniform_loc_intensity = -1;
-	i32 uniform_loc_color     = -1;
-	i32 uniform_loc_constant  = -1;
-	i32 uniform_loc_linear    = -1;
-	i32 uniform_loc_quadratic = -1;
+	mutable std::vector<UniformLocations> m_uniform_locations;
 };
 
 }
@@ -5,6 +5,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/glad.h>
 #include "SimpleEngineCore/Rendering/OpenGL/ShaderProgram.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
 
 namespace SimpleEngine
 {
@@ -28,11 +29,11 @@ public:
 
 	void update_shader(const ShaderProgram& program)
 	{
-		glUniform3fv(uniform_loc_ambient, 1, glm::value_ptr(ambient));
-		glUniform3fv(uniform_loc_diffuse, 1, glm::value_ptr(diffuse));
-		glUniform3fv(uniform_loc_specular, 1, glm::value_ptr(specular));
-		glUniform1i(uniform_loc_diffuseTex, diffuseTex);
-		glUniform1i(uniform_loc_specularTex, specularTex);
+		RenderBackend::get().set_uniform(uniform_loc_ambient, ambient);
+		RenderBackend::get().set_uniform(uniform_loc_diffuse, diffuse);
+		RenderBackend::get().set_uniform(uniform_loc_specular, specular);
+		RenderBackend::get().set_uniform(uniform_loc_diffuseTex, diffuseTex);
+		RenderBackend::get().set_uniform(uniform_loc_specularTex, specularTex);
 	}
 
 	void init_shader(const ShaderProgram& program)
@@ -0,0 +1,132 @@
+#include "MeshPool.hpp"
+#include "SimpleEngineCore/Log.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace SimpleEngine {
+
+namespace {
+
+struct VertexHash
+{
+    size_t operator()(const Vertex& vertex) const noexcept
+    {
+        const u32* words = reinterpret_cast<const u32*>(&vertex);
+        size_t hash = 0;
+        for (size_t i = 0; i < sizeof(Vertex) / sizeof(u32); ++i)
+        {
+            hash ^= words[i] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+struct VertexEqual
+{
+    bool operator()(const Vertex& left, const Vertex& right) const noexcept
+    {
+        return std::memcmp(&left, &right, sizeof(Vertex)) == 0;
+    }
+};
+
+}
+
+StaticMeshPool::StaticMeshPool(const size_t max_vertices, const size_t max_indices)
+    : m_max_vertices(max_vertices),
+      m_max_indices(max_indices)
+{
+    m_p_vao = &VertexArray::get_shared(Vertex::Layout::layout);
+    m_p_vertex_buffer = std::make_unique<VertexBuffer>(
+        nullptr,
+        sizeof(Vertex) * max_vertices,
+        Vertex::Layout::layout,
+        VertexBuffer::EUsage::Static);
+    m_p_index_buffer = std::make_unique<IndexBuffer>(nullptr, max_indices, VertexBuffer::EUsage::Static);
+}
+
+void weld_vertices(const std::vector<Vertex>& vertices, std::vector<Vertex>& unique_vertices, std::vector<u32>& indices)
+{
+    unique_vertices.clear();
+    indices.clear();
+    unique_vertices.reserve(vertices.size());
+    indices.reserve(vertices.size());
+
+    std::unordered_map<Vertex, u32, VertexHash, VertexEqual> vertex_to_index;
+    vertex_to_index.reserve(vertices.size());
+    for (const Vertex& vertex : vertices)
+    {
+        const auto [it, inserted] = vertex_to_index.emplace(vertex, static_cast<u32>(unique_vertices.size()));
+        if (inserted)
+        {
+            unique_vertices.push_back(vertex);
+        }
+        indices.push_back(it->second);
+    }
+}
+
+void StaticMeshPool::write_mesh(MeshRange& mesh, const std::vector<Vertex>& vertices, const std::vector<u32>& indices)
+{
+    mesh.index_count = static_cast<u32>(indices.size());
+    mesh.bounds = compute_bounding_sphere(reinterpret_cast<const float*>(vertices.data()), vertices.size(), sizeof(Vertex) / sizeof(float));
+    m_p_vertex_buffer->update_buffer(vertices.data(), sizeof(Vertex) * vertices.size(), sizeof(Vertex) * static_cast<size_t>(mesh.base_vertex));
+    m_p_index_buffer->update_buffer(indices.data(), indices.size(), mesh.first_index);
+}
+
+StaticMeshPool::MeshHandle StaticMeshPool::add_mesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices)
+{
+    if (m_vertices_count + vertices.size() > m_max_vertices || m_indices_count + indices.size() > m_max_indices)
+    {
+        LOG_ERROR("StaticMeshPool: out of space for mesh with {0} vertices and {1} indices", vertices.size(), indices.size());
+        return invalid_mesh;
+    }
+
+    MeshRange mesh;
+    mesh.first_index = static_cast<u32>(m_indices_count);
+    mesh.base_vertex = static_cast<i32>(m_vertices_count);
+    write_mesh(mesh, vertices, indices);
+
+    m_vertices_count += vertices.size();
+    m_indices_count += indices.size();
+    m_meshes.push_back(mesh);
+    m_spaces.push_back({ vertices.size(), indices.size() });
+    return static_cast<MeshHandle>(m_meshes.size() - 1);
+}
+
+StaticMeshPool::MeshHandle StaticMeshPool::add_mesh(const std::vector<Vertex>& vertices)
+{
+    std::vector<Vertex> unique_vertices;
+    std::vector<u32> indices;
+    weld_vertices(vertices, unique_vertices, indices);
+    return add_mesh(unique_vertices, indices);
+}
+
+bool StaticMeshPool::replace_mesh(const MeshHandle mesh, const std::vector<Vertex>& vertices, const std::vector<u32>& indices)
+{
+    MeshRange& range = m_meshes[mesh];
+    MeshSpace& space = m_spaces[mesh];
+    if (vertices.size() > space.vertices || indices.size() > space.indices)
+    {
+        if (m_vertices_count + vertices.size() > m_max_vertices || m_indices_count + indices.size() > m_max_indices)
+        {
+            LOG_ERROR("StaticMeshPool: out of space to replace mesh {0} with {1} vertices and {2} indices", mesh, vertices.size(), indices.size());
+            return false;
+        }
+        range.first_index = static_cast<u32>(m_indices_count);
+        range.base_vertex = static_cast<i32>(m_vertices_count);
+        space = { vertices.size(), indices.size() };
+        m_vertices_count += vertices.size();
+        m_indices_count += indices.size();
+    }
+    write_mesh(range, vertices, indices);
+    return true;
+}
+
+void StaticMeshPool::bind() const
+{
+    m_p_vao->bind_vertex_buffer(*m_p_vertex_buffer);
+    m_p_vao->set_index_buffer(*m_p_index_buffer);
+    m_p_vao->bind();
+}
+
+}
@@ -0,0 +1,78 @@
+#ifndef MESH_POOL_HPP
+#define MESH_POOL_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ModelLoader.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Frustum.hpp"
+#include "VertexArray.hpp"
+#include "VertexBuffer.hpp"
+#include "IndexBuffer.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace SimpleEngine {
+
+struct MeshRange
+{
+    u32 first_index = 0;
+    u32 index_count = 0;
+    i32 base_vertex = 0;
+    BoundingSphere bounds;
+};
+
+// Welds identical vertices of a triangle soup (as returned by loadOBJ) into
+// unique vertices and indices
+void weld_vertices(const std::vector<Vertex>& vertices, std::vector<Vertex>& unique_vertices, std::vector<u32>& indices);
+
+// Sub-allocates static meshes of the Vertex format from one shared
+// vertex/index buffer pair, so they can all be drawn through one VAO.
+class StaticMeshPool
+{
+public:
+    using MeshHandle = u32;
+    static constexpr MeshHandle invalid_mesh = ~MeshHandle(0);
+
+    StaticMeshPool(const size_t max_vertices = 1 << 20, const size_t max_indices = 1 << 22);
+
+    StaticMeshPool(const StaticMeshPool&) = delete;
+    StaticMeshPool& operator=(const StaticMeshPool&) = delete;
+
+    MeshHandle add_mesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices);
+    // Welds identical vertices of a triangle soup (as returned by loadOBJ) before adding it
+    MeshHandle add_mesh(const std::vector<Vertex>& vertices);
+
+    // Same handle, new geometry: written over the old one when it fits the
+    // space that had, else appended (the old space isn't reused). False, and
+    // the mesh unchanged, when the pool has no room for it.
+    bool replace_mesh(const MeshHandle mesh, const std::vector<Vertex>& vertices, const std::vector<u32>& indices);
+
+    const MeshRange& get_mesh(const MeshHandle mesh) const { return m_meshes[mesh]; }
+    size_t get_meshes_count() const noexcept { return m_meshes.size(); }
+    size_t get_vertices_count() const noexcept { return m_vertices_count; }
+    size_t get_indices_count() const noexcept { return m_indices_count; }
+
+    void bind() const;
+
+private:
+    struct MeshSpace
+    {
+        size_t vertices = 0;
+        size_t indices = 0;
+    };
+
+    void write_mesh(MeshRange& mesh, const std::vector<Vertex>& vertices, const std::vector<u32>& indices);
+
+    size_t m_max_vertices;
+    size_t m_max_indices;
+    size_t m_vertices_count = 0;
+    size_t m_indices_count = 0;
+    std::vector<MeshRange> m_meshes;
+    std::vector<MeshSpace> m_spaces;
+    VertexArray*                  m_p_vao = nullptr;
+    std::unique_ptr<VertexBuffer> m_p_vertex_buffer;
+    std::unique_ptr<IndexBuffer>  m_p_index_buffer;
+};
+
+}
+
+#endif // MESH_POOL_HPP
@@ -0,0 +1,298 @@
+#include "MipChain.hpp"
+#include "SimpleEngineCore/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMPLE_ENGINE_MIP_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace SimpleEngine {
+
+// Rows of output below this many pixels are filtered on the calling thread
+static constexpr size_t parallel_pixels_threshold = 64 * 1024;
+
+// Kaiser window parameters: support of +-3 source texels around the 2:1 center
+static constexpr i32 kaiser_radius = 3;
+static constexpr float kaiser_alpha = 4.f;
+
+// Linear RGBA, four floats per texel so one texel is one SSE register
+struct LinearImage
+{
+    u32 width = 0;
+    u32 height = 0;
+    std::vector<float> texels;
+};
+
+static float srgb_to_linear(const float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linear_to_srgb(const float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+}
+
+static const std::array<float, 256>& srgb_decode_table()
+{
+    static const std::array<float, 256> table = []
+    {
+        std::array<float, 256> values{};
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = srgb_to_linear(static_cast<float>(i) / 255.f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+// 4096 steps over [0, 1] keep the round trip exact for every 8-bit value
+static const std::array<u8, 4096>& srgb_encode_table()
+{
+    static const std::array<u8, 4096> table = []
+    {
+        std::array<u8, 4096> values{};
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const float linear = static_cast<float>(i) / static_cast<float>(values.size() - 1);
+            values[i] = static_cast<u8>(std::clamp(linear_to_srgb(linear) * 255.f + 0.5f, 0.f, 255.f));
+        }
+        return values;
+    }();
+    return table;
+}
+
+static LinearImage to_linear(const Image& image, const bool srgb)
+{
+    const std::array<float, 256>& decode = srgb_decode_table();
+    LinearImage result;
+    result.width = image.width;
+    result.height = image.height;
+    result.texels.resize(image.rgba.size());
+    for (size_t i = 0; i < image.rgba.size(); i += 4)
+    {
+        for (size_t c = 0; c < 3; ++c)
+        {
+            result.texels[i + c] = srgb ? decode[image.rgba[i + c]] : image.rgba[i + c] / 255.f;
+        }
+        result.texels[i + 3] = image.rgba[i + 3] / 255.f;
+    }
+    return result;
+}
+
+static Image to_image(const LinearImage& linear, const bool srgb)
+{
+    const std::array<u8, 4096>& encode = srgb_encode_table();
+    Image result;
+    result.width = linear.width;
+    result.height = linear.height;
+    result.rgba.resize(linear.texels.size());
+    for (size_t i = 0; i < linear.texels.size(); i += 4)
+    {
+        for (size_t c = 0; c < 4; ++c)
+        {
+            const float value = std::clamp(linear.texels[i + c], 0.f, 1.f);
+            result.rgba[i + c] = (srgb && c < 3)
+                ? encode[static_cast<size_t>(value * (encode.size() - 1) + 0.5f)]
+                : static_cast<u8>(value * 255.f + 0.5f);
+        }
+    }
+    return result;
+}
+
+// Source texels averaged into one output texel along an axis
+struct BoxTaps
+{
+    u32 first;
+    u32 count;
+    float weight;
+};
+
+static BoxTaps box_taps(const u32 x, const u32 source_extent, const u32 result_extent)
+{
+    if (source_extent == 1)
+    {
+        return { 0, 1, 1.f };
+    }
+    // On an odd axis the last output texel also takes the leftover source texel
+    const u32 count = (source_extent & 1) && x + 1 == result_extent ? 3u : 2u;
+    return { x * 2, count, 1.f / count };
+}
+
+static LinearImage downsample_box(const LinearImage& source, const u32 threads_count)
+{
+    LinearImage result;
+    result.width = std::max(1u, source.width / 2);
+    result.height = std::max(1u, source.height / 2);
+    result.texels.resize(size_t(result.width) * result.height * 4);
+
+    JobSystem& jobs = JobSystem::get();
+    const u32 grain = result.texels.size() / 4 >= parallel_pixels_threshold ? jobs.get_grain(result.height, threads_count) : result.height;
+    jobs.parallel_for(0u, result.height, grain, [&](const u32 first_row, const u32 last_row)
+    {
+        for (u32 y = first_row; y < last_row; ++y)
+        {
+            const BoxTaps rows = box_taps(y, source.height, result.height);
+            float* out = &result.texels[size_t(y) * result.width * 4];
+            for (u32 x = 0; x < result.width; ++x)
+            {
+                const BoxTaps columns = box_taps(x, source.width, result.width);
+                if (rows.count == 2 && columns.count == 2)
+                {
+                    const float* row0 = &source.texels[size_t(rows.first) * source.width * 4];
+                    const float* row1 = row0 + size_t(source.width) * 4;
+                    const size_t x0 = size_t(columns.first) * 4;
+                    const size_t x1 = x0 + 4;
+#ifdef SIMPLE_ENGINE_MIP_SSE
+                    const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)),
+                                                  _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+                    _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        out[x * 4 + c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25f;
+                    }
+#endif
+                    continue;
+                }
+
+                // Odd edges and single texel axes
+                float sum[4] = {};
+                for (u32 j = 0; j < rows.count; ++j)
+                {
+                    const float* row = &source.texels[(size_t(rows.first + j) * source.width + columns.first) * 4];
+                    for (u32 i = 0; i < columns.count * 4; ++i)
+                    {
+                        sum[i % 4] += row[i];
+                    }
+                }
+                const float weight = rows.weight * columns.weight;
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    out[x * 4 + c] = sum[c] * weight;
+                }
+            }
+        }
+    });
+    return result;
+}
+
+static float bessel_i0(const float x)
+{
+    float sum = 1.f;
+    float term = 1.f;
+    for (i32 k = 1; k < 16; ++k)
+    {
+        const float half_x_over_k = x / (2.f * k);
+        term *= half_x_over_k * half_x_over_k;
+        sum += term;
+    }
+    return sum;
+}
+
+// Normalized weights for the source texels 2*x - radius + 1 ... 2*x + radius of output texel x
+static std::array<float, 2 * kaiser_radius> kaiser_weights()
+{
+    std::array<float, 2 * kaiser_radius> weights{};
+    float total = 0.f;
+    for (i32 i = 0; i < 2 * kaiser_radius; ++i)
+    {
+        // Distance in output texels from the center between source texels 2x and 2x+1
+        const float distance = (static_cast<float>(i - kaiser_radius) + 0.5f) * 0.5f;
+        const float scaled = distance / (kaiser_radius * 0.5f);
+        const float window = bessel_i0(kaiser_alpha * std::sqrt(std::max(0.f, 1.f - scaled * scaled))) / bessel_i0(kaiser_alpha);
+        const float pi_distance = 3.14159265f * distance;
+        const float sinc = distance == 0.f ? 1.f : std::sin(pi_distance) / pi_distance;
+        weights[i] = sinc * window;
+        total += weights[i];
+    }
+    for (float& weight : weights)
+    {
+        weight /= total;
+    }
+    return weights;
+}
+
+// One separable 2:1 pass; `horizontal` picks the axis, the other axis is copied
+static LinearImage kaiser_pass(const LinearImage& source, const bool horizontal, const u32 threads_count)
+{
+    static const std::array<float, 2 * kaiser_radius> weights = kaiser_weights();
+
+    LinearImage result;
+    result.width = horizontal ? std::max(1u, source.width / 2) : source.width;
+    result.height = horizontal ? source.height : std::max(1u, source.height / 2);
+    result.texels.resize(size_t(result.width) * result.height * 4);
+
+    const i32 source_extent = static_cast<i32>(horizontal ? source.width : source.height);
+    JobSystem& jobs = JobSystem::get();
+    const u32 grain = result.texels.size() / 4 >= parallel_pixels_threshold ? jobs.get_grain(result.height, threads_count) : result.height;
+    jobs.parallel_for(0u, result.height, grain, [&](const u32 first_row, const u32 last_row)
+    {
+        for (u32 y = first_row; y < last_row; ++y)
+        {
+            for (u32 x = 0; x < result.width; ++x)
+            {
+                const i32 center = static_cast<i32>(horizontal ? x : y) * 2;
+#ifdef SIMPLE_ENGINE_MIP_SSE
+                __m128 sum = _mm_setzero_ps();
+#else
+                float sum[4] = { 0.f, 0.f, 0.f, 0.f };
+#endif
+                for (i32 i = 0; i < 2 * kaiser_radius; ++i)
+                {
+                    const i32 tap = std::clamp(center - kaiser_radius + 1 + i, 0, source_extent - 1);
+                    const size_t index = horizontal ? (size_t(y) * source.width + tap) * 4
+                                                    : (size_t(tap) * source.width + x) * 4;
+#ifdef SIMPLE_ENGINE_MIP_SSE
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&source.texels[index]), _mm_set1_ps(weights[i])));
+#else
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        sum[c] += source.texels[index + c] * weights[i];
+                    }
+#endif
+                }
+                float* out = &result.texels[(size_t(y) * result.width + x) * 4];
+#ifdef SIMPLE_ENGINE_MIP_SSE
+                _mm_storeu_ps(out, sum);
+#else
+                std::copy(sum, sum + 4, out);
+#endif
+            }
+        }
+    });
+    return result;
+}
+
+static LinearImage downsample_kaiser(const LinearImage& source, const u32 threads_count)
+{
+    // A 1-texel axis has nothing to filter, the pass then only copies
+    LinearImage horizontal = source.width > 1 ? kaiser_pass(source, true, threads_count) : source;
+    return source.height > 1 ? kaiser_pass(horizontal, false, threads_count) : horizontal;
+}
+
+std::vector<Image> generate_mip_chain(const Image& image, const EMipFilter filter, const bool srgb, const u32 threads_count)
+{
+    std::vector<Image> levels;
+    if (image.width == 0 || image.height == 0)
+    {
+        return levels;
+    }
+    levels.reserve(mip_levels_count(image.width, image.height) - 1);
+
+    LinearImage current = to_linear(image, srgb);
+    while (current.width > 1 || current.height > 1)
+    {
+        current = filter == EMipFilter::Kaiser ? downsample_kaiser(current, threads_count)
+                                               : downsample_box(current, threads_count);
+        levels.push_back(to_image(current, srgb));
+    }
+    return levels;
+}
+
+}
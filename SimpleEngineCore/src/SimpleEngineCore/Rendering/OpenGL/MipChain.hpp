@@ -0,0 +1,36 @@
+#ifndef MIP_CHAIN_HPP
+#define MIP_CHAIN_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureCompression.hpp"
+
+#include <vector>
+
+namespace SimpleEngine {
+
+enum class EMipFilter
+{
+    Box,    // 2x2 average
+    Kaiser  // Kaiser-windowed sinc over 6x6 source texels, keeps distant detail sharper
+};
+
+// Builds every level below `image` down to 1x1. Filtering happens on linear
+// values: with `srgb` the color channels are decoded from sRGB first and
+// encoded again per level, alpha is always linear. Each level is filtered from
+// the previous one at float precision and split by rows into at most
+// threads_count jobs (0 lets the job system choose).
+std::vector<Image> generate_mip_chain(const Image& image, const EMipFilter filter = EMipFilter::Box,
+                                      const bool srgb = true, const u32 threads_count = 0);
+
+constexpr u32 mip_levels_count(const u32 width, const u32 height)
+{
+    u32 levels = 1;
+    for (u32 size = width > height ? width : height; size > 1; size /= 2)
+    {
+        ++levels;
+    }
+    return levels;
+}
+
+}
+
+#endif // MIP_CHAIN_HPP
@@ -10,6 +10,8 @@
 #include "SimpleEngineCore/Rendering/OpenGL/VertexArray.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/Texture.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/Material.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ModelLoader.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Frustum.hpp"
 
 #include <memory>
 #include <glad/glad.h>
@@ -21,26 +23,46 @@ class Model : public Shape
 {
 public:
     Model(const char* path, const char* texture);
+    // Without upload_vertices there is no vertex buffer until upload_mesh(),
+    // for meshes that are drawn from a StaticMeshPool instead
+    Model(const std::vector<Vertex>& vertices, const char* texture, const bool upload_vertices = true);
     Model(const char* stl_path);
     virtual ~Model() override = default;
     virtual void render() override;
     const ShaderProgram& get_shader_program() const { return *m_p_shader_program; }
     
     void set_material(const Material& new_material);
+    // Replaces the triangle soup in place: InstancedModels of this model follow.
+    // Without a vertex buffer only the bounds and the count change.
+    void set_mesh(const std::vector<Vertex>& vertices);
+    // Same, creating the vertex buffer if there is none yet
+    void upload_mesh(const std::vector<Vertex>& vertices);
+    bool has_vertex_buffer() const noexcept { return m_p_positions_colors_vbo != nullptr; }
     const Material& get_material()const noexcept { return material; }
 
+    const VertexBuffer& get_vertex_buffer() const { return *m_p_positions_colors_vbo; }
+    const IndexBuffer* get_index_buffer() const { return m_p_index_buffer.get(); }
+    const Texture* get_texture() const { return m_p_texture.get(); }
+    Texture* get_texture() { return m_p_texture.get(); }
+    u64 get_vertex_count() const noexcept { return vertex_count; }
+
+    // Bounding sphere of the mesh in model space
+    const BoundingSphere& get_bounds() const noexcept { return bounds; }
+
     Model& operator=(const Model&) = delete;
     Model& operator=(Model&&) = delete;
 private:
     Material material;
-    i32 model_matrix_uniform_loc;
-    std::unique_ptr<ShaderProgram> m_p_shader_program;
-    std::unique_ptr<VertexArray>   m_p_vao;
+    i32 model_matrix_uniform_loc = -1;
+    std::shared_ptr<ShaderProgram> m_p_shader_program;
+    u32 m_shader_generation = 0;
+    VertexArray*                   m_p_vao = nullptr;
     std::unique_ptr<VertexBuffer>  m_p_positions_colors_vbo;
     std::unique_ptr<IndexBuffer>   m_p_index_buffer;
     std::unique_ptr<Texture>       m_p_texture;
     u64 vertex_count = 0;
-    i32 tex0_loc;
+    i32 tex0_loc = -1;
+    BoundingSphere bounds;
 };
 
 }
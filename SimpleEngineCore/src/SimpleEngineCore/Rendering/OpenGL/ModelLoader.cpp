@@ -0,0 +1,113 @@
+#include "ModelLoader.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+
+#include <glm/gtc/type_precision.hpp>
+
+namespace SimpleEngine
+{
+
+std::vector<Vertex> loadOBJ(const char* file_name)
+{
+    PROFILE_SCOPE("loadOBJ");
+    //Intermediate arrays live in the thread's scratch arena, dropped on return
+    LinearArena& scratch = LinearArena::get_scratch();
+    const ArenaScope scratch_scope(scratch);
+    const ArenaAllocator<GLint> allocator(scratch, EMemoryTag::Assets);
+
+    //Vertex portions
+    ArenaVector<glm::fvec3> vertex_positions(allocator);
+    ArenaVector<glm::fvec2> vertex_texcoords(allocator);
+    ArenaVector<glm::fvec3> vertex_normals(allocator);
+
+    //Face vectors
+    ArenaVector<GLint> vertex_position_indicies(allocator);
+    ArenaVector<GLint> vertex_texcoord_indicies(allocator);
+    ArenaVector<GLint> vertex_normal_indicies(allocator);
+
+    std::stringstream ss;
+
+    std::ifstream in_file(file_name);
+    //File open error check
+    if (!in_file.is_open())
+    {
+        LOG_ERROR("can't open file");
+    }
+
+    std::string line;
+    //Read one line at a time
+    while (std::getline(in_file, line))
+    {
+        //Get the prefix of the line
+        ss.clear();
+        ss.str(line);
+        std::string prefix;
+        ss >> prefix;
+        
+        if (prefix == "v") //Vertex position
+        {
+            glm::vec3 temp_vec3;
+            ss >> temp_vec3.x >> temp_vec3.y >> temp_vec3.z;
+            vertex_positions.push_back(temp_vec3);
+        }
+        else if (prefix == "vt")
+        {
+            glm::vec2 temp_vec2;
+            ss >> temp_vec2.x >> temp_vec2.y;
+            //temp_vec2.y = 1.0f - temp_vec2.y;
+            vertex_texcoords.push_back(temp_vec2);
+        }
+        else if (prefix == "vn")
+        {
+            glm::vec3 temp_vec3;
+            ss >> temp_vec3.x >> temp_vec3.y >> temp_vec3.z;
+            vertex_normals.push_back(temp_vec3);
+        }
+        else if (prefix == "f")
+        {
+            int counter = 0;
+            GLint temp_glint = 0;
+            while (ss >> temp_glint)
+            {
+                //Pushing indices into correct arrays
+                if (counter == 0)
+                    vertex_position_indicies.push_back(temp_glint);
+                else if (counter == 1)
+                    vertex_texcoord_indicies.push_back(temp_glint);
+                else if (counter == 2)
+                    vertex_normal_indicies.push_back(temp_glint);
+
+                //Handling characters
+                if (ss.peek() == '/')
+                {
+                    ++counter;
+                    ss.ignore(1, '/');
+                }
+                else if (ss.peek() == ' ')
+                {
+                    ++counter;
+                    ss.ignore(1, ' ');
+                }
+
+                //Reset the counter
+                if (counter > 2)
+                    counter = 0;
+            }
+        }
+    }
+
+    //Build final vertex array (mesh)
+    std::vector<Vertex> vertices;
+    vertices.resize(vertex_position_indicies.size(), Vertex());
+
+    //Load in all indices
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        vertices[i].position = vertex_positions[vertex_position_indicies[i] - 1];
+        vertices[i].texcoord = vertex_texcoords[vertex_texcoord_indicies[i] - 1];
+        vertices[i].normal = vertex_normals[vertex_normal_indicies[i] - 1];
+    }
+    return vertices;
+}
+
+}
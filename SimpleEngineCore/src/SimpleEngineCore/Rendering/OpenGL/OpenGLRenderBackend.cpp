@@ -0,0 +1,457 @@
+#include "OpenGLRenderBackend.hpp"
+#include "SimpleEngineCore/Log.hpp"
+
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace SimpleEngine {
+
+// Buffers, vertex arrays and textures go through the direct state access
+// entry points, so creating or updating one never disturbs the bindings a
+// draw relies on (an element buffer bound while a VAO is bound changes it).
+
+u32 OpenGLRenderBackend::create_buffer(const GLenum /*target*/, const size_t size, const void* data, const GLenum usage)
+{
+    GLuint buffer = 0;
+    glCreateBuffers(1, &buffer);
+    glNamedBufferData(buffer, static_cast<GLsizeiptr>(size), data, usage);
+    return buffer;
+}
+
+void OpenGLRenderBackend::delete_buffer(const u32 buffer)
+{
+    glDeleteBuffers(1, &buffer);
+}
+
+void OpenGLRenderBackend::bind_buffer(const GLenum target, const u32 buffer)
+{
+    glBindBuffer(target, buffer);
+}
+
+void OpenGLRenderBackend::bind_buffer_base(const GLenum target, const u32 index, const u32 buffer)
+{
+    glBindBufferBase(target, index, buffer);
+}
+
+void OpenGLRenderBackend::buffer_data(const GLenum /*target*/, const u32 buffer, const size_t size, const void* data, const GLenum usage)
+{
+    glNamedBufferData(buffer, static_cast<GLsizeiptr>(size), data, usage);
+}
+
+void OpenGLRenderBackend::buffer_sub_data(const GLenum /*target*/, const u32 buffer, const size_t offset, const size_t size, const void* data)
+{
+    glNamedBufferSubData(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+u32 OpenGLRenderBackend::create_vertex_array()
+{
+    GLuint vertex_array = 0;
+    glCreateVertexArrays(1, &vertex_array);
+    return vertex_array;
+}
+
+void OpenGLRenderBackend::delete_vertex_array(const u32 vertex_array)
+{
+    glDeleteVertexArrays(1, &vertex_array);
+}
+
+void OpenGLRenderBackend::bind_vertex_array(const u32 vertex_array)
+{
+    glBindVertexArray(vertex_array);
+}
+
+void OpenGLRenderBackend::vertex_array_attribute(const u32 vertex_array, const u32 attribute, const u32 binding,
+                                                 const u32 components_count, const GLenum component_type, const u32 offset)
+{
+    glEnableVertexArrayAttrib(vertex_array, attribute);
+    if (component_type == GL_INT)
+    {
+        glVertexArrayAttribIFormat(vertex_array, attribute, static_cast<GLint>(components_count), component_type, offset);
+    }
+    else
+    {
+        glVertexArrayAttribFormat(vertex_array, attribute, static_cast<GLint>(components_count), component_type, GL_FALSE, offset);
+    }
+    glVertexArrayAttribBinding(vertex_array, attribute, binding);
+}
+
+void OpenGLRenderBackend::vertex_array_binding_divisor(const u32 vertex_array, const u32 binding, const u32 divisor)
+{
+    glVertexArrayBindingDivisor(vertex_array, binding, divisor);
+}
+
+void OpenGLRenderBackend::vertex_array_vertex_buffer(const u32 vertex_array, const u32 binding, const u32 buffer,
+                                                     const size_t offset, const u32 stride)
+{
+    glVertexArrayVertexBuffer(vertex_array, binding, buffer, static_cast<GLintptr>(offset), static_cast<GLsizei>(stride));
+}
+
+void OpenGLRenderBackend::vertex_array_element_buffer(const u32 vertex_array, const u32 buffer)
+{
+    glVertexArrayElementBuffer(vertex_array, buffer);
+}
+
+u32 OpenGLRenderBackend::create_texture(const GLenum type, const u32 levels_count, const GLenum internal_format,
+                                        const u32 width, const u32 height, const u32 depth)
+{
+    GLuint texture = 0;
+    glCreateTextures(type, 1, &texture);
+    if (type == GL_TEXTURE_2D_ARRAY || type == GL_TEXTURE_3D)
+    {
+        glTextureStorage3D(texture, static_cast<GLsizei>(levels_count), internal_format,
+                           static_cast<GLsizei>(width), static_cast<GLsizei>(height), static_cast<GLsizei>(depth));
+    }
+    else
+    {
+        glTextureStorage2D(texture, static_cast<GLsizei>(levels_count), internal_format,
+                           static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+    }
+    return texture;
+}
+
+void OpenGLRenderBackend::delete_texture(const u32 texture)
+{
+    glDeleteTextures(1, &texture);
+}
+
+void OpenGLRenderBackend::active_texture(const u32 unit)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void OpenGLRenderBackend::bind_texture(const GLenum type, const u32 texture)
+{
+    glBindTexture(type, texture);
+}
+
+void OpenGLRenderBackend::texture_parameter(const GLenum /*type*/, const u32 texture, const GLenum name, const i32 value)
+{
+    glTextureParameteri(texture, name, value);
+}
+
+void OpenGLRenderBackend::texture_sub_image(const TextureRegion& region, const GLenum format, const GLenum pixel_type,
+                                            const size_t size, const void* data)
+{
+    const bool layered = region.type == GL_TEXTURE_2D_ARRAY || region.type == GL_TEXTURE_3D;
+    const GLint x = static_cast<GLint>(region.x);
+    const GLint y = static_cast<GLint>(region.y);
+    const GLsizei width = static_cast<GLsizei>(region.width);
+    const GLsizei height = static_cast<GLsizei>(region.height);
+    if (pixel_type == 0)
+    {
+        if (layered)
+        {
+            glCompressedTextureSubImage3D(region.texture, region.level, x, y, static_cast<GLint>(region.z),
+                                          width, height, static_cast<GLsizei>(region.depth),
+                                          format, static_cast<GLsizei>(size), data);
+        }
+        else
+        {
+            glCompressedTextureSubImage2D(region.texture, region.level, x, y, width, height,
+                                          format, static_cast<GLsizei>(size), data);
+        }
+    }
+    else if (layered)
+    {
+        glTextureSubImage3D(region.texture, region.level, x, y, static_cast<GLint>(region.z),
+                            width, height, static_cast<GLsizei>(region.depth), format, pixel_type, data);
+    }
+    else
+    {
+        glTextureSubImage2D(region.texture, region.level, x, y, width, height, format, pixel_type, data);
+    }
+}
+
+void OpenGLRenderBackend::copy_texture_region(const TextureRegion& source, const TextureRegion& target)
+{
+    glCopyImageSubData(source.texture, source.type, source.level,
+                       static_cast<GLint>(source.x), static_cast<GLint>(source.y), static_cast<GLint>(source.z),
+                       target.texture, target.type, target.level,
+                       static_cast<GLint>(target.x), static_cast<GLint>(target.y), static_cast<GLint>(target.z),
+                       static_cast<GLsizei>(source.width), static_cast<GLsizei>(source.height), static_cast<GLsizei>(source.depth));
+}
+
+// GL_KHR_parallel_shader_compile (and the ARB one, which shares its values)
+static constexpr GLenum max_shader_compiler_threads = 0x91B0;
+static constexpr GLenum completion_status = 0x91B1;
+using MaxShaderCompilerThreadsFn = void (APIENTRYP)(GLuint count);
+static bool s_parallel_shader_compile = false;
+
+void OpenGLRenderBackend::load_extensions(GLADloadproc load)
+{
+    GLint extensions_count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions_count);
+    for (GLint i = 0; i < extensions_count && !s_parallel_shader_compile; ++i)
+    {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        s_parallel_shader_compile = std::strcmp(extension, "GL_KHR_parallel_shader_compile") == 0
+                                 || std::strcmp(extension, "GL_ARB_parallel_shader_compile") == 0;
+    }
+    if (!s_parallel_shader_compile)
+    {
+        LOG_INFO("GL_KHR_parallel_shader_compile is not available, shader builds are finished the frame after they start");
+        return;
+    }
+
+    auto max_shader_compiler_threads_fn = reinterpret_cast<MaxShaderCompilerThreadsFn>(load("glMaxShaderCompilerThreadsKHR"));
+    if (max_shader_compiler_threads_fn == nullptr)
+    {
+        max_shader_compiler_threads_fn = reinterpret_cast<MaxShaderCompilerThreadsFn>(load("glMaxShaderCompilerThreadsARB"));
+    }
+    if (max_shader_compiler_threads_fn != nullptr)
+    {
+        // As many as the driver sees fit
+        max_shader_compiler_threads_fn(0xFFFFFFFF);
+    }
+    GLint threads_count = 0;
+    glGetIntegerv(max_shader_compiler_threads, &threads_count);
+    LOG_INFO("Parallel shader compilation: up to {0} driver threads", static_cast<u32>(threads_count));
+}
+
+static GLuint compile_shader(const char* source, const GLenum shader_type)
+{
+    const GLuint shader = glCreateShader(shader_type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+static bool get_compile_log(const GLuint shader, std::string& error_log)
+{
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (success == GL_FALSE)
+    {
+        GLchar info_log[1024];
+        glGetShaderInfoLog(shader, 1024, nullptr, info_log);
+        error_log = info_log;
+        return false;
+    }
+    return true;
+}
+
+// No status is queried here: asking would wait for the driver to finish
+u32 OpenGLRenderBackend::begin_program(const char* vertex_source, const char* fragment_source)
+{
+    PendingProgram shaders;
+    shaders.vertex_shader = compile_shader(vertex_source, GL_VERTEX_SHADER);
+    shaders.fragment_shader = compile_shader(fragment_source, GL_FRAGMENT_SHADER);
+
+    const GLuint program = glCreateProgram();
+    glAttachShader(program, shaders.vertex_shader);
+    glAttachShader(program, shaders.fragment_shader);
+    glLinkProgram(program);
+    m_pending_programs[program] = shaders;
+    return program;
+}
+
+bool OpenGLRenderBackend::is_program_ready(const u32 program)
+{
+    const auto pending = m_pending_programs.find(program);
+    if (pending == m_pending_programs.end())
+    {
+        return true;
+    }
+    if (!s_parallel_shader_compile)
+    {
+        // Any status query would block. Reporting ready from the second poll
+        // on gives a driver that compiles on its own thread a frame to do it
+        // in, before finish_program() waits for whatever is left.
+        return ++pending->second.polls > 1;
+    }
+    GLint completed = GL_FALSE;
+    glGetProgramiv(program, completion_status, &completed);
+    return completed == GL_TRUE;
+}
+
+bool OpenGLRenderBackend::finish_program(const u32 program, std::string& error_log)
+{
+    const auto pending = m_pending_programs.find(program);
+    if (pending == m_pending_programs.end())
+    {
+        return true;
+    }
+    const PendingProgram shaders = pending->second;
+    m_pending_programs.erase(pending);
+
+    bool success = true;
+    if (!get_compile_log(shaders.vertex_shader, error_log))
+    {
+        error_log = "VERTEX_SHADER: compile-time error:\n" + error_log;
+        success = false;
+    }
+    else if (!get_compile_log(shaders.fragment_shader, error_log))
+    {
+        error_log = "FRAGMENT SHADER: compile-time error:\n" + error_log;
+        success = false;
+    }
+    else
+    {
+        GLint linked;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked == GL_FALSE)
+        {
+            GLchar info_log[1024];
+            glGetProgramInfoLog(program, 1024, nullptr, info_log);
+            error_log = std::string("SHADER PROGRAM: Link-time error:\n") + info_log;
+            success = false;
+        }
+    }
+    release_shaders(program, shaders);
+    return success;
+}
+
+void OpenGLRenderBackend::release_shaders(const u32 program, const PendingProgram& shaders)
+{
+    glDetachShader(program, shaders.vertex_shader);
+    glDetachShader(program, shaders.fragment_shader);
+    glDeleteShader(shaders.vertex_shader);
+    glDeleteShader(shaders.fragment_shader);
+}
+
+void OpenGLRenderBackend::delete_program(const u32 program)
+{
+    const auto pending = m_pending_programs.find(program);
+    if (pending != m_pending_programs.end())
+    {
+        release_shaders(program, pending->second);
+        m_pending_programs.erase(pending);
+    }
+    glDeleteProgram(program);
+}
+
+void OpenGLRenderBackend::use_program(const u32 program)
+{
+    glUseProgram(program);
+}
+
+i32 OpenGLRenderBackend::get_uniform_location(const u32 program, const char* name)
+{
+    return glGetUniformLocation(program, name);
+}
+
+void OpenGLRenderBackend::set_uniform(const i32 location, const i32 value)
+{
+    glUniform1i(location, value);
+}
+
+void OpenGLRenderBackend::set_uniform(const i32 location, const float value)
+{
+    glUniform1f(location, value);
+}
+
+void OpenGLRenderBackend::set_uniform(const i32 location, const glm::vec3& value)
+{
+    glUniform3fv(location, 1, glm::value_ptr(value));
+}
+
+void OpenGLRenderBackend::set_uniform(const i32 location, const glm::mat4& value)
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void OpenGLRenderBackend::draw_arrays(const GLenum mode, const u32 first, const u32 count, const u32 instances_count)
+{
+    if (instances_count == 1)
+    {
+        glDrawArrays(mode, static_cast<GLint>(first), static_cast<GLsizei>(count));
+    }
+    else
+    {
+        glDrawArraysInstanced(mode, static_cast<GLint>(first), static_cast<GLsizei>(count), static_cast<GLsizei>(instances_count));
+    }
+}
+
+void OpenGLRenderBackend::draw_elements(const GLenum mode, const u32 count, const size_t offset, const u32 instances_count)
+{
+    const void* indices = reinterpret_cast<const void*>(offset);
+    if (instances_count == 1)
+    {
+        glDrawElements(mode, static_cast<GLsizei>(count), GL_UNSIGNED_INT, indices);
+    }
+    else
+    {
+        glDrawElementsInstanced(mode, static_cast<GLsizei>(count), GL_UNSIGNED_INT, indices, static_cast<GLsizei>(instances_count));
+    }
+}
+
+void OpenGLRenderBackend::multi_draw_elements_indirect(const GLenum mode, const size_t offset, const u32 draws_count)
+{
+    glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset), static_cast<GLsizei>(draws_count), 0);
+}
+
+u32 OpenGLRenderBackend::create_query()
+{
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void OpenGLRenderBackend::delete_query(const u32 query)
+{
+    glDeleteQueries(1, &query);
+}
+
+void OpenGLRenderBackend::query_timestamp(const u32 query)
+{
+    glQueryCounter(query, GL_TIMESTAMP);
+}
+
+bool OpenGLRenderBackend::is_query_available(const u32 query)
+{
+    GLint available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available != 0;
+}
+
+u64 OpenGLRenderBackend::get_query_result(const u32 query)
+{
+    GLuint64 result = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+    return result;
+}
+
+u64 OpenGLRenderBackend::get_timestamp()
+{
+    GLint64 timestamp = 0;
+    glGetInteger64v(GL_TIMESTAMP, &timestamp);
+    return static_cast<u64>(timestamp);
+}
+
+u32 OpenGLRenderBackend::insert_fence()
+{
+    const GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!m_free_fences.empty())
+    {
+        const u32 fence = m_free_fences.back();
+        m_free_fences.pop_back();
+        m_fences[fence] = sync;
+        return fence;
+    }
+    m_fences.push_back(sync);
+    return static_cast<u32>(m_fences.size() - 1);
+}
+
+bool OpenGLRenderBackend::is_fence_signaled(const u32 fence)
+{
+    if (fence == 0 || fence >= m_fences.size() || m_fences[fence] == nullptr)
+    {
+        return true;
+    }
+    // A zero timeout only polls; the flush makes sure the fence gets to the GPU
+    const GLenum status = glClientWaitSync(m_fences[fence], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void OpenGLRenderBackend::delete_fence(const u32 fence)
+{
+    if (fence == 0 || fence >= m_fences.size() || m_fences[fence] == nullptr)
+    {
+        return;
+    }
+    glDeleteSync(m_fences[fence]);
+    m_fences[fence] = nullptr;
+    m_free_fences.push_back(fence);
+}
+
+}
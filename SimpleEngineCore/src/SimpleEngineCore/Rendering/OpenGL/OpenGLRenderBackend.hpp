@@ -0,0 +1,93 @@
+#ifndef OPENGL_RENDER_BACKEND_HPP
+#define OPENGL_RENDER_BACKEND_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace SimpleEngine {
+
+// Forwards every call to the current GL context
+class OpenGLRenderBackend final : public RenderBackend
+{
+public:
+    // Once the context is current: lets the driver compile shaders on its own
+    // threads when it has GL_KHR_parallel_shader_compile. The generated
+    // loader doesn't cover the extension, hence the proc address loader.
+    static void load_extensions(GLADloadproc load);
+
+    const char* get_name() const override { return "OpenGL"; }
+
+    u32 create_buffer(const GLenum target, const size_t size, const void* data, const GLenum usage) override;
+    void delete_buffer(const u32 buffer) override;
+    void bind_buffer(const GLenum target, const u32 buffer) override;
+    void bind_buffer_base(const GLenum target, const u32 index, const u32 buffer) override;
+    void buffer_data(const GLenum target, const u32 buffer, const size_t size, const void* data, const GLenum usage) override;
+    void buffer_sub_data(const GLenum target, const u32 buffer, const size_t offset, const size_t size, const void* data) override;
+
+    u32 create_vertex_array() override;
+    void delete_vertex_array(const u32 vertex_array) override;
+    void bind_vertex_array(const u32 vertex_array) override;
+    void vertex_array_attribute(const u32 vertex_array, const u32 attribute, const u32 binding,
+                                const u32 components_count, const GLenum component_type, const u32 offset) override;
+    void vertex_array_binding_divisor(const u32 vertex_array, const u32 binding, const u32 divisor) override;
+    void vertex_array_vertex_buffer(const u32 vertex_array, const u32 binding, const u32 buffer,
+                                    const size_t offset, const u32 stride) override;
+    void vertex_array_element_buffer(const u32 vertex_array, const u32 buffer) override;
+
+    u32 create_texture(const GLenum type, const u32 levels_count, const GLenum internal_format,
+                       const u32 width, const u32 height, const u32 depth) override;
+    void delete_texture(const u32 texture) override;
+    void active_texture(const u32 unit) override;
+    void bind_texture(const GLenum type, const u32 texture) override;
+    void texture_parameter(const GLenum type, const u32 texture, const GLenum name, const i32 value) override;
+    void texture_sub_image(const TextureRegion& region, const GLenum format, const GLenum pixel_type,
+                           const size_t size, const void* data) override;
+    void copy_texture_region(const TextureRegion& source, const TextureRegion& target) override;
+
+    u32 begin_program(const char* vertex_source, const char* fragment_source) override;
+    bool is_program_ready(const u32 program) override;
+    bool finish_program(const u32 program, std::string& error_log) override;
+    void delete_program(const u32 program) override;
+    void use_program(const u32 program) override;
+    i32 get_uniform_location(const u32 program, const char* name) override;
+    void set_uniform(const i32 location, const i32 value) override;
+    void set_uniform(const i32 location, const float value) override;
+    void set_uniform(const i32 location, const glm::vec3& value) override;
+    void set_uniform(const i32 location, const glm::mat4& value) override;
+
+    void draw_arrays(const GLenum mode, const u32 first, const u32 count, const u32 instances_count) override;
+    void draw_elements(const GLenum mode, const u32 count, const size_t offset, const u32 instances_count) override;
+    void multi_draw_elements_indirect(const GLenum mode, const size_t offset, const u32 draws_count) override;
+
+    u32 create_query() override;
+    void delete_query(const u32 query) override;
+    void query_timestamp(const u32 query) override;
+    bool is_query_available(const u32 query) override;
+    u64 get_query_result(const u32 query) override;
+    u64 get_timestamp() override;
+
+    u32 insert_fence() override;
+    bool is_fence_signaled(const u32 fence) override;
+    void delete_fence(const u32 fence) override;
+
+private:
+    // Shaders stay attached until finish_program(), for their compile logs
+    struct PendingProgram
+    {
+        GLuint vertex_shader = 0;
+        GLuint fragment_shader = 0;
+        u32 polls = 0; // is_program_ready() calls, counted without the extension
+    };
+    void release_shaders(const u32 program, const PendingProgram& shaders);
+
+    std::unordered_map<u32, PendingProgram> m_pending_programs;
+    // GL sync objects are pointers; fence names index this, 0 stays unused
+    std::vector<GLsync> m_fences{ nullptr };
+    std::vector<u32> m_free_fences;
+};
+
+}
+
+#endif // OPENGL_RENDER_BACKEND_HPP
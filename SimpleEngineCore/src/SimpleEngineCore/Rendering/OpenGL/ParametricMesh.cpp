@@ -0,0 +1,359 @@
+#include "ParametricMesh.hpp"
+#include "BakedPrimitives.hpp"
+#include "RenderStats.hpp"
+#include "SimpleEngineCore/JobSystem.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+namespace SimpleEngine {
+
+// Below this many vertices splitting rows into jobs costs more than it saves
+static constexpr size_t parallel_vertices_threshold = 1 << 15;
+
+static std::unordered_map<PrimitiveKey, std::shared_ptr<PrimitiveMesh>, PrimitiveKeyHash> s_shared_primitive_meshes;
+
+// The shapes' default arguments, evaluated by the compiler so the common
+// debug primitives are uploaded straight from read-only data
+static constexpr glm::vec3 baked_white{ 1.f, 1.f, 1.f };
+static constexpr glm::vec3 baked_origin{ 0.f, 0.f, 0.f };
+static constexpr auto baked_torus = bake_torus<6, 6>(1.5f, 0.5f, baked_white, baked_origin);
+static constexpr auto baked_cone = bake_cone<30>(1.f, 0.5f, baked_white, baked_origin);
+static constexpr auto baked_cylinder = bake_cylinder<30>(1.f, 0.5f, baked_white, baked_origin);
+static constexpr auto baked_spiral = bake_spiral<360 * 6>(baked_white, baked_origin);
+static constexpr auto baked_trapezoid = bake_trapezoid(0.5f, 1.f, baked_white, baked_origin);
+
+struct BakedPrimitive
+{
+    PrimitiveKey key;
+    const ColoredVertex* vertices;
+    size_t vertices_count;
+    const GLuint* indices;
+    size_t indices_count;
+};
+
+template<typename BakedMeshT>
+static BakedPrimitive make_baked_primitive(const PrimitiveKey& key, const BakedMeshT& mesh)
+{
+    return { key, mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(), mesh.indices.size() };
+}
+
+static const BakedPrimitive* find_baked_primitive(const PrimitiveKey& key)
+{
+    static const BakedPrimitive baked_primitives[] =
+    {
+        make_baked_primitive(make_torus_key(1.5f, 6, 0.5f, 6, baked_white, baked_origin), baked_torus),
+        make_baked_primitive(make_cone_key(1.f, 0.5f, 30, baked_white, baked_origin), baked_cone),
+        make_baked_primitive(make_cylinder_key(1.f, 0.5f, 30, baked_white, baked_origin), baked_cylinder),
+        make_baked_primitive(make_spiral_key(360 * 6, baked_white, baked_origin), baked_spiral),
+        make_baked_primitive(make_trapezoid_key(0.5f, 1.f, baked_white, baked_origin), baked_trapezoid)
+    };
+
+    for (const BakedPrimitive& baked : baked_primitives)
+    {
+        if (baked.key == key)
+        {
+            return &baked;
+        }
+    }
+    return nullptr;
+}
+
+MeshData generate_surface(const SurfaceDesc& desc, const ETopology topology, const SurfaceVertexFn& vertex_fn,
+                          const ColoredVertex& south_pole, const ColoredVertex& north_pole)
+{
+    MeshData mesh;
+    if (desc.u_segments == 0 || desc.v_rows == 0)
+    {
+        return mesh;
+    }
+
+    mesh.vertices.resize(surface_vertices_count(desc));
+    mesh.indices.resize(surface_indices_count(desc, topology));
+
+    const u32 U = desc.u_segments;
+    const u32 V = desc.v_rows;
+    const size_t u_edges = surface_u_edges(desc);
+    const size_t v_edges = surface_v_edges(desc);
+    auto grid_index = [U, V](const u32 u, const u32 v) -> GLuint
+    {
+        return static_cast<GLuint>((v % V) * U + (u % U));
+    };
+
+    ColoredVertex* vertices = mesh.vertices.data();
+    GLuint* indices = mesh.indices.data();
+
+    // Every row writes to an offset known in closed form, so rows can be filled in any order
+    JobSystem& jobs = JobSystem::get();
+    const u32 grain = mesh.vertices.size() >= parallel_vertices_threshold ? jobs.get_grain(V) : V;
+    jobs.parallel_for(0u, V, grain, [&](const u32 first_row, const u32 last_row)
+    {
+        for (u32 v = first_row; v < last_row; ++v)
+        {
+            ColoredVertex* row = vertices + size_t(v) * U;
+            for (u32 u = 0; u < U; ++u)
+            {
+                row[u] = vertex_fn(u, v);
+            }
+
+            if (topology == ETopology::Lines)
+            {
+                GLuint* out = indices + 2 * v * (u_edges + U);
+                for (u32 u = 0; u < u_edges; ++u)
+                {
+                    *out++ = grid_index(u, v);
+                    *out++ = grid_index(u + 1, v);
+                }
+                if (v < v_edges)
+                {
+                    for (u32 u = 0; u < U; ++u)
+                    {
+                        *out++ = grid_index(u, v);
+                        *out++ = grid_index(u, v + 1);
+                    }
+                }
+            }
+            else if (v < v_edges)
+            {
+                GLuint* out = indices + 6 * v * u_edges;
+                for (u32 u = 0; u < u_edges; ++u)
+                {
+                    const GLuint a = grid_index(u, v);
+                    const GLuint b = grid_index(u + 1, v);
+                    const GLuint c = grid_index(u + 1, v + 1);
+                    const GLuint d = grid_index(u, v + 1);
+                    *out++ = a; *out++ = b; *out++ = c;
+                    *out++ = a; *out++ = c; *out++ = d;
+                }
+            }
+        }
+    });
+
+    size_t next_vertex = size_t(U) * V;
+    GLuint* out = indices + (topology == ETopology::Lines
+                             ? 2 * (V * u_edges + U * v_edges)
+                             : 6 * u_edges * v_edges);
+    auto add_pole = [&](const ColoredVertex& pole, const u32 row, const bool facing_down)
+    {
+        const GLuint pole_index = static_cast<GLuint>(next_vertex);
+        vertices[next_vertex++] = pole;
+        if (topology == ETopology::Lines)
+        {
+            for (u32 u = 0; u < U; ++u)
+            {
+                *out++ = pole_index;
+                *out++ = grid_index(u, row);
+            }
+            return;
+        }
+        for (u32 u = 0; u < u_edges; ++u)
+        {
+            *out++ = pole_index;
+            *out++ = grid_index(facing_down ? u + 1 : u, row);
+            *out++ = grid_index(facing_down ? u : u + 1, row);
+        }
+    };
+    if (desc.south_pole)
+    {
+        add_pole(south_pole, 0, true);
+    }
+    if (desc.north_pole)
+    {
+        add_pole(north_pole, V - 1, false);
+    }
+
+    return mesh;
+}
+
+bool PrimitiveKey::operator==(const PrimitiveKey& other) const
+{
+    return primitive == other.primitive
+        && topology == other.topology
+        && u_segments == other.u_segments
+        && v_rows == other.v_rows
+        && params == other.params
+        && color == other.color
+        && center == other.center;
+}
+
+static void hash_combine(size_t& seed, const size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t PrimitiveKeyHash::operator()(const PrimitiveKey& key) const
+{
+    const std::hash<float> float_hash;
+    size_t seed = std::hash<u32>()(static_cast<u32>(key.primitive));
+    hash_combine(seed, std::hash<u32>()(static_cast<u32>(key.topology)));
+    hash_combine(seed, std::hash<u32>()(key.u_segments));
+    hash_combine(seed, std::hash<u32>()(key.v_rows));
+    for (const float param : key.params)
+    {
+        hash_combine(seed, float_hash(param));
+    }
+    for (i32 i = 0; i < 3; ++i)
+    {
+        hash_combine(seed, float_hash(key.color[i]));
+        hash_combine(seed, float_hash(key.center[i]));
+    }
+    return seed;
+}
+
+PrimitiveKey make_torus_key(const float main_radius, const u32 main_segments, const float circle_radius, const u32 circle_segments,
+                            const glm::vec3& color, const glm::vec3& center, const ETopology topology)
+{
+    return { EPrimitive::Torus, topology, main_segments, circle_segments, { main_radius, circle_radius, 0.f }, color, center };
+}
+
+PrimitiveKey make_cone_key(const float height, const float radius, const u32 segments,
+                           const glm::vec3& color, const glm::vec3& center, const ETopology topology)
+{
+    return { EPrimitive::Cone, topology, segments, 1, { height, radius, 0.f }, color, center };
+}
+
+PrimitiveKey make_cylinder_key(const float height, const float radius, const u32 segments,
+                               const glm::vec3& color, const glm::vec3& center, const ETopology topology)
+{
+    return { EPrimitive::Cylinder, topology, segments, 2, { height, radius, 0.f }, color, center };
+}
+
+PrimitiveKey make_spiral_key(const u32 segments, const glm::vec3& color, const glm::vec3& center)
+{
+    return { EPrimitive::Spiral, ETopology::Lines, segments, 1, {}, color, center };
+}
+
+PrimitiveKey make_trapezoid_key(const float up_length, const float down_length,
+                                const glm::vec3& color, const glm::vec3& center, const ETopology topology)
+{
+    return { EPrimitive::Trapezoid, topology, 4, 2, { up_length, down_length, 0.f }, color, center };
+}
+
+MeshData generate_primitive(const PrimitiveKey& key)
+{
+    const glm::vec3 color = key.color;
+    const glm::vec3 center = key.center;
+    const float angle_step = 2.f * static_cast<float>(M_PI) / static_cast<float>(std::max(key.u_segments, 1u));
+
+    switch (key.primitive)
+    {
+        case EPrimitive::Torus:
+        {
+            const float main_radius = key.params[0];
+            const float circle_radius = key.params[1];
+            const float tube_step = 2.f * static_cast<float>(M_PI) / static_cast<float>(std::max(key.v_rows, 1u));
+            return generate_surface({ key.u_segments, key.v_rows, true, true }, key.topology,
+                [=](const u32 u, const u32 v)
+                {
+                    const float ring_radius = main_radius + circle_radius * cos(tube_step * v);
+                    return ColoredVertex{ glm::vec3(ring_radius * cos(angle_step * u),
+                                                    ring_radius * sin(angle_step * u),
+                                                    circle_radius * sin(tube_step * v)) + center, color };
+                });
+        }
+
+        case EPrimitive::Cone:
+        case EPrimitive::Cylinder:
+        {
+            const float height = key.params[0];
+            const float radius = key.params[1];
+            const float row_height = key.v_rows > 1 ? height / static_cast<float>(key.v_rows - 1) : 0.f;
+            return generate_surface({ key.u_segments, key.v_rows, true, false, true, true }, key.topology,
+                [=](const u32 u, const u32 v)
+                {
+                    return ColoredVertex{ glm::vec3(radius * cos(angle_step * u),
+                                                    radius * sin(angle_step * u),
+                                                    row_height * v) + center, color };
+                },
+                { center, color },
+                { center + glm::vec3(0.f, 0.f, height), color });
+        }
+
+        case EPrimitive::Spiral:
+        {
+            // One degree of the helix parameter per sample, the height lags one sample behind
+            return generate_surface({ key.u_segments, 1 }, ETopology::Lines,
+                [=](const u32 u, const u32)
+                {
+                    const float b = 2.f * static_cast<float>(u) * static_cast<float>(M_PI) / 180.f;
+                    const float x = cos(b);
+                    const float y = sin(b);
+                    const float z = u == 0 ? 0.f : static_cast<float>(u - 1) / 360.f;
+                    return ColoredVertex{ glm::vec3(center.x + x, center.z + z, center.y + y),
+                                          glm::vec3(0.5f + x, 0.5f + y, 0.5f + z) * color };
+                });
+        }
+
+        case EPrimitive::Trapezoid:
+        {
+            static constexpr float corner_x[4] = { 1.f, 1.f, -1.f, -1.f };
+            static constexpr float corner_y[4] = { 1.f, -1.f, -1.f, 1.f };
+            const float half_lengths[2] = { key.params[1] * 0.5f, key.params[0] * 0.5f };
+            return generate_surface({ 4, 2, true, false }, key.topology,
+                [=](const u32 u, const u32 v)
+                {
+                    const float half = half_lengths[v];
+                    return ColoredVertex{ glm::vec3(corner_x[u] * half, corner_y[u] * half, half) + center, color };
+                });
+        }
+    }
+    return {};
+}
+
+PrimitiveMesh::PrimitiveMesh(const MeshData& mesh, const ETopology topology)
+    : PrimitiveMesh(mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(), mesh.indices.size(), topology)
+{
+}
+
+PrimitiveMesh::PrimitiveMesh(const ColoredVertex* vertices, const size_t vertices_count,
+                             const GLuint* indices, const size_t indices_count, const ETopology topology)
+    : m_vertex_buffer(vertices, sizeof(ColoredVertex) * vertices_count, ColoredVertex::Layout::layout),
+      m_index_buffer(indices, indices_count),
+      m_topology(topology)
+{
+}
+
+std::shared_ptr<PrimitiveMesh> PrimitiveMesh::get_shared(const PrimitiveKey& key)
+{
+    auto it = s_shared_primitive_meshes.find(key);
+    if (it != s_shared_primitive_meshes.end())
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<PrimitiveMesh> mesh;
+    if (const BakedPrimitive* baked = find_baked_primitive(key))
+    {
+        mesh = std::make_shared<PrimitiveMesh>(baked->vertices, baked->vertices_count,
+                                               baked->indices, baked->indices_count, key.topology);
+    }
+    else
+    {
+        mesh = std::make_shared<PrimitiveMesh>(generate_primitive(key), key.topology);
+    }
+    s_shared_primitive_meshes.emplace(key, mesh);
+    return mesh;
+}
+
+void PrimitiveMesh::release_shared()
+{
+    s_shared_primitive_meshes.clear();
+}
+
+void PrimitiveMesh::draw(VertexArray& vao) const
+{
+    vao.bind_vertex_buffer(m_vertex_buffer);
+    vao.set_index_buffer(m_index_buffer);
+    vao.bind();
+    RenderBackend::get().draw_elements(m_topology == ETopology::Lines ? GL_LINES : GL_TRIANGLES,
+        static_cast<u32>(m_index_buffer.get_count()),
+        0,
+        1);
+    RenderStats::get().add_draw(m_topology == ETopology::Lines ? 0 : m_index_buffer.get_count() / 3);
+}
+
+}
@@ -0,0 +1,150 @@
+#ifndef PARAMETRIC_MESH_HPP
+#define PARAMETRIC_MESH_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Vertex.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/VertexBuffer.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/IndexBuffer.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/VertexArray.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <glad/glad.h>
+
+namespace SimpleEngine {
+
+enum class ETopology
+{
+    Lines,
+    Triangles
+};
+
+// A grid of u_segments x v_rows samples. Rows run along u and are stacked
+// along v; either direction can wrap around. Optional poles are single
+// vertices joined to every sample of the first (south) or last (north) row.
+struct SurfaceDesc
+{
+    u32 u_segments = 1;
+    u32 v_rows = 1;
+    bool u_closed = false;
+    bool v_closed = false;
+    bool south_pole = false;
+    bool north_pole = false;
+};
+
+constexpr size_t surface_u_edges(const SurfaceDesc& desc)
+{
+    return desc.u_closed ? desc.u_segments : desc.u_segments - 1;
+}
+
+constexpr size_t surface_v_edges(const SurfaceDesc& desc)
+{
+    return desc.v_closed ? desc.v_rows : desc.v_rows - 1;
+}
+
+constexpr size_t surface_poles_count(const SurfaceDesc& desc)
+{
+    return (desc.south_pole ? 1 : 0) + (desc.north_pole ? 1 : 0);
+}
+
+constexpr size_t surface_vertices_count(const SurfaceDesc& desc)
+{
+    return size_t(desc.u_segments) * desc.v_rows + surface_poles_count(desc);
+}
+
+constexpr size_t surface_indices_count(const SurfaceDesc& desc, const ETopology topology)
+{
+    if (topology == ETopology::Lines)
+    {
+        const size_t grid_lines = desc.v_rows * surface_u_edges(desc) + desc.u_segments * surface_v_edges(desc);
+        return 2 * (grid_lines + surface_poles_count(desc) * desc.u_segments);
+    }
+    const size_t grid_triangles = 2 * surface_u_edges(desc) * surface_v_edges(desc);
+    return 3 * (grid_triangles + surface_poles_count(desc) * surface_u_edges(desc));
+}
+
+struct MeshData
+{
+    std::vector<ColoredVertex> vertices;
+    std::vector<GLuint> indices;
+};
+
+// Sample at grid position (u, v); must be safe to call from several threads
+using SurfaceVertexFn = std::function<ColoredVertex(u32 u, u32 v)>;
+
+// Fills exactly surface_vertices_count/surface_indices_count elements. Large
+// grids are split by rows across worker threads.
+MeshData generate_surface(const SurfaceDesc& desc, const ETopology topology, const SurfaceVertexFn& vertex_fn,
+                          const ColoredVertex& south_pole = {}, const ColoredVertex& north_pole = {});
+
+enum class EPrimitive
+{
+    Torus,
+    Cone,
+    Cylinder,
+    Spiral,
+    Trapezoid
+};
+
+// Everything a built-in primitive's geometry depends on. The meaning of
+// params is per primitive, see make_*_key().
+struct PrimitiveKey
+{
+    EPrimitive primitive = EPrimitive::Torus;
+    ETopology topology = ETopology::Lines;
+    u32 u_segments = 0;
+    u32 v_rows = 0;
+    std::array<float, 3> params{};
+    glm::vec3 color{ 1.f };
+    glm::vec3 center{ 0.f };
+
+    bool operator==(const PrimitiveKey& other) const;
+};
+
+struct PrimitiveKeyHash
+{
+    size_t operator()(const PrimitiveKey& key) const;
+};
+
+PrimitiveKey make_torus_key(const float main_radius, const u32 main_segments, const float circle_radius, const u32 circle_segments,
+                            const glm::vec3& color, const glm::vec3& center, const ETopology topology = ETopology::Lines);
+PrimitiveKey make_cone_key(const float height, const float radius, const u32 segments,
+                           const glm::vec3& color, const glm::vec3& center, const ETopology topology = ETopology::Lines);
+PrimitiveKey make_cylinder_key(const float height, const float radius, const u32 segments,
+                               const glm::vec3& color, const glm::vec3& center, const ETopology topology = ETopology::Lines);
+// The helix's position gradient is tinted by color
+PrimitiveKey make_spiral_key(const u32 segments, const glm::vec3& color, const glm::vec3& center);
+PrimitiveKey make_trapezoid_key(const float up_length, const float down_length,
+                                const glm::vec3& color, const glm::vec3& center, const ETopology topology = ETopology::Lines);
+
+MeshData generate_primitive(const PrimitiveKey& key);
+
+// GPU buffers of a generated primitive. Identical keys share one instance;
+// keys matching a primitive baked at compile time skip generation entirely.
+class PrimitiveMesh
+{
+public:
+    explicit PrimitiveMesh(const MeshData& mesh, const ETopology topology);
+    PrimitiveMesh(const ColoredVertex* vertices, const size_t vertices_count,
+                  const GLuint* indices, const size_t indices_count, const ETopology topology);
+
+    static std::shared_ptr<PrimitiveMesh> get_shared(const PrimitiveKey& key);
+    static void release_shared();
+
+    // Attaches the buffers to the shared colored-vertex VAO and draws
+    void draw(VertexArray& vao) const;
+
+    const VertexBuffer& get_vertex_buffer() const { return m_vertex_buffer; }
+    const IndexBuffer& get_index_buffer() const { return m_index_buffer; }
+    ETopology get_topology() const { return m_topology; }
+
+private:
+    VertexBuffer m_vertex_buffer;
+    IndexBuffer m_index_buffer;
+    ETopology m_topology;
+};
+
+}
+
+#endif // PARAMETRIC_MESH_HPP
@@ -0,0 +1,11 @@
+#include "RenderStats.hpp"
+
+namespace SimpleEngine {
+
+RenderStats& RenderStats::get()
+{
+    static RenderStats stats;
+    return stats;
+}
+
+}
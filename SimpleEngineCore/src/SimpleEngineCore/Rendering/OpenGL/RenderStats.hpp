@@ -0,0 +1,26 @@
+#ifndef RENDER_STATS_HPP
+#define RENDER_STATS_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+namespace SimpleEngine {
+
+// Draw calls and triangles submitted since the last reset(); every renderer
+// adds what it issues, so the totals cover one frame when reset per frame
+struct RenderStats
+{
+    u64 draw_calls = 0;
+    u64 triangles = 0;
+
+    static RenderStats& get();
+
+    void add_draw(const u64 triangles_count, const u64 calls_count = 1)
+    {
+        draw_calls += calls_count;
+        triangles += triangles_count;
+    }
+    void reset() { *this = RenderStats(); }
+};
+
+}
+
+#endif // RENDER_STATS_HPP
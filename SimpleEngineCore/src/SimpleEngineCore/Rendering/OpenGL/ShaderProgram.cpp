@@ -1,110 +1,248 @@
 #include "ShaderProgram.hpp"
+#include "SimpleEngineCore/AssetReloader.hpp"
 #include "SimpleEngineCore/Log.hpp"
-#include <glad/glad.h>
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+// Set by the build to the source tree, so edited shaders reload in place
+#ifndef SIMPLE_ENGINE_SHADER_DIR
+#define SIMPLE_ENGINE_SHADER_DIR "shaders"
+#endif
+
+namespace fs = std::filesystem;
 
 namespace SimpleEngine {
 
-i32 ShaderProgram::get_uniform_location(const char* uniform) const
-{
-    return glGetUniformLocation(m_id, uniform);
-}
+static std::unordered_map<std::string, std::shared_ptr<ShaderProgram>> s_shared_programs;
 
-bool create_shader(const char* source, const GLenum shader_type, GLuint& shader_id)
+static bool read_source(const fs::path& path, std::string& source)
 {
-    shader_id = glCreateShader(shader_type);
-    glShaderSource(shader_id, 1, &source, nullptr);
-    glCompileShader(shader_id);
-
-    GLint success;
-    glGetShaderiv(shader_id, GL_COMPILE_STATUS, &success);
-    if(success == GL_FALSE)
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
     {
-        GLchar info_log[1024];
-        glGetShaderInfoLog(shader_id, 1024, nullptr, info_log);
-
-        LOG_CRITICAL("Shader compilation error:\n{0}", info_log);
         return false;
     }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    source = contents.str();
     return true;
 }
 
+i32 ShaderProgram::get_uniform_location(const char* uniform) const
+{
+    wait_first_build();
+    return RenderBackend::get().get_uniform_location(m_id, uniform);
+}
+
 ShaderProgram::ShaderProgram(const char* vertex_shader_src, const char* fragment_shader_src)
+    : m_pending_id(RenderBackend::get().begin_program(vertex_shader_src, fragment_shader_src))
+{
+}
+
+ShaderProgram::~ShaderProgram()
 {
-    GLuint vertex_shader_id = 0;
-    if(!create_shader(vertex_shader_src, GL_VERTEX_SHADER, vertex_shader_id))
+    if (m_id != 0)
     {
-        LOG_CRITICAL("VERTEX_SHADER: compile-time error!");
-        glDeleteShader(vertex_shader_id);
-        return;
+        RenderBackend::get().delete_program(m_id);
     }
-
-    GLuint fragment_shader_id = 0;
-    if(!create_shader(fragment_shader_src, GL_FRAGMENT_SHADER, fragment_shader_id))
+    if (m_pending_id != 0)
     {
-        LOG_CRITICAL("FRAGMENT SHADER: compile-time error!");
-        glDeleteShader(vertex_shader_id);
-        glDeleteShader(fragment_shader_id);
-        return;
+        RenderBackend::get().delete_program(m_pending_id);
     }
+}
 
-    m_id = glCreateProgram();
-    glAttachShader(m_id, vertex_shader_id);
-    glAttachShader(m_id, fragment_shader_id);
-    glLinkProgram(m_id);
+void ShaderProgram::bind() const
+{
+    wait_first_build();
+    RenderBackend::get().use_program(m_id);
+}
+
+void ShaderProgram::unbind()
+{
+    RenderBackend::get().use_program(0);
+}
 
-    GLint success;
-    glGetProgramiv(m_id, GL_LINK_STATUS, &success);
-    if(success == GL_FALSE)
+bool ShaderProgram::isCompiled() const
+{
+    wait_first_build();
+    return m_id != 0;
+}
+
+void ShaderProgram::recompile(const std::string& vertex_shader_src, const std::string& fragment_shader_src)
+{
+    if (m_pending_id != 0)
     {
-        GLchar info_log[1024];
-        glGetProgramInfoLog(m_id, 1024, nullptr, info_log);
-        LOG_CRITICAL("SHADER PROGRAM: Link-time error:\n{0}", info_log);
-        glDeleteProgram(m_id);
-        m_id = 0;
-        glDeleteShader(vertex_shader_id);
-        glDeleteShader(fragment_shader_id);
-        return;
+        // Superseded before it finished
+        RenderBackend::get().delete_program(m_pending_id);
     }
-    m_isCompiled = true;
+    m_pending_id = RenderBackend::get().begin_program(vertex_shader_src.c_str(), fragment_shader_src.c_str());
+}
 
-    glDetachShader(m_id, vertex_shader_id);
-    glDetachShader(m_id, fragment_shader_id);
-    glDeleteShader(vertex_shader_id);
-    glDeleteShader(fragment_shader_id);
+bool ShaderProgram::update()
+{
+    if (m_pending_id == 0 || !RenderBackend::get().is_program_ready(m_pending_id))
+    {
+        return false;
+    }
+    const u32 generation = m_generation;
+    finish_build();
+    return m_generation != generation;
 }
 
-ShaderProgram::~ShaderProgram()
+bool ShaderProgram::is_relinked(u32& generation) const
 {
-    glDeleteProgram(m_id);
+    wait_first_build();
+    if (generation == m_generation)
+    {
+        return false;
+    }
+    generation = m_generation;
+    return true;
 }
 
-void ShaderProgram::bind() const
+void ShaderProgram::wait_first_build() const
 {
-    glUseProgram(m_id);
+    if (m_id == 0 && m_pending_id != 0)
+    {
+        finish_build();
+    }
 }
 
-void ShaderProgram::unbind()
+void ShaderProgram::finish_build() const
 {
-    glUseProgram(0);
+    std::string error_log;
+    RenderBackend& backend = RenderBackend::get();
+    if (!backend.finish_program(m_pending_id, error_log))
+    {
+        backend.delete_program(m_pending_id);
+        m_pending_id = 0;
+        if (m_id == 0)
+        {
+            LOG_CRITICAL("Shader program '{0}' build error:\n{1}", m_name, error_log);
+        }
+        else
+        {
+            LOG_ERROR("Shader program '{0}' build error, keeping the previous one:\n{1}", m_name, error_log);
+        }
+        return;
+    }
+
+    if (m_id != 0)
+    {
+        backend.delete_program(m_id);
+        LOG_INFO("Shader program '{0}' relinked", m_name);
+    }
+    m_id = m_pending_id;
+    m_pending_id = 0;
+    ++m_generation;
 }
 
 ShaderProgram& ShaderProgram::operator=(ShaderProgram&& shaderProgram) noexcept
 {
-    glDeleteProgram(m_id);
+    if (m_id != 0)
+    {
+        RenderBackend::get().delete_program(m_id);
+    }
+    if (m_pending_id != 0)
+    {
+        RenderBackend::get().delete_program(m_pending_id);
+    }
+    m_name = std::move(shaderProgram.m_name);
     m_id = shaderProgram.m_id;
-    m_isCompiled = shaderProgram.m_isCompiled;
+    m_pending_id = shaderProgram.m_pending_id;
+    // Whoever tracked either program has to look its uniforms up again
+    m_generation = std::max(m_generation, shaderProgram.m_generation) + 1;
 
     shaderProgram.m_id = 0;
-    shaderProgram.m_isCompiled = false;
+    shaderProgram.m_pending_id = 0;
     return *this;
 }
 
 ShaderProgram::ShaderProgram(ShaderProgram&& shaderProgram) noexcept
-    : m_id(shaderProgram.m_id),
-      m_isCompiled(shaderProgram.m_isCompiled)
+    : m_name(std::move(shaderProgram.m_name)),
+      m_id(shaderProgram.m_id),
+      m_pending_id(shaderProgram.m_pending_id),
+      m_generation(shaderProgram.m_generation)
 {
     shaderProgram.m_id = 0;
-    shaderProgram.m_isCompiled = false;
+    shaderProgram.m_pending_id = 0;
+}
+
+const fs::path& ShaderProgram::get_shared_directory()
+{
+    static const fs::path directory = fs::path(SIMPLE_ENGINE_SHADER_DIR).lexically_normal();
+    return directory;
+}
+
+std::shared_ptr<ShaderProgram> ShaderProgram::get_shared(const std::string& name)
+{
+    auto it = s_shared_programs.find(name);
+    if (it != s_shared_programs.end())
+    {
+        return it->second;
+    }
+
+    const fs::path directory = get_shared_directory();
+    std::string vertex_shader_src;
+    std::string fragment_shader_src;
+    if (!read_source(directory / (name + ".vert"), vertex_shader_src)
+        || !read_source(directory / (name + ".frag"), fragment_shader_src))
+    {
+        // Still built, so the failure reads like any other build error
+        LOG_CRITICAL("Shader program '{0}': can't read its sources in '{1}'", name, directory.string());
+    }
+
+    auto program = std::make_shared<ShaderProgram>(vertex_shader_src.c_str(), fragment_shader_src.c_str());
+    program->m_name = name;
+    s_shared_programs.emplace(name, program);
+    return program;
+}
+
+void ShaderProgram::watch_shared(AssetReloader& reloader)
+{
+    const fs::path directory = get_shared_directory();
+    for (const auto& [name, program] : s_shared_programs)
+    {
+        const fs::path vertex_path = directory / (name + ".vert");
+        const fs::path fragment_path = directory / (name + ".frag");
+        // Either file changing rebuilds from both; the files are read on the
+        // reloader's thread and compiling starts at apply time
+        const auto import = [vertex_path, fragment_path, weak_program = std::weak_ptr<ShaderProgram>(program)]() -> AssetReloader::ApplyFn
+        {
+            std::string vertex_shader_src;
+            std::string fragment_shader_src;
+            if (!read_source(vertex_path, vertex_shader_src) || !read_source(fragment_path, fragment_shader_src))
+            {
+                return {};
+            }
+            return [weak_program, vertex_shader_src = std::move(vertex_shader_src), fragment_shader_src = std::move(fragment_shader_src)]()
+            {
+                if (const std::shared_ptr<ShaderProgram> shader_program = weak_program.lock())
+                {
+                    shader_program->recompile(vertex_shader_src, fragment_shader_src);
+                }
+            };
+        };
+        reloader.watch(vertex_path, import);
+        reloader.watch(fragment_path, import);
+    }
+}
+
+void ShaderProgram::update_shared()
+{
+    for (auto& [name, program] : s_shared_programs)
+    {
+        program->update();
+    }
+}
+
+void ShaderProgram::release_shared()
+{
+    s_shared_programs.clear();
 }
 
 }
@@ -2,8 +2,19 @@
 #define SHADER_PROGRAM_HPP
 #include "SimpleEngineCore/Types.hpp"
 
+#include <filesystem>
+#include <memory>
+#include <string>
+
 namespace SimpleEngine {
 
+class AssetReloader;
+
+// Building a program never waits for the driver: the sources are handed over
+// at construction and the result is only collected when the program is first
+// used, so programs created together compile at the same time. recompile()
+// builds new sources next to the program in use, which keeps drawing until
+// update() finds the new one linked; a failed build keeps the old program.
 class ShaderProgram
 {
 public:
@@ -15,7 +26,8 @@ public:
 
     void bind() const;
     static void unbind();
-    bool isCompiled() const { return m_isCompiled; }
+    // Waits for the first build
+    bool isCompiled() const;
 
     ShaderProgram() = delete;
     ShaderProgram(const ShaderProgram&) = delete;
@@ -23,9 +35,33 @@ public:
 
     i32 get_uniform_location(const char* uniform) const;
 
+    void recompile(const std::string& vertex_shader_src, const std::string& fragment_shader_src);
+    // Never blocks; true when another program was swapped in
+    bool update();
+    // Uniform locations, and values set on the previous program, don't carry
+    // over to the one swapped in: true once after each swap, including the
+    // first build, so the caller looks them up again.
+    bool is_relinked(u32& generation) const;
+
+    // Built from <name>.vert and <name>.frag in the shader directory; one
+    // program per name, shared by everything drawing with it
+    static std::shared_ptr<ShaderProgram> get_shared(const std::string& name);
+    static const std::filesystem::path& get_shared_directory();
+    // Recompiles the shared programs created so far when their files change
+    static void watch_shared(AssetReloader& reloader);
+    // Once per frame on the thread owning the GL context
+    static void update_shared();
+    static void release_shared();
+
 private:
-    bool m_isCompiled = false;
-    u32 m_id = 0;
+    void wait_first_build() const;
+    void finish_build() const;
+
+    std::string m_name = "unnamed";
+    // Built lazily from const accessors
+    mutable u32 m_id = 0;
+    mutable u32 m_pending_id = 0;
+    mutable u32 m_generation = 0;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "SimpleEngineCore/Rendering/OpenGL/VertexBuffer.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/IndexBuffer.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/VertexArray.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ParametricMesh.hpp"
 
 #include <memory>
 #include <vector>
@@ -26,16 +27,15 @@ public:
 	const VertexArray& getVertexArray() const { return *m_p_vao; }
 	const ShaderProgram& getShaderProgram() const { return *m_p_shader_program; }
 private:
-	void generate(const glm::vec3& color, const glm::vec3& center);
-	std::vector<GLfloat> positionsColors;
-	std::vector<GLuint> indices;
+	void bind_shader();
 
 	float rotAngle = 0;
-	i32 rotationUniformLoc;
-	std::unique_ptr<ShaderProgram> m_p_shader_program;
-	std::unique_ptr<VertexArray> m_p_vao;
-	std::unique_ptr<VertexBuffer> m_p_positions_colors_vbo;
-	std::unique_ptr<IndexBuffer> m_p_index_buffer;
+	i32 rotationUniformLoc = -1;
+	std::shared_ptr<ShaderProgram> m_p_shader_program;
+	u32 m_shader_generation = 0;
+	glm::mat4 m_rotation_matrix{ 1.f };
+	VertexArray* m_p_vao = nullptr;
+	std::shared_ptr<PrimitiveMesh> m_p_mesh;
 };
 
 }
@@ -0,0 +1,85 @@
+#include "StorageBuffer.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+#include <algorithm>
+
+namespace SimpleEngine {
+
+GLenum target_to_GLenum(const StorageBuffer::ETarget target)
+{
+    switch (target)
+    {
+    case SimpleEngine::StorageBuffer::ETarget::ShaderStorage:
+        return GL_SHADER_STORAGE_BUFFER;
+    case SimpleEngine::StorageBuffer::ETarget::DrawIndirect:
+        return GL_DRAW_INDIRECT_BUFFER;
+    }
+
+    LOG_ERROR("Unknown StorageBuffer target");
+    return GL_SHADER_STORAGE_BUFFER;
+}
+
+StorageBuffer::StorageBuffer(const ETarget target, const size_t size, const VertexBuffer::EUsage usage)
+    : m_target(target_to_GLenum(target)),
+      m_size(size),
+      m_usage(usage)
+{
+    m_id = RenderBackend::get().create_buffer(m_target, size, nullptr, usage_to_GLenum(usage));
+}
+
+StorageBuffer::~StorageBuffer()
+{
+    if (m_id != 0)
+    {
+        RenderBackend::get().delete_buffer(m_id);
+    }
+}
+
+StorageBuffer& StorageBuffer::operator=(StorageBuffer&& storage_buffer) noexcept
+{
+    if (m_id != 0)
+    {
+        RenderBackend::get().delete_buffer(m_id);
+    }
+    m_id = storage_buffer.m_id;
+    m_target = storage_buffer.m_target;
+    m_size = storage_buffer.m_size;
+    m_usage = storage_buffer.m_usage;
+    storage_buffer.m_id = 0;
+    storage_buffer.m_size = 0;
+    return *this;
+}
+
+StorageBuffer::StorageBuffer(StorageBuffer&& storage_buffer) noexcept
+    : m_id(storage_buffer.m_id),
+      m_target(storage_buffer.m_target),
+      m_size(storage_buffer.m_size),
+      m_usage(storage_buffer.m_usage)
+{
+    storage_buffer.m_id = 0;
+    storage_buffer.m_size = 0;
+}
+
+void StorageBuffer::bind() const
+{
+    RenderBackend::get().bind_buffer(m_target, m_id);
+}
+
+void StorageBuffer::bind_base(const u32 binding) const
+{
+    RenderBackend::get().bind_buffer_base(m_target, binding, m_id);
+}
+
+void StorageBuffer::update_buffer(const void* data, const size_t size, const size_t offset)
+{
+    RenderBackend& backend = RenderBackend::get();
+    if (offset + size > m_size)
+    {
+        // Grow geometrically; the old contents are not preserved
+        m_size = std::max(offset + size, m_size * 2);
+        backend.buffer_data(m_target, m_id, m_size, nullptr, usage_to_GLenum(m_usage));
+    }
+    backend.buffer_sub_data(m_target, m_id, offset, size, data);
+}
+
+}
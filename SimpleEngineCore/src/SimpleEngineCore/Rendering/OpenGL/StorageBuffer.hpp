@@ -0,0 +1,40 @@
+#ifndef STORAGE_BUFFER_HPP
+#define STORAGE_BUFFER_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "VertexBuffer.hpp"
+
+namespace SimpleEngine {
+
+// Untyped GPU buffer used for shader storage blocks and indirect draw commands
+class StorageBuffer
+{
+public:
+    enum class ETarget
+    {
+        ShaderStorage,
+        DrawIndirect
+    };
+
+    StorageBuffer(const ETarget target, const size_t size, const VertexBuffer::EUsage usage = VertexBuffer::EUsage::Dynamic);
+    ~StorageBuffer();
+
+    StorageBuffer(const StorageBuffer&) = delete;
+    StorageBuffer& operator=(const StorageBuffer&) = delete;
+    StorageBuffer(StorageBuffer&& storage_buffer) noexcept;
+    StorageBuffer& operator=(StorageBuffer&& storage_buffer) noexcept;
+
+    void bind() const;
+    void bind_base(const u32 binding) const;
+    void update_buffer(const void* data, const size_t size, const size_t offset = 0);
+    size_t get_size() const { return m_size; }
+
+private:
+    u32 m_id = 0;
+    u32 m_target = 0;
+    size_t m_size = 0;
+    VertexBuffer::EUsage m_usage;
+};
+
+}
+
+#endif // STORAGE_BUFFER_HPP
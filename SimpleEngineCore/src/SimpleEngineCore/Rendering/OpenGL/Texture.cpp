@@ -1,47 +1,208 @@
 #include "Texture.hpp"
+#include "TextureCompression.hpp"
+#include "MipChain.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_ONLY_PNG
 #include "../SimpleEngineCore/src/SimpleEngineCore/stb_image.h"
+
+#include <algorithm>
+
+// S3TC is an extension, glad only loads the core profile
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace SimpleEngine
 {
 
+GLenum block_format_to_GLenum(const EBlockFormat format)
+{
+    switch (format)
+    {
+        case EBlockFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case EBlockFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case EBlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+    }
+    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+}
+
+std::string compressed_texture_path(const char* image)
+{
+    std::string path(image);
+    const size_t dot = path.find_last_of('.');
+    const size_t slash = path.find_last_of("/\\");
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    {
+        path.erase(dot);
+    }
+    return path + ".ctex";
+}
+
+bool load_texture_source(const char* image, TextureSource& source)
+{
+    PROFILE_SCOPE("load_texture_source");
+    CompressedTexture compressed;
+    if (read_compressed_texture(compressed_texture_path(image).c_str(), compressed) && !compressed.levels.empty())
+    {
+        source.compressed = true;
+        source.format = compressed.format;
+        for (CompressedLevel& level : compressed.levels)
+        {
+            source.levels.push_back({ level.width, level.height, std::move(level.blocks) });
+        }
+        return true;
+    }
+
+    Image base;
+    if (!load_image_rgba(image, base))
+    {
+        return false;
+    }
+    // Built on the CPU with sRGB-correct filtering instead of glGenerateMipmap
+    std::vector<Image> mips = generate_mip_chain(base);
+    source.compressed = false;
+    source.levels.push_back({ base.width, base.height, std::move(base.rgba) });
+    for (Image& mip : mips)
+    {
+        source.levels.push_back({ mip.width, mip.height, std::move(mip.rgba) });
+    }
+    return true;
+}
+
+u32 first_level_within(const u32 width, const u32 height, const u32 size)
+{
+    u32 level = 0;
+    while ((width >> level) > size || (height >> level) > size)
+    {
+        ++level;
+    }
+    return level;
+}
+
 Texture::Texture(const char* image, GLenum texType, GLenum slot, GLenum pixelType)
+    : m_type(texType),
+      m_pixel_type(pixelType)
 {
-    m_type = texType;
-    int widthImg, heightImg, numColCh;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* bytes = stbi_load(image, &widthImg, &heightImg, &numColCh, 0);
+    TextureSource source;
+    if (!load_texture_source(image, source))
+    {
+        source.levels.push_back({ 1, 1, { 255, 0, 255, 255 } });
+    }
+    RenderBackend::get().active_texture(slot - GL_TEXTURE0);
+    set_source(std::move(source));
+}
 
-    glGenTextures(1, &m_ID);
-    glActiveTexture(slot);
-    glBindTexture(texType, m_ID);
+void Texture::set_source(TextureSource source)
+{
+    // Nothing of the old contents may be copied over by make_resident()
+    stop_streaming();
+    if (m_ID != 0)
+    {
+        RenderBackend::get().delete_texture(m_ID);
+        m_ID = 0;
+    }
+
+    m_source = std::move(source);
+    m_internal_format = m_source.compressed ? block_format_to_GLenum(m_source.format) : GL_RGBA8;
+    const u32 levels_count = static_cast<u32>(m_source.levels.size());
+    start_streaming(get_width(), levels_count,
+                    first_level_within(get_width(), get_height(), TextureStreamer::get().get_settings().resident_size));
+}
+
+u32 Texture::get_width() const
+{
+    return m_source.levels.front().width;
+}
+
+u32 Texture::get_height() const
+{
+    return m_source.levels.front().height;
+}
+
+size_t Texture::get_level_size(const u32 level) const
+{
+    const TextureLevelData& data = m_source.levels[level];
+    return m_source.compressed ? data.data.size() : size_t(data.width) * data.height * 4;
+}
 
-    glTexParameteri(texType, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(texType, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+void Texture::make_resident(const u32 level)
+{
+    // Immutable storage for exactly the resident levels; the levels both
+    // textures share are copied on the GPU, the rest come from m_source
+    RenderBackend& backend = RenderBackend::get();
+    const u32 levels_count = static_cast<u32>(m_source.levels.size());
+    const u32 texture = backend.create_texture(m_type, levels_count - level, m_internal_format,
+                                               m_source.levels[level].width, m_source.levels[level].height, 1);
+
+    // Every level is uploaded, so minification samples the mip chain
+    backend.texture_parameter(m_type, texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    backend.texture_parameter(m_type, texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-    glTexParameteri(texType, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(texType, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    backend.texture_parameter(m_type, texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    backend.texture_parameter(m_type, texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-    GLenum mode = numColCh == 3 ? GL_RGB : GL_RGBA;
-    glTexImage2D(texType, 0, mode, widthImg, heightImg, 0, mode, pixelType, bytes);
-    glGenerateMipmap(texType);
-    stbi_image_free(bytes);
-    glBindTexture(texType, 0);
+    const u32 copied_from = m_ID != 0 ? std::max(level, m_resident_level) : levels_count;
+    for (u32 current = level; current < copied_from; ++current)
+    {
+        const TextureLevelData& data = m_source.levels[current];
+        TextureRegion region;
+        region.type = m_type;
+        region.texture = texture;
+        region.level = static_cast<i32>(current - level);
+        region.width = data.width;
+        region.height = data.height;
+        if (m_source.compressed)
+        {
+            backend.texture_sub_image(region, m_internal_format, 0, data.data.size(), data.data.data());
+        }
+        else
+        {
+            backend.texture_sub_image(region, GL_RGBA, m_pixel_type, data.data.size(), data.data.data());
+        }
+    }
+    for (u32 current = copied_from; current < levels_count; ++current)
+    {
+        const TextureLevelData& data = m_source.levels[current];
+        TextureRegion source;
+        source.type = m_type;
+        source.texture = m_ID;
+        source.level = static_cast<i32>(current - m_resident_level);
+        source.width = data.width;
+        source.height = data.height;
+        TextureRegion target = source;
+        target.texture = texture;
+        target.level = static_cast<i32>(current - level);
+        backend.copy_texture_region(source, target);
+    }
+
+    if (m_ID != 0)
+    {
+        backend.delete_texture(m_ID);
+    }
+    m_ID = texture;
 }
 
 Texture::~Texture()
 {
-    glDeleteTextures(1, &m_ID);
+    if (m_ID != 0)
+    {
+        RenderBackend::get().delete_texture(m_ID);
+    }
 }
 
 void Texture::bind() const
 {
-    glBindTexture(m_type, m_ID);
+    RenderBackend::get().bind_texture(m_type, m_ID);
 }
 
 void Texture::unbind() const
 {
-    glBindTexture(m_type, 0);
+    RenderBackend::get().bind_texture(m_type, 0);
 }
 
-}
\ No newline at end of file
+}
@@ -1,12 +1,49 @@
 #ifndef TEXTURE_HPP
 #define TEXTURE_HPP
 
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureStreamer.hpp"
+
+#include <string>
+#include <vector>
 #include <glad/glad.h>
 
 namespace SimpleEngine
 {
 
-class Texture
+enum class EBlockFormat : u32;
+
+// CPU copy of one mip level: RGBA8 texels or compressed blocks
+struct TextureLevelData
+{
+    u32 width = 0;
+    u32 height = 0;
+    std::vector<u8> data;
+};
+
+// Every mip of a texture as it is uploaded
+struct TextureSource
+{
+    bool compressed = false;
+    EBlockFormat format{};
+    std::vector<TextureLevelData> levels;
+};
+
+// Reads the cooked ".ctex" next to `image` when there is one, otherwise the
+// PNG with a mip chain built on the CPU
+bool load_texture_source(const char* image, TextureSource& source);
+
+// First level no larger than `size` texels on either side
+u32 first_level_within(const u32 width, const u32 height, const u32 size);
+
+GLenum block_format_to_GLenum(const EBlockFormat format);
+
+// "textures/foo.png" -> "textures/foo.ctex", written by SimpleEngineTextureCooker
+std::string compressed_texture_path(const char* image);
+
+// Loads a PNG, or the block-compressed ".ctex" next to it when one has been cooked.
+// Only the small mips are uploaded at first, TextureStreamer brings in the rest.
+class Texture : public StreamedTexture
 {
 public:
     Texture(const char* image,
@@ -19,13 +56,27 @@ public:
     Texture& operator=(const Texture&) = delete;
     Texture& operator=(Texture&& texture) = delete;
     Texture(Texture&& texture) = delete;
-    ~Texture();
+    ~Texture() override;
 
     void bind() const;
     void unbind() const;
+
+    u32 get_width() const;
+    u32 get_height() const;
+
+    // New contents, e.g. the image reloaded; streams in again from the coarse levels
+    void set_source(TextureSource source);
+
+protected:
+    void make_resident(const u32 level) override;
+    size_t get_level_size(const u32 level) const override;
+
 private:
-    GLuint m_ID;
+    GLuint m_ID = 0;
     GLenum m_type;
+    GLenum m_pixel_type;
+    GLenum m_internal_format = GL_RGBA8;
+    TextureSource m_source;
 };
 
 }
@@ -0,0 +1,376 @@
+#include "TextureArray.hpp"
+#include "Texture.hpp"
+#include "TextureCompression.hpp"
+#include "MipChain.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace SimpleEngine {
+
+namespace {
+
+struct Rect
+{
+    u32 x = 0;
+    u32 y = 0;
+    u32 width = 0;
+    u32 height = 0;
+
+    bool overlaps(const Rect& other) const
+    {
+        return x < other.x + other.width && other.x < x + width
+            && y < other.y + other.height && other.y < y + height;
+    }
+};
+
+// Layer being filled by packed textures; whole-layer textures never share
+struct PackedLayer
+{
+    u32 layer = 0;
+    std::vector<Rect> used;
+};
+
+}
+
+// Textures with equal keys can share an array
+static u32 format_key(const TextureSource& source)
+{
+    return source.compressed ? static_cast<u32>(source.format) : 0;
+}
+
+static u32 next_power_of_two(const u32 value)
+{
+    u32 result = 1;
+    while (result < value)
+    {
+        result *= 2;
+    }
+    return result;
+}
+
+// Levels of `source` that fit inside `reserved` once scaled down. Block
+// formats also need every level to start on a 4x4 block and to cover whole
+// blocks, unless it ends at the layer edge.
+static u32 copyable_levels(const TextureSource& source, const Rect& reserved, const bool whole_layer,
+                           const u32 layer_width, const u32 layer_height, const u32 array_levels)
+{
+    const u32 levels = std::min(static_cast<u32>(source.levels.size()), array_levels);
+    for (u32 level = 0; level < levels; ++level)
+    {
+        const TextureLevelData& current = source.levels[level];
+        const u32 scale = 1u << level;
+        const u32 reserved_width = whole_layer ? std::max(1u, reserved.width >> level) : reserved.width >> level;
+        const u32 reserved_height = whole_layer ? std::max(1u, reserved.height >> level) : reserved.height >> level;
+        if (reserved.x % scale != 0 || reserved.y % scale != 0
+            || current.width > reserved_width || current.height > reserved_height)
+        {
+            return level;
+        }
+
+        if (source.compressed)
+        {
+            const u32 x = reserved.x >> level;
+            const u32 y = reserved.y >> level;
+            const bool width_ok = current.width % 4 == 0 || x + current.width == std::max(1u, layer_width >> level);
+            const bool height_ok = current.height % 4 == 0 || y + current.height == std::max(1u, layer_height >> level);
+            if (x % 4 != 0 || y % 4 != 0 || !width_ok || !height_ok)
+            {
+                return level;
+            }
+        }
+    }
+    return levels;
+}
+
+TextureArray::TextureArray(const GLenum internal_format, const u32 width, const u32 height, const u32 layers_count,
+                           std::vector<TextureArrayPiece> pieces)
+    : m_internal_format(internal_format),
+      m_compressed(internal_format != GL_RGBA8),
+      m_width(width),
+      m_height(height),
+      m_layers_count(layers_count),
+      m_pieces(std::move(pieces))
+{
+    // Every piece must still be there at the coarsest resident level
+    const u32 levels_count = mip_levels_count(width, height);
+    u32 coarsest_level = first_level_within(width, height, TextureStreamer::get().get_settings().resident_size);
+    for (const TextureArrayPiece& piece : m_pieces)
+    {
+        coarsest_level = std::min(coarsest_level, static_cast<u32>(std::max<size_t>(piece.levels.size(), 1) - 1));
+    }
+    start_streaming(width, levels_count, coarsest_level);
+}
+
+TextureArray::~TextureArray()
+{
+    if (m_ID != 0)
+    {
+        RenderBackend::get().delete_texture(m_ID);
+    }
+}
+
+size_t TextureArray::get_level_size(const u32 level) const
+{
+    const u32 width = std::max(1u, m_width >> level);
+    const u32 height = std::max(1u, m_height >> level);
+    const size_t layer_size = m_compressed
+        ? size_t((width + 3) / 4) * ((height + 3) / 4) * (m_internal_format == block_format_to_GLenum(EBlockFormat::BC1) ? 8 : 16)
+        : size_t(width) * height * 4;
+    return layer_size * m_layers_count;
+}
+
+void TextureArray::make_resident(const u32 level)
+{
+    RenderBackend& backend = RenderBackend::get();
+    const u32 levels_count = get_levels_count();
+    const u32 texture = backend.create_texture(GL_TEXTURE_2D_ARRAY, levels_count - level, m_internal_format,
+                                               std::max(1u, m_width >> level), std::max(1u, m_height >> level), m_layers_count);
+
+    backend.texture_parameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    backend.texture_parameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    backend.texture_parameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    backend.texture_parameter(GL_TEXTURE_2D_ARRAY, texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    // Levels both storages have are copied on the GPU, the others come from the pieces
+    const u32 copied_from = m_ID != 0 ? std::max(level, m_resident_level) : levels_count;
+    for (const TextureArrayPiece& piece : m_pieces)
+    {
+        upload_piece(texture, piece, level, level, copied_from);
+    }
+    for (u32 current = copied_from; current < levels_count; ++current)
+    {
+        TextureRegion source;
+        source.type = GL_TEXTURE_2D_ARRAY;
+        source.texture = m_ID;
+        source.level = static_cast<i32>(current - m_resident_level);
+        source.width = std::max(1u, m_width >> current);
+        source.height = std::max(1u, m_height >> current);
+        source.depth = m_layers_count;
+        TextureRegion target = source;
+        target.texture = texture;
+        target.level = static_cast<i32>(current - level);
+        backend.copy_texture_region(source, target);
+    }
+
+    if (m_ID != 0)
+    {
+        backend.delete_texture(m_ID);
+    }
+    m_ID = texture;
+}
+
+void TextureArray::upload_piece(const u32 texture, const TextureArrayPiece& piece, const u32 base_level,
+                                const u32 first_level, const u32 last_level) const
+{
+    RenderBackend& backend = RenderBackend::get();
+    const u32 uploaded_to = std::min(last_level, static_cast<u32>(piece.levels.size()));
+    for (u32 current = first_level; current < uploaded_to; ++current)
+    {
+        const TextureLevelData& data = piece.levels[current];
+        TextureRegion region;
+        region.type = GL_TEXTURE_2D_ARRAY;
+        region.texture = texture;
+        region.level = static_cast<i32>(current - base_level);
+        region.x = piece.x >> current;
+        region.y = piece.y >> current;
+        region.z = piece.layer;
+        region.width = data.width;
+        region.height = data.height;
+        if (m_compressed)
+        {
+            backend.texture_sub_image(region, m_internal_format, 0, data.data.size(), data.data.data());
+        }
+        else
+        {
+            backend.texture_sub_image(region, GL_RGBA, GL_UNSIGNED_BYTE, data.data.size(), data.data.data());
+        }
+    }
+}
+
+bool TextureArray::replace_piece(const size_t index, std::vector<TextureLevelData> levels)
+{
+    TextureArrayPiece& piece = m_pieces[index];
+    if (levels.size() < piece.levels.size())
+    {
+        return false;
+    }
+    levels.resize(piece.levels.size());
+    piece.levels = std::move(levels);
+    upload_piece(m_ID, piece, m_resident_level, m_resident_level, get_levels_count());
+    return true;
+}
+
+void TextureArray::bind() const
+{
+    RenderBackend::get().bind_texture(GL_TEXTURE_2D_ARRAY, m_ID);
+}
+
+void TextureArray::unbind() const
+{
+    RenderBackend::get().bind_texture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+TextureAtlas::TextureAtlas(const std::vector<std::string>& image_paths)
+{
+    PROFILE_SCOPE("TextureAtlas build");
+    // Repeated paths are loaded once
+    std::vector<TextureSource> sources;
+    std::vector<size_t> source_of_path(image_paths.size());
+    std::unordered_map<std::string, size_t> source_indices;
+    for (size_t i = 0; i < image_paths.size(); ++i)
+    {
+        const auto [it, inserted] = source_indices.emplace(image_paths[i], sources.size());
+        if (inserted)
+        {
+            sources.emplace_back();
+            if (!load_texture_source(image_paths[i].c_str(), sources.back()))
+            {
+                LOG_ERROR("TextureAtlas: failed to load '{0}'", image_paths[i]);
+                sources.back().levels.push_back({ 1, 1, { 255, 0, 255, 255 } });
+            }
+        }
+        source_of_path[i] = it->second;
+    }
+
+    std::vector<TextureSlot> source_slots(sources.size());
+    m_sources.resize(sources.size());
+    for (const auto& [path, index] : source_indices)
+    {
+        m_sources[index].path = path;
+    }
+    std::vector<bool> grouped(sources.size(), false);
+    for (size_t first = 0; first < sources.size(); ++first)
+    {
+        if (grouped[first])
+        {
+            continue;
+        }
+
+        std::vector<size_t> group;
+        u32 layer_width = 0;
+        u32 layer_height = 0;
+        for (size_t i = first; i < sources.size(); ++i)
+        {
+            if (!grouped[i] && format_key(sources[i]) == format_key(sources[first]))
+            {
+                grouped[i] = true;
+                group.push_back(i);
+                layer_width = std::max(layer_width, sources[i].levels.front().width);
+                layer_height = std::max(layer_height, sources[i].levels.front().height);
+            }
+        }
+
+        // Largest first so the small textures fill the gaps
+        std::stable_sort(group.begin(), group.end(), [&](const size_t left, const size_t right)
+        {
+            const TextureLevelData& left_base = sources[left].levels.front();
+            const TextureLevelData& right_base = sources[right].levels.front();
+            return u64(left_base.width) * left_base.height > u64(right_base.width) * right_base.height;
+        });
+
+        const u32 array_index = static_cast<u32>(m_arrays.size());
+        const u32 array_levels = mip_levels_count(layer_width, layer_height);
+        std::vector<PackedLayer> packed_layers;
+        std::vector<Rect> reserved(sources.size());
+        std::vector<bool> whole_layer(sources.size(), false);
+        u32 layers_count = 0;
+        for (const size_t index : group)
+        {
+            const TextureLevelData& base = sources[index].levels.front();
+            const Rect slot_rect{ 0, 0, next_power_of_two(base.width), next_power_of_two(base.height) };
+            TextureSlot& slot = source_slots[index];
+            slot.array = array_index;
+
+            if ((base.width == layer_width && base.height == layer_height)
+                || slot_rect.width > layer_width || slot_rect.height > layer_height)
+            {
+                slot.layer = layers_count++;
+                reserved[index] = { 0, 0, layer_width, layer_height };
+                whole_layer[index] = true;
+                continue;
+            }
+
+            // First position aligned to the slot size that is free in any packed layer
+            bool placed = false;
+            for (PackedLayer& layer : packed_layers)
+            {
+                for (u32 y = 0; !placed && y + slot_rect.height <= layer_height; y += slot_rect.height)
+                {
+                    for (u32 x = 0; !placed && x + slot_rect.width <= layer_width; x += slot_rect.width)
+                    {
+                        const Rect candidate{ x, y, slot_rect.width, slot_rect.height };
+                        if (std::none_of(layer.used.begin(), layer.used.end(), [&](const Rect& used) { return used.overlaps(candidate); }))
+                        {
+                            layer.used.push_back(candidate);
+                            reserved[index] = candidate;
+                            slot.layer = layer.layer;
+                            placed = true;
+                        }
+                    }
+                }
+                if (placed)
+                {
+                    break;
+                }
+            }
+            if (!placed)
+            {
+                packed_layers.push_back({ layers_count++, { slot_rect } });
+                reserved[index] = slot_rect;
+                slot.layer = packed_layers.back().layer;
+            }
+        }
+
+        std::vector<TextureArrayPiece> pieces;
+        for (const size_t index : group)
+        {
+            TextureSource& source = sources[index];
+            PackedSource& packed = m_sources[index];
+            packed.array = array_index;
+            packed.piece = static_cast<u32>(pieces.size());
+            packed.width = source.levels.front().width;
+            packed.height = source.levels.front().height;
+            packed.format_key = format_key(source);
+            const Rect& rect = reserved[index];
+            TextureSlot& slot = source_slots[index];
+            const u32 levels = copyable_levels(source, rect, whole_layer[index], layer_width, layer_height, array_levels);
+            slot.uv_rect = glm::vec4(static_cast<float>(rect.x) / layer_width, static_cast<float>(rect.y) / layer_height,
+                                     static_cast<float>(source.levels.front().width) / layer_width,
+                                     static_cast<float>(source.levels.front().height) / layer_height);
+            slot.max_lod = static_cast<float>(std::max(1u, levels) - 1);
+
+            source.levels.resize(std::max(1u, levels));
+            pieces.push_back({ slot.layer, rect.x, rect.y, std::move(source.levels) });
+        }
+
+        const GLenum internal_format = sources[first].compressed ? block_format_to_GLenum(sources[first].format) : GL_RGBA8;
+        m_arrays.push_back(std::make_unique<TextureArray>(internal_format, layer_width, layer_height, layers_count, std::move(pieces)));
+    }
+
+    m_slots.reserve(image_paths.size());
+    for (const size_t source : source_of_path)
+    {
+        m_slots.push_back(source_slots[source]);
+    }
+}
+
+bool TextureAtlas::replace_texture(const std::string& image_path, TextureSource source)
+{
+    const auto packed = std::find_if(m_sources.begin(), m_sources.end(), [&](const PackedSource& entry) { return entry.path == image_path; });
+    if (packed == m_sources.end() || source.levels.empty())
+    {
+        return false;
+    }
+    const TextureLevelData& base = source.levels.front();
+    if (base.width != packed->width || base.height != packed->height || format_key(source) != packed->format_key)
+    {
+        return false;
+    }
+    return m_arrays[packed->array]->replace_piece(packed->piece, std::move(source.levels));
+}
+
+}
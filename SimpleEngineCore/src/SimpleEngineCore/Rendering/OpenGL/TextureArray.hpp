@@ -0,0 +1,115 @@
+#ifndef TEXTURE_ARRAY_HPP
+#define TEXTURE_ARRAY_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/Texture.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureStreamer.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/vec4.hpp>
+
+namespace SimpleEngine {
+
+// One texture placed in a layer at (x, y); level i goes to (x >> i, y >> i)
+struct TextureArrayPiece
+{
+    u32 layer = 0;
+    u32 x = 0;
+    u32 y = 0;
+    std::vector<TextureLevelData> levels;
+};
+
+// Immutable GL_TEXTURE_2D_ARRAY; every layer has the same size and format.
+// Streams like Texture: all layers share the resident level range.
+class TextureArray : public StreamedTexture
+{
+public:
+    TextureArray(const GLenum internal_format, const u32 width, const u32 height, const u32 layers_count,
+                 std::vector<TextureArrayPiece> pieces);
+    ~TextureArray() override;
+
+    void bind() const;
+    void unbind() const;
+
+    u32 get_width() const noexcept { return m_width; }
+    u32 get_height() const noexcept { return m_height; }
+    u32 get_layers_count() const noexcept { return m_layers_count; }
+
+    // Swaps pieces[index]'s levels for ones of the same sizes and uploads the
+    // resident ones. False, and nothing changed, when fewer levels are given.
+    bool replace_piece(const size_t index, std::vector<TextureLevelData> levels);
+
+protected:
+    void make_resident(const u32 level) override;
+    size_t get_level_size(const u32 level) const override;
+
+private:
+    // Uploads levels [first_level, last_level) of `piece` into `texture`,
+    // whose level 0 is level `base_level` of the array
+    void upload_piece(const u32 texture, const TextureArrayPiece& piece, const u32 base_level,
+                      const u32 first_level, const u32 last_level) const;
+
+    GLuint m_ID = 0;
+    GLenum m_internal_format;
+    bool m_compressed;
+    u32 m_width;
+    u32 m_height;
+    u32 m_layers_count;
+    std::vector<TextureArrayPiece> m_pieces;
+};
+
+// Where one source texture ended up. uv_rect is offset.xy and scale.zw inside
+// the layer; max_lod (counted from the array's full-size level) stops sampling
+// before the mips of a packed texture start to cover its neighbours.
+struct TextureSlot
+{
+    u32 array = 0;
+    u32 layer = 0;
+    glm::vec4 uv_rect{ 0.f, 0.f, 1.f, 1.f };
+    float max_lod = 0.f;
+};
+
+// Loads a set of textures (cooked .ctex when present, like Texture) and packs
+// the ones sharing a format into one TextureArray. Textures of the layer size
+// get a layer of their own, smaller ones are packed together at offsets
+// aligned to their power-of-two size so their mips stay in place.
+class TextureAtlas
+{
+public:
+    explicit TextureAtlas(const std::vector<std::string>& image_paths);
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Slot of image_paths[index]; repeated paths share one slot
+    const TextureSlot& get_slot(const size_t index) const { return m_slots[index]; }
+
+    // New contents for every slot of `image_path`, e.g. the image reloaded.
+    // Only works when they have the size and format the slot was packed for:
+    // false, and nothing changed, otherwise; the atlas has to be rebuilt then.
+    bool replace_texture(const std::string& image_path, TextureSource source);
+    const TextureArray& get_array(const size_t index) const { return *m_arrays[index]; }
+    size_t get_arrays_count() const noexcept { return m_arrays.size(); }
+
+private:
+    // Where a loaded texture went, to replace it later
+    struct PackedSource
+    {
+        std::string path;
+        u32 array = 0;
+        u32 piece = 0;
+        u32 width = 0;
+        u32 height = 0;
+        u32 format_key = 0;
+    };
+
+    std::vector<TextureSlot> m_slots;
+    std::vector<std::unique_ptr<TextureArray>> m_arrays;
+    std::vector<PackedSource> m_sources;
+};
+
+}
+
+#endif // TEXTURE_ARRAY_HPP
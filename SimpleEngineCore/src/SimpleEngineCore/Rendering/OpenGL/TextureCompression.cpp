@@ -0,0 +1,695 @@
+#include "TextureCompression.hpp"
+#include "MipChain.hpp"
+#include "SimpleEngineCore/JobSystem.hpp"
+#include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMPLE_ENGINE_BC_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace SimpleEngine {
+
+static constexpr char compressed_texture_magic[4] = { 'S', 'E', 'C', 'T' };
+static constexpr u32 compressed_texture_version = 1;
+static constexpr u32 max_compressed_levels_count = 32;
+
+// Levels smaller than this many blocks are not worth splitting into jobs
+static constexpr size_t parallel_blocks_threshold = 256;
+
+struct CompressedTextureHeader
+{
+    char magic[4];
+    u32 version;
+    u32 format;
+    u32 width;
+    u32 height;
+    u32 levels_count;
+};
+
+struct CompressedLevelHeader
+{
+    u32 width;
+    u32 height;
+    u32 size;
+};
+
+static u16 pack_565(const float* color)
+{
+    const u32 r = static_cast<u32>(std::clamp(color[0] * 31.f / 255.f + 0.5f, 0.f, 31.f));
+    const u32 g = static_cast<u32>(std::clamp(color[1] * 63.f / 255.f + 0.5f, 0.f, 63.f));
+    const u32 b = static_cast<u32>(std::clamp(color[2] * 31.f / 255.f + 0.5f, 0.f, 31.f));
+    return static_cast<u16>((r << 11) | (g << 5) | b);
+}
+
+static void unpack_565(const u16 color, u8* rgb)
+{
+    const u32 r = (color >> 11) & 31;
+    const u32 g = (color >> 5) & 63;
+    const u32 b = color & 31;
+    rgb[0] = static_cast<u8>((r << 3) | (r >> 2));
+    rgb[1] = static_cast<u8>((g << 2) | (g >> 4));
+    rgb[2] = static_cast<u8>((b << 3) | (b >> 2));
+}
+
+// Palette as the decoder builds it; the alpha byte is left 0 for the error metric
+static void build_color_palette(const u16 c0, const u16 c1, const bool four_colors, u8 palette[4][4])
+{
+    std::memset(palette, 0, 16);
+    unpack_565(c0, palette[0]);
+    unpack_565(c1, palette[1]);
+    for (i32 c = 0; c < 3; ++c)
+    {
+        if (four_colors)
+        {
+            palette[2][c] = static_cast<u8>((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = static_cast<u8>((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+        else
+        {
+            palette[2][c] = static_cast<u8>((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+    }
+}
+
+// Picks the nearest palette entry per pixel, returns the packed 2-bit indices and the total RGB error
+static u32 select_color_indices(const u8* rgba, const u8 palette[4][4], u32& total_error)
+{
+    u32 indices = 0;
+    total_error = 0;
+
+#ifdef SIMPLE_ENGINE_BC_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgb_mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    __m128i palette_wide[4];
+    for (i32 p = 0; p < 4; ++p)
+    {
+        u8 two_entries[8];
+        std::memcpy(two_entries, palette[p], 4);
+        std::memcpy(two_entries + 4, palette[p], 4);
+        palette_wide[p] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(two_entries)), zero);
+    }
+
+    // Two pixels per iteration as eight 16-bit channels
+    for (i32 i = 0; i < 16; i += 2)
+    {
+        __m128i pixels = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rgba + i * 4));
+        pixels = _mm_and_si128(_mm_unpacklo_epi8(pixels, zero), rgb_mask);
+
+        u32 best_error[2] = { ~0u, ~0u };
+        u32 best_index[2] = { 0, 0 };
+        for (u32 p = 0; p < 4; ++p)
+        {
+            const __m128i diff = _mm_sub_epi16(pixels, palette_wide[p]);
+            __m128i error = _mm_madd_epi16(diff, diff);
+            error = _mm_add_epi32(error, _mm_shuffle_epi32(error, _MM_SHUFFLE(2, 3, 0, 1)));
+            const u32 errors[2] =
+            {
+                static_cast<u32>(_mm_cvtsi128_si32(error)),
+                static_cast<u32>(_mm_cvtsi128_si32(_mm_srli_si128(error, 8)))
+            };
+            for (i32 k = 0; k < 2; ++k)
+            {
+                if (errors[k] < best_error[k])
+                {
+                    best_error[k] = errors[k];
+                    best_index[k] = p;
+                }
+            }
+        }
+        indices |= best_index[0] << (2 * i);
+        indices |= best_index[1] << (2 * (i + 1));
+        total_error += best_error[0] + best_error[1];
+    }
+#else
+    for (i32 i = 0; i < 16; ++i)
+    {
+        u32 best_error = ~0u;
+        u32 best_index = 0;
+        for (u32 p = 0; p < 4; ++p)
+        {
+            u32 error = 0;
+            for (i32 c = 0; c < 3; ++c)
+            {
+                const i32 diff = i32(rgba[i * 4 + c]) - i32(palette[p][c]);
+                error += static_cast<u32>(diff * diff);
+            }
+            if (error < best_error)
+            {
+                best_error = error;
+                best_index = p;
+            }
+        }
+        indices |= best_index << (2 * i);
+        total_error += best_error;
+    }
+#endif
+
+    return indices;
+}
+
+// Least-squares endpoints for fixed 4-color indices; false if the system is singular
+static bool refine_color_endpoints(const u8* rgba, const u32 indices, float* endpoint0, float* endpoint1)
+{
+    static constexpr float weight0[4] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+    float aa = 0.f, ab = 0.f, bb = 0.f;
+    float ax[3] = { 0.f, 0.f, 0.f };
+    float bx[3] = { 0.f, 0.f, 0.f };
+    for (i32 i = 0; i < 16; ++i)
+    {
+        const u32 index = (indices >> (2 * i)) & 3;
+        const float a = weight0[index];
+        const float b = 1.f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (i32 c = 0; c < 3; ++c)
+        {
+            ax[c] += a * rgba[i * 4 + c];
+            bx[c] += b * rgba[i * 4 + c];
+        }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f)
+    {
+        return false;
+    }
+    for (i32 c = 0; c < 3; ++c)
+    {
+        endpoint0[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+        endpoint1[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+    }
+    return true;
+}
+
+static void write_color_block(u16 c0, u16 c1, u32 indices, u8* out)
+{
+    if (c0 < c1)
+    {
+        std::swap(c0, c1);
+        indices ^= 0x55555555u;
+    }
+    else if (c0 == c1)
+    {
+        indices = 0;
+    }
+    out[0] = static_cast<u8>(c0 & 0xFF);
+    out[1] = static_cast<u8>(c0 >> 8);
+    out[2] = static_cast<u8>(c1 & 0xFF);
+    out[3] = static_cast<u8>(c1 >> 8);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+// Endpoints along the principal axis of the block's colors, then one least-squares refinement
+static void encode_color_block(const u8* rgba, u8* out)
+{
+    float mean[3] = { 0.f, 0.f, 0.f };
+    float min_color[3] = { 255.f, 255.f, 255.f };
+    float max_color[3] = { 0.f, 0.f, 0.f };
+    for (i32 i = 0; i < 16; ++i)
+    {
+        for (i32 c = 0; c < 3; ++c)
+        {
+            const float value = rgba[i * 4 + c];
+            mean[c] += value;
+            min_color[c] = std::min(min_color[c], value);
+            max_color[c] = std::max(max_color[c], value);
+        }
+    }
+    for (float& value : mean)
+    {
+        value /= 16.f;
+    }
+
+    float covariance[6] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+    for (i32 i = 0; i < 16; ++i)
+    {
+        const float r = rgba[i * 4 + 0] - mean[0];
+        const float g = rgba[i * 4 + 1] - mean[1];
+        const float b = rgba[i * 4 + 2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    float axis[3] = { max_color[0] - min_color[0], max_color[1] - min_color[1], max_color[2] - min_color[2] };
+    for (i32 iteration = 0; iteration < 4; ++iteration)
+    {
+        const float next[3] =
+        {
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+        };
+        const float largest = std::max(std::fabs(next[0]), std::max(std::fabs(next[1]), std::fabs(next[2])));
+        if (largest < 1e-6f)
+        {
+            break;
+        }
+        for (i32 c = 0; c < 3; ++c)
+        {
+            axis[c] = next[c] / largest;
+        }
+    }
+
+    float endpoint0[3];
+    float endpoint1[3];
+    const float axis_length2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    if (axis_length2 < 1e-6f)
+    {
+        std::copy(mean, mean + 3, endpoint0);
+        std::copy(mean, mean + 3, endpoint1);
+    }
+    else
+    {
+        float t_min = 1e9f;
+        float t_max = -1e9f;
+        for (i32 i = 0; i < 16; ++i)
+        {
+            const float t = (rgba[i * 4 + 0] - mean[0]) * axis[0]
+                          + (rgba[i * 4 + 1] - mean[1]) * axis[1]
+                          + (rgba[i * 4 + 2] - mean[2]) * axis[2];
+            t_min = std::min(t_min, t);
+            t_max = std::max(t_max, t);
+        }
+        for (i32 c = 0; c < 3; ++c)
+        {
+            endpoint0[c] = mean[c] + axis[c] * t_max / axis_length2;
+            endpoint1[c] = mean[c] + axis[c] * t_min / axis_length2;
+        }
+    }
+
+    u16 c0 = pack_565(endpoint0);
+    u16 c1 = pack_565(endpoint1);
+    u8 palette[4][4];
+    build_color_palette(c0, c1, true, palette);
+    u32 error = 0;
+    u32 indices = select_color_indices(rgba, palette, error);
+
+    if (error > 0 && refine_color_endpoints(rgba, indices, endpoint0, endpoint1))
+    {
+        const u16 refined0 = pack_565(endpoint0);
+        const u16 refined1 = pack_565(endpoint1);
+        build_color_palette(refined0, refined1, true, palette);
+        u32 refined_error = 0;
+        const u32 refined_indices = select_color_indices(rgba, palette, refined_error);
+        if (refined_error < error)
+        {
+            c0 = refined0;
+            c1 = refined1;
+            indices = refined_indices;
+        }
+    }
+
+    write_color_block(c0, c1, indices, out);
+}
+
+static void build_channel_palette(const u8 a0, const u8 a1, u8 palette[8])
+{
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1)
+    {
+        for (u32 i = 2; i < 8; ++i)
+        {
+            palette[i] = static_cast<u8>(((8 - i) * a0 + (i - 1) * a1) / 7);
+        }
+    }
+    else
+    {
+        for (u32 i = 2; i < 6; ++i)
+        {
+            palette[i] = static_cast<u8>(((6 - i) * a0 + (i - 1) * a1) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+// Single-channel 8-value block (BC4 layout), used for BC3 alpha and both BC5 channels
+static void encode_channel_block(const u8* rgba, const u32 channel, u8* out)
+{
+    u8 low = 255;
+    u8 high = 0;
+    for (i32 i = 0; i < 16; ++i)
+    {
+        low = std::min(low, rgba[i * 4 + channel]);
+        high = std::max(high, rgba[i * 4 + channel]);
+    }
+
+    out[0] = high;
+    out[1] = low;
+    if (high == low)
+    {
+        std::memset(out + 2, 0, 6);
+        return;
+    }
+
+    u8 palette[8];
+    build_channel_palette(high, low, palette);
+    u64 bits = 0;
+    for (i32 i = 0; i < 16; ++i)
+    {
+        const i32 value = rgba[i * 4 + channel];
+        u32 best_index = 0;
+        i32 best_error = 256;
+        for (u32 p = 0; p < 8; ++p)
+        {
+            const i32 error = std::abs(value - i32(palette[p]));
+            if (error < best_error)
+            {
+                best_error = error;
+                best_index = p;
+            }
+        }
+        bits |= u64(best_index) << (3 * i);
+    }
+    for (i32 k = 0; k < 6; ++k)
+    {
+        out[2 + k] = static_cast<u8>((bits >> (8 * k)) & 0xFF);
+    }
+}
+
+static void decode_color_block(const u8* block, const bool allow_three_colors, u8* rgba)
+{
+    const u16 c0 = static_cast<u16>(block[0] | (block[1] << 8));
+    const u16 c1 = static_cast<u16>(block[2] | (block[3] << 8));
+    u32 indices;
+    std::memcpy(&indices, block + 4, 4);
+
+    const bool four_colors = !allow_three_colors || c0 > c1;
+    u8 palette[4][4];
+    build_color_palette(c0, c1, four_colors, palette);
+    for (i32 p = 0; p < 4; ++p)
+    {
+        palette[p][3] = (!four_colors && p == 3) ? 0 : 255;
+    }
+    for (i32 i = 0; i < 16; ++i)
+    {
+        std::memcpy(rgba + i * 4, palette[(indices >> (2 * i)) & 3], 4);
+    }
+}
+
+static void decode_channel_block(const u8* block, const u32 channel, u8* rgba)
+{
+    u8 palette[8];
+    build_channel_palette(block[0], block[1], palette);
+    u64 bits = 0;
+    for (i32 k = 0; k < 6; ++k)
+    {
+        bits |= u64(block[2 + k]) << (8 * k);
+    }
+    for (i32 i = 0; i < 16; ++i)
+    {
+        rgba[i * 4 + channel] = palette[(bits >> (3 * i)) & 7];
+    }
+}
+
+void encode_bc1_block(const u8* rgba, u8* out)
+{
+    encode_color_block(rgba, out);
+}
+
+void encode_bc3_block(const u8* rgba, u8* out)
+{
+    encode_channel_block(rgba, 3, out);
+    encode_color_block(rgba, out + 8);
+}
+
+void encode_bc5_block(const u8* rgba, u8* out)
+{
+    encode_channel_block(rgba, 0, out);
+    encode_channel_block(rgba, 1, out + 8);
+}
+
+void decode_block(const EBlockFormat format, const u8* block, u8* rgba)
+{
+    switch (format)
+    {
+        case EBlockFormat::BC1:
+            decode_color_block(block, true, rgba);
+            break;
+
+        case EBlockFormat::BC3:
+            decode_color_block(block + 8, false, rgba);
+            decode_channel_block(block, 3, rgba);
+            break;
+
+        case EBlockFormat::BC5:
+            for (i32 i = 0; i < 16; ++i)
+            {
+                rgba[i * 4 + 2] = 0;
+                rgba[i * 4 + 3] = 255;
+            }
+            decode_channel_block(block, 0, rgba);
+            decode_channel_block(block + 8, 1, rgba);
+            break;
+    }
+}
+
+// Copies a 4x4 block, repeating the last row/column past the image edge
+static void fetch_block(const Image& image, const u32 block_x, const u32 block_y, u8* rgba)
+{
+    for (u32 y = 0; y < 4; ++y)
+    {
+        const u32 source_y = std::min(block_y * 4 + y, image.height - 1);
+        for (u32 x = 0; x < 4; ++x)
+        {
+            const u32 source_x = std::min(block_x * 4 + x, image.width - 1);
+            std::memcpy(rgba + (y * 4 + x) * 4, &image.rgba[(size_t(source_y) * image.width + source_x) * 4], 4);
+        }
+    }
+}
+
+bool load_image_rgba(const char* path, Image& image)
+{
+    int width = 0, height = 0, channels = 0;
+    stbi_set_flip_vertically_on_load(true);
+    unsigned char* bytes = stbi_load(path, &width, &height, &channels, 4);
+    if (bytes == nullptr)
+    {
+        LOG_ERROR("Failed to load image: {0}", path);
+        return false;
+    }
+
+    image.width = static_cast<u32>(width);
+    image.height = static_cast<u32>(height);
+    image.rgba.assign(bytes, bytes + size_t(width) * height * 4);
+    stbi_image_free(bytes);
+    return true;
+}
+
+CompressedLevel compress_image(const Image& image, const EBlockFormat format, const u32 threads_count)
+{
+    CompressedLevel level;
+    level.width = image.width;
+    level.height = image.height;
+    if (image.width == 0 || image.height == 0)
+    {
+        return level;
+    }
+
+    const u32 blocks_x = (image.width + 3) / 4;
+    const u32 blocks_y = (image.height + 3) / 4;
+    const u32 block_size = block_format_size(format);
+    level.blocks.resize(block_compressed_size(format, image.width, image.height));
+
+    JobSystem& jobs = JobSystem::get();
+    const u32 grain = size_t(blocks_x) * blocks_y >= parallel_blocks_threshold ? jobs.get_grain(blocks_y, threads_count) : blocks_y;
+    jobs.parallel_for(0u, blocks_y, grain, [&](const u32 first_row, const u32 last_row)
+    {
+        u8 pixels[16 * 4];
+        for (u32 block_y = first_row; block_y < last_row; ++block_y)
+        {
+            for (u32 block_x = 0; block_x < blocks_x; ++block_x)
+            {
+                fetch_block(image, block_x, block_y, pixels);
+                u8* out = &level.blocks[(size_t(block_y) * blocks_x + block_x) * block_size];
+                switch (format)
+                {
+                    case EBlockFormat::BC1: encode_bc1_block(pixels, out); break;
+                    case EBlockFormat::BC3: encode_bc3_block(pixels, out); break;
+                    case EBlockFormat::BC5: encode_bc5_block(pixels, out); break;
+                }
+            }
+        }
+    });
+    return level;
+}
+
+CompressedTexture compress_texture(const Image& image, const EBlockFormat format, const bool generate_mips,
+                                   const u32 threads_count, const bool kaiser_mips)
+{
+    CompressedTexture texture;
+    texture.format = format;
+    texture.levels.push_back(compress_image(image, format, threads_count));
+
+    if (generate_mips)
+    {
+        const std::vector<Image> mips = generate_mip_chain(image, kaiser_mips ? EMipFilter::Kaiser : EMipFilter::Box,
+                                                           format != EBlockFormat::BC5, threads_count);
+        for (const Image& mip : mips)
+        {
+            texture.levels.push_back(compress_image(mip, format, threads_count));
+        }
+    }
+    return texture;
+}
+
+Image decompress_level(const EBlockFormat format, const CompressedLevel& level)
+{
+    Image image;
+    image.width = level.width;
+    image.height = level.height;
+    image.rgba.resize(size_t(level.width) * level.height * 4);
+
+    const u32 blocks_x = (level.width + 3) / 4;
+    const u32 blocks_y = (level.height + 3) / 4;
+    const u32 block_size = block_format_size(format);
+    u8 pixels[16 * 4];
+    for (u32 block_y = 0; block_y < blocks_y; ++block_y)
+    {
+        for (u32 block_x = 0; block_x < blocks_x; ++block_x)
+        {
+            decode_block(format, &level.blocks[(size_t(block_y) * blocks_x + block_x) * block_size], pixels);
+            for (u32 y = 0; y < 4 && block_y * 4 + y < level.height; ++y)
+            {
+                for (u32 x = 0; x < 4 && block_x * 4 + x < level.width; ++x)
+                {
+                    const size_t target = (size_t(block_y * 4 + y) * level.width + block_x * 4 + x) * 4;
+                    std::memcpy(&image.rgba[target], pixels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return image;
+}
+
+double compute_psnr(const EBlockFormat format, const Image& reference, const Image& decoded)
+{
+    if (reference.width != decoded.width || reference.height != decoded.height || reference.rgba.empty())
+    {
+        return 0.0;
+    }
+
+    const u32 channels = format == EBlockFormat::BC1 ? 3 : (format == EBlockFormat::BC3 ? 4 : 2);
+    double squared_error = 0.0;
+    for (size_t i = 0; i < reference.rgba.size(); i += 4)
+    {
+        for (u32 c = 0; c < channels; ++c)
+        {
+            const double diff = double(reference.rgba[i + c]) - double(decoded.rgba[i + c]);
+            squared_error += diff * diff;
+        }
+    }
+
+    const double mse = squared_error / (double(reference.rgba.size() / 4) * channels);
+    if (mse <= 0.0)
+    {
+        return 99.0;
+    }
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+bool write_compressed_texture(const char* path, const CompressedTexture& texture)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        LOG_ERROR("Failed to open {0} for writing", path);
+        return false;
+    }
+
+    CompressedTextureHeader header;
+    std::memcpy(header.magic, compressed_texture_magic, 4);
+    header.version = compressed_texture_version;
+    header.format = static_cast<u32>(texture.format);
+    header.width = texture.levels.empty() ? 0 : texture.levels[0].width;
+    header.height = texture.levels.empty() ? 0 : texture.levels[0].height;
+    header.levels_count = static_cast<u32>(texture.levels.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const CompressedLevel& level : texture.levels)
+    {
+        const CompressedLevelHeader level_header{ level.width, level.height, static_cast<u32>(level.blocks.size()) };
+        file.write(reinterpret_cast<const char*>(&level_header), sizeof(level_header));
+        file.write(reinterpret_cast<const char*>(level.blocks.data()), level.blocks.size());
+    }
+    return static_cast<bool>(file);
+}
+
+bool read_compressed_texture(const char* path, CompressedTexture& texture)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    CompressedTextureHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, compressed_texture_magic, 4) != 0 || header.version != compressed_texture_version)
+    {
+        LOG_ERROR("{0} is not a compressed texture", path);
+        return false;
+    }
+
+    const EBlockFormat format = static_cast<EBlockFormat>(header.format);
+    if (format != EBlockFormat::BC1 && format != EBlockFormat::BC3 && format != EBlockFormat::BC5)
+    {
+        LOG_ERROR("{0}: unknown block format {1}", path, header.format);
+        return false;
+    }
+
+    // A u32 edge halves down to one texel in at most 32 levels
+    if (header.width == 0 || header.height == 0 || header.levels_count == 0 || header.levels_count > max_compressed_levels_count
+        || header.levels_count > mip_levels_count(header.width, header.height))
+    {
+        LOG_ERROR("{0}: corrupted header", path);
+        return false;
+    }
+
+    const std::streamoff data_begin = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - data_begin;
+    file.seekg(data_begin);
+
+    texture.format = format;
+    texture.levels.resize(header.levels_count);
+    u32 expected_width = header.width;
+    u32 expected_height = header.height;
+    for (CompressedLevel& level : texture.levels)
+    {
+        CompressedLevelHeader level_header;
+        file.read(reinterpret_cast<char*>(&level_header), sizeof(level_header));
+        remaining -= static_cast<std::streamoff>(sizeof(level_header));
+        if (!file || level_header.width != expected_width || level_header.height != expected_height
+            || level_header.size != block_compressed_size(format, level_header.width, level_header.height)
+            || static_cast<std::streamoff>(level_header.size) > remaining)
+        {
+            LOG_ERROR("{0}: corrupted mip level", path);
+            return false;
+        }
+        remaining -= static_cast<std::streamoff>(level_header.size);
+        expected_width = std::max(1u, expected_width / 2);
+        expected_height = std::max(1u, expected_height / 2);
+        level.width = level_header.width;
+        level.height = level_header.height;
+        level.blocks.resize(level_header.size);
+        file.read(reinterpret_cast<char*>(level.blocks.data()), level.blocks.size());
+    }
+    return static_cast<bool>(file);
+}
+
+}
@@ -0,0 +1,77 @@
+#ifndef TEXTURE_COMPRESSION_HPP
+#define TEXTURE_COMPRESSION_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <vector>
+
+// CPU block-compression encoder and the ".ctex" container the Texture class
+// uploads with glCompressedTexImage2D. Nothing in here touches OpenGL, so
+// cooking and quality checks run without a context.
+namespace SimpleEngine {
+
+enum class EBlockFormat : u32
+{
+    BC1 = 1, // RGB, 8 bytes per 4x4 block
+    BC3 = 3, // RGBA, 16 bytes per 4x4 block
+    BC5 = 5  // RG, 16 bytes per 4x4 block (normal maps)
+};
+
+constexpr u32 block_format_size(const EBlockFormat format)
+{
+    return format == EBlockFormat::BC1 ? 8 : 16;
+}
+
+constexpr size_t block_compressed_size(const EBlockFormat format, const u32 width, const u32 height)
+{
+    return size_t((width + 3) / 4) * ((height + 3) / 4) * block_format_size(format);
+}
+
+// Tightly packed 8-bit RGBA
+struct Image
+{
+    u32 width = 0;
+    u32 height = 0;
+    std::vector<u8> rgba;
+};
+
+struct CompressedLevel
+{
+    u32 width = 0;
+    u32 height = 0;
+    std::vector<u8> blocks;
+};
+
+struct CompressedTexture
+{
+    EBlockFormat format = EBlockFormat::BC1;
+    std::vector<CompressedLevel> levels;
+};
+
+// Loads a PNG as RGBA, flipped like Texture does
+bool load_image_rgba(const char* path, Image& image);
+
+// Single 4x4 block encoders; `rgba` points to 16 pixels in row order
+void encode_bc1_block(const u8* rgba, u8* out);
+void encode_bc3_block(const u8* rgba, u8* out);
+void encode_bc5_block(const u8* rgba, u8* out);
+void decode_block(const EBlockFormat format, const u8* block, u8* rgba);
+
+CompressedLevel compress_image(const Image& image, const EBlockFormat format, const u32 threads_count = 0);
+
+// Compresses the image and, if requested, every level of its mip chain down to 1x1
+// (see generate_mip_chain; BC5 data is filtered as linear, the rest as sRGB).
+// Rows of blocks are split into at most threads_count jobs; 0 lets the job system choose.
+CompressedTexture compress_texture(const Image& image, const EBlockFormat format, const bool generate_mips = true,
+                                   const u32 threads_count = 0, const bool kaiser_mips = true);
+
+Image decompress_level(const EBlockFormat format, const CompressedLevel& level);
+
+// Peak signal-to-noise ratio in dB over the channels the format keeps
+double compute_psnr(const EBlockFormat format, const Image& reference, const Image& decoded);
+
+bool write_compressed_texture(const char* path, const CompressedTexture& texture);
+bool read_compressed_texture(const char* path, CompressedTexture& texture);
+
+}
+
+#endif // TEXTURE_COMPRESSION_HPP
@@ -0,0 +1,205 @@
+#include "TextureStreamer.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace SimpleEngine {
+
+u32 texture_level_for_screen_size(const u32 texture_size, const float pixels)
+{
+    if (pixels <= 1.f)
+    {
+        return ~0u;
+    }
+    const float ratio = static_cast<float>(texture_size) / pixels;
+    return ratio <= 1.f ? 0 : static_cast<u32>(std::floor(std::log2(ratio)));
+}
+
+StreamedTexture::~StreamedTexture()
+{
+    stop_streaming();
+}
+
+void StreamedTexture::request_level(const u32 level) const
+{
+    m_requested_level = std::min(m_requested_level, level);
+    m_last_request_frame = TextureStreamer::get().m_frame;
+}
+
+void StreamedTexture::request_screen_size(const float pixels) const
+{
+    request_level(texture_level_for_screen_size(m_width, pixels));
+}
+
+void StreamedTexture::update_resident_size()
+{
+    m_resident_size = 0;
+    for (u32 level = m_resident_level; level < m_levels_count; ++level)
+    {
+        m_resident_size += get_level_size(level);
+    }
+}
+
+void StreamedTexture::start_streaming(const u32 width, const u32 levels_count, const u32 coarsest_level)
+{
+    m_width = width;
+    m_levels_count = levels_count;
+    m_coarsest_level = std::min(coarsest_level, levels_count - 1);
+    make_resident(m_coarsest_level);
+    m_resident_level = m_coarsest_level;
+    update_resident_size();
+    TextureStreamer::get().add(*this);
+    m_streaming = true;
+}
+
+void StreamedTexture::stop_streaming()
+{
+    if (m_streaming)
+    {
+        TextureStreamer::get().remove(*this);
+        m_streaming = false;
+    }
+}
+
+u32 StreamedTexture::needed_level() const
+{
+    return std::min(m_requested_level, m_coarsest_level);
+}
+
+static TextureStreamer s_texture_streamer;
+
+TextureStreamer& TextureStreamer::get()
+{
+    return s_texture_streamer;
+}
+
+void TextureStreamer::add(StreamedTexture& texture)
+{
+    m_textures.push_back(&texture);
+    m_stats.resident_bytes += texture.get_resident_size();
+}
+
+void TextureStreamer::remove(StreamedTexture& texture)
+{
+    m_textures.erase(std::remove(m_textures.begin(), m_textures.end(), &texture), m_textures.end());
+    m_stats.resident_bytes -= texture.get_resident_size();
+}
+
+void TextureStreamer::set_resident(StreamedTexture& texture, const u32 level)
+{
+    m_stats.resident_bytes -= texture.get_resident_size();
+    texture.make_resident(level);
+    texture.m_resident_level = level;
+    texture.update_resident_size();
+    m_stats.resident_bytes += texture.get_resident_size();
+}
+
+bool TextureStreamer::make_room(const size_t size, const StreamedTexture* keep)
+{
+    while (m_stats.resident_bytes + size > m_settings.vram_budget)
+    {
+        // Least recently needed first, then the one freeing the most
+        StreamedTexture* victim = nullptr;
+        for (StreamedTexture* texture : m_textures)
+        {
+            if (texture == keep || texture->m_resident_level >= texture->needed_level())
+            {
+                continue;
+            }
+            if (victim == nullptr
+                || texture->m_last_request_frame < victim->m_last_request_frame
+                || (texture->m_last_request_frame == victim->m_last_request_frame
+                    && texture->get_level_size(texture->m_resident_level) > victim->get_level_size(victim->m_resident_level)))
+            {
+                victim = texture;
+            }
+        }
+        if (victim == nullptr)
+        {
+            return false;
+        }
+
+        m_stats.evicted_bytes += victim->get_level_size(victim->m_resident_level);
+        ++m_stats.evictions;
+        set_resident(*victim, victim->m_resident_level + 1);
+    }
+    return true;
+}
+
+void TextureStreamer::update()
+{
+    PROFILE_SCOPE("TextureStreamer::update");
+    const MemoryTagScope memory_tag(EMemoryTag::Streaming);
+    using clock = std::chrono::steady_clock;
+    const clock::time_point start = clock::now();
+    const auto elapsed_ms = [&start]() { return std::chrono::duration<float, std::milli>(clock::now() - start).count(); };
+
+    m_stats.uploads = 0;
+    m_stats.uploaded_bytes = 0;
+
+    // Registration order breaks ties, stable_sort would take a heap scratch buffer
+    struct PendingUpload
+    {
+        StreamedTexture* texture;
+        u32 levels_missing;
+        u32 order;
+    };
+    ArenaVector<PendingUpload> pending(frame_allocator<PendingUpload>(EMemoryTag::Streaming));
+    pending.reserve(m_textures.size());
+    for (size_t i = 0; i < m_textures.size(); ++i)
+    {
+        StreamedTexture* texture = m_textures[i];
+        const u32 needed_level = texture->needed_level();
+        if (needed_level < texture->m_resident_level)
+        {
+            pending.push_back({ texture, texture->m_resident_level - needed_level, static_cast<u32>(i) });
+        }
+    }
+    // Furthest from what the camera needs first
+    std::sort(pending.begin(), pending.end(), [](const PendingUpload& left, const PendingUpload& right)
+    {
+        return left.levels_missing != right.levels_missing ? left.levels_missing > right.levels_missing : left.order < right.order;
+    });
+
+    for (const PendingUpload& upload : pending)
+    {
+        StreamedTexture* texture = upload.texture;
+        // The first upload always goes, so a level larger than the budget still arrives
+        if (m_stats.uploads > 0 && (m_stats.uploaded_bytes >= m_settings.max_upload_bytes_per_frame
+                                    || elapsed_ms() >= m_settings.max_upload_ms))
+        {
+            break;
+        }
+
+        const u32 level = texture->m_resident_level - 1;
+        const size_t size = texture->get_level_size(level);
+        if (!make_room(size, texture))
+        {
+            continue;
+        }
+        set_resident(*texture, level);
+        ++m_stats.uploads;
+        m_stats.uploaded_bytes += size;
+    }
+
+    // The budget may have been lowered since the last frame
+    make_room(0, nullptr);
+
+    m_stats.pending_requests = 0;
+    for (StreamedTexture* texture : m_textures)
+    {
+        if (texture->needed_level() < texture->m_resident_level)
+        {
+            ++m_stats.pending_requests;
+        }
+        texture->m_requested_level = ~0u;
+    }
+    m_stats.textures_count = m_textures.size();
+    m_stats.upload_ms = elapsed_ms();
+    ++m_frame;
+}
+
+}
@@ -0,0 +1,118 @@
+#ifndef TEXTURE_STREAMER_HPP
+#define TEXTURE_STREAMER_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <vector>
+
+namespace SimpleEngine {
+
+// Finest mip worth having for a texture `texture_size` texels across that
+// covers `pixels` screen pixels, assuming its UVs span the surface once
+u32 texture_level_for_screen_size(const u32 texture_size, const float pixels);
+
+// A GPU texture whose finest mips come and go under TextureStreamer. Only the
+// levels from get_resident_level() down to 1x1 are allocated; the source
+// levels stay in system memory so dropped ones can be uploaded again.
+class StreamedTexture
+{
+public:
+    StreamedTexture() = default;
+    virtual ~StreamedTexture();
+
+    StreamedTexture(const StreamedTexture&) = delete;
+    StreamedTexture& operator=(const StreamedTexture&) = delete;
+
+    // Renderers call these every frame the texture is drawn; the finest request
+    // of the frame wins. Requests are bookkeeping, so they work on const textures.
+    void request_level(const u32 level) const;
+    void request_screen_size(const float pixels) const;
+
+    u32 get_resident_level() const noexcept { return m_resident_level; }
+    u32 get_levels_count() const noexcept { return m_levels_count; }
+    size_t get_resident_size() const noexcept { return m_resident_size; }
+
+protected:
+    // Makes every level up to `coarsest_level` resident and registers with the
+    // streamer; those levels are never evicted
+    void start_streaming(const u32 width, const u32 levels_count, const u32 coarsest_level);
+    // Unregisters, so start_streaming() can run again for new contents
+    void stop_streaming();
+
+    // Reallocates the GPU texture so levels `level`..levels_count-1 are resident;
+    // m_resident_level still holds the previous level during the call
+    virtual void make_resident(const u32 level) = 0;
+    // Bytes level `level` takes on the GPU
+    virtual size_t get_level_size(const u32 level) const = 0;
+
+    u32 m_resident_level = 0;
+
+private:
+    friend class TextureStreamer;
+
+    u32 needed_level() const;
+    // Sums get_level_size; cached because the destructor cannot call it
+    void update_resident_size();
+
+    u32 m_width = 0;
+    u32 m_levels_count = 0;
+    u32 m_coarsest_level = 0;
+    size_t m_resident_size = 0;
+    bool m_streaming = false;
+    mutable u32 m_requested_level = ~0u;
+    mutable u64 m_last_request_frame = 0;
+};
+
+// Brings requested mips in one level per texture per frame, within a per-frame
+// upload budget. When a new level does not fit the VRAM budget, levels finer
+// than their texture currently needs are evicted, least recently needed first.
+class TextureStreamer
+{
+public:
+    struct Settings
+    {
+        size_t vram_budget = size_t(256) << 20;
+        size_t max_upload_bytes_per_frame = size_t(8) << 20;
+        float max_upload_ms = 2.f;
+        // Levels at most this large are resident from load time on
+        u32 resident_size = 64;
+    };
+
+    struct Stats
+    {
+        size_t resident_bytes = 0;
+        size_t textures_count = 0;
+        size_t pending_requests = 0;
+        size_t uploads = 0;
+        size_t uploaded_bytes = 0;
+        float upload_ms = 0.f;
+        size_t evictions = 0;
+        size_t evicted_bytes = 0;
+    };
+
+    static TextureStreamer& get();
+
+    // Once per frame after every texture has been requested
+    void update();
+
+    Settings& get_settings() noexcept { return m_settings; }
+    // uploads, uploaded_bytes and upload_ms cover the last update
+    const Stats& get_stats() const noexcept { return m_stats; }
+
+private:
+    friend class StreamedTexture;
+
+    void add(StreamedTexture& texture);
+    void remove(StreamedTexture& texture);
+    void set_resident(StreamedTexture& texture, const u32 level);
+    // Evicts until `size` more bytes fit the budget; `keep` is never touched
+    bool make_room(const size_t size, const StreamedTexture* keep);
+
+    Settings m_settings;
+    Stats m_stats;
+    std::vector<StreamedTexture*> m_textures;
+    u64 m_frame = 1;
+};
+
+}
+
+#endif // TEXTURE_STREAMER_HPP
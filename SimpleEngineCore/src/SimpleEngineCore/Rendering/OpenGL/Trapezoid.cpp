@@ -1,4 +1,5 @@
 #include "Trapezoid.hpp"
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
@@ -8,164 +9,37 @@
 namespace SimpleEngine
 {
 
-const char* trapezoid_vertex_shader = R"(
-#version 460
-layout(location = 0) in vec3 vertex_position;
-layout(location = 1) in vec3 vertex_color;
-out vec3 color;
-uniform mat4 camMatrix;
-uniform mat4 rotationMatrix;
-void main() {
-    color = vertex_color;
-    gl_Position = camMatrix * rotationMatrix * vec4(vertex_position, 1.0);
-})";
-
-const char* trapezoid_fragment_shader = R"(
-#version 460
-in vec3 color;
-out vec4 frag_color;
-void main() {
-   frag_color = vec4(color, 1.0);
-})";
-
-
-Trapezoid::Trapezoid(const GLfloat height, const float up_length, const float down_length, const glm::vec3& color, const glm::vec3& center)
+Trapezoid::Trapezoid(const float up_length, const float down_length, const glm::vec3& color, const glm::vec3& center)
 {
-    generate(height, up_length, down_length, color, center);
-    m_p_shader_program = std::make_unique<ShaderProgram>(trapezoid_vertex_shader, trapezoid_fragment_shader);
-    rotationUniformLoc = m_p_shader_program->get_uniform_location("rotationMatrix");
-
-    m_p_vao = std::make_unique<VertexArray>();
+    m_p_shader_program = ShaderProgram::get_shared("primitive");
 
-    m_p_positions_colors_vbo = std::make_unique<VertexBuffer>(
-        positionsColors.data(),
-        sizeof(positionsColors.data()[0]) * positionsColors.size(),
-        buffer_layout_2_vec3,
-        VertexBuffer::EUsage::Dynamic);
+    m_p_vao = &VertexArray::get_shared(ColoredVertex::Layout::layout);
 
-    m_p_index_buffer = std::make_unique<IndexBuffer>(indices.data(), indices.size(), VertexBuffer::EUsage::Dynamic);
-
-    m_p_vao->add_vertex_buffer(*m_p_positions_colors_vbo);
-    m_p_vao->set_index_buffer(*m_p_index_buffer);
+    m_p_mesh = PrimitiveMesh::get_shared(make_trapezoid_key(up_length, down_length, color, center));
 }
 
-void Trapezoid::rotate(glm::vec3 axis, float angle)
+void Trapezoid::bind_shader()
 {
-    m_p_vao->enable_vertex_buffer();
-    m_p_vao->set_index_buffer(*m_p_index_buffer);
-    rotAngle += angle;
     m_p_shader_program->bind();
-    glUniformMatrix4fv(rotationUniformLoc, 1, GL_FALSE,
-        glm::value_ptr(glm::rotate(rotAngle, axis)));
-    m_p_vao->bind();
-    glDrawElements(GL_LINES,
-        static_cast<GLsizei>(m_p_vao->get_indices_count()),
-        GL_UNSIGNED_INT,
-        nullptr);
+    if (m_p_shader_program->is_relinked(m_shader_generation))
+    {
+        rotationUniformLoc = m_p_shader_program->get_uniform_location("rotationMatrix");
+    }
+    RenderBackend::get().set_uniform(rotationUniformLoc, m_rotation_matrix);
 }
 
-void Trapezoid::render()
+void Trapezoid::rotate(glm::vec3 axis, float angle)
 {
-    m_p_shader_program->bind();
-    m_p_vao->bind();
-    glDrawElements(GL_LINES,
-        static_cast<GLsizei>(m_p_vao->get_indices_count()),
-        GL_UNSIGNED_INT,
-        nullptr);
+    rotAngle += angle;
+    m_rotation_matrix = glm::rotate(rotAngle, axis);
+    bind_shader();
+    m_p_mesh->draw(*m_p_vao);
 }
 
-void Trapezoid::generate(const GLfloat height, const float up_length, const float down_length, const glm::vec3& color, const glm::vec3& center)
+void Trapezoid::render()
 {
-    int i = -1;
-    // dots
-    {
-    positionsColors[++i] = down_length * 0.5f + center.x;
-    positionsColors[++i] = down_length * 0.5f + center.y;
-    positionsColors[++i] = down_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = down_length * 0.5f + center.x;
-    positionsColors[++i] = -1 * down_length * 0.5f + center.y;
-    positionsColors[++i] = down_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = -1 * down_length * 0.5f + center.x;
-    positionsColors[++i] = -1 * down_length * 0.5f + center.y;
-    positionsColors[++i] = down_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = -1 * down_length * 0.5f + center.x;
-    positionsColors[++i] = down_length * 0.5f + center.y;
-    positionsColors[++i] = down_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = up_length * 0.5f + center.x;
-    positionsColors[++i] = up_length * 0.5f + center.y;
-    positionsColors[++i] = up_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = up_length * 0.5f + center.x;
-    positionsColors[++i] = -1 * up_length * 0.5f + center.y;
-    positionsColors[++i] = up_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = -1 * up_length * 0.5f + center.x;
-    positionsColors[++i] = -1 * up_length * 0.5f + center.y;
-    positionsColors[++i] = up_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-
-    positionsColors[++i] = -1 * up_length * 0.5f + center.x;
-    positionsColors[++i] = up_length * 0.5f + center.y;
-    positionsColors[++i] = up_length * 0.5f + center.z;
-    positionsColors[++i] = color.x;
-    positionsColors[++i] = color.y;
-    positionsColors[++i] = color.z;
-    }
-    
-    // indices
-    {
-    i = -1;
-    indices[++i] = 0;
-    indices[++i] = 1;
-    indices[++i] = 1;
-    indices[++i] = 2;
-    indices[++i] = 2;
-    indices[++i] = 3;
-    indices[++i] = 3;
-    indices[++i] = 0;
-
-    indices[++i] = 4;
-    indices[++i] = 5;
-    indices[++i] = 5;
-    indices[++i] = 6;
-    indices[++i] = 6;
-    indices[++i] = 7;
-    indices[++i] = 7;
-    indices[++i] = 4;
-
-    indices[++i] = 0;
-    indices[++i] = 4;
-    indices[++i] = 1;
-    indices[++i] = 5;
-    indices[++i] = 2;
-    indices[++i] = 6;
-    indices[++i] = 3;
-    indices[++i] = 7;
-    }
+    bind_shader();
+    m_p_mesh->draw(*m_p_vao);
 }
 
 }
\ No newline at end of file
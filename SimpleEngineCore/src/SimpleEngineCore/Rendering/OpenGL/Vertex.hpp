@@ -0,0 +1,41 @@
+#ifndef VERTEX_HPP
+#define VERTEX_HPP
+#include "SimpleEngineCore/Types.hpp"
+#include "VertexBuffer.hpp"
+#include <cstddef>
+
+namespace SimpleEngine
+{
+
+// Textured, lit vertex produced by loadOBJ
+struct Vertex
+{
+    glm::vec3 position;
+    glm::vec2 texcoord;
+    glm::vec3 normal;
+
+    using Layout = VertexLayout<glm::vec3, glm::vec2, glm::vec3>;
+};
+
+static_assert(Vertex::Layout::stride == sizeof(Vertex), "Vertex layout stride mismatch");
+static_assert(Vertex::Layout::offset(0) == offsetof(Vertex, position), "Vertex::position offset mismatch");
+static_assert(Vertex::Layout::offset(1) == offsetof(Vertex, texcoord), "Vertex::texcoord offset mismatch");
+static_assert(Vertex::Layout::offset(2) == offsetof(Vertex, normal), "Vertex::normal offset mismatch");
+
+// Position + color vertex used by the debug primitives and STL models
+struct ColoredVertex
+{
+    glm::vec3 position;
+    glm::vec3 color;
+
+    using Layout = VertexLayout<glm::vec3, glm::vec3>;
+};
+
+static_assert(ColoredVertex::Layout::stride == sizeof(ColoredVertex), "ColoredVertex layout stride mismatch");
+static_assert(ColoredVertex::Layout::offset(0) == offsetof(ColoredVertex, position), "ColoredVertex::position offset mismatch");
+static_assert(ColoredVertex::Layout::offset(1) == offsetof(ColoredVertex, color), "ColoredVertex::color offset mismatch");
+static_assert(ColoredVertex::Layout::stride == 6 * sizeof(GLfloat), "Primitives pack ColoredVertex as 6 floats");
+
+}
+
+#endif // VERTEX_HPP
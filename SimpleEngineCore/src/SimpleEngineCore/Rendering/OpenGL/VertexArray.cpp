@@ -1,79 +1,130 @@
 #include "VertexArray.hpp"
 #include "VertexBuffer.hpp"
 #include "SimpleEngineCore/Log.hpp"
-#include <glad/glad.h>
+#include "SimpleEngineCore/Rendering/RenderBackend.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace SimpleEngine {
 
+static std::vector<std::pair<BufferLayout, std::unique_ptr<VertexArray>>> s_shared_vertex_arrays;
+
 VertexArray::VertexArray()
 {
-    glGenVertexArrays(1, &m_id);
+    m_id = RenderBackend::get().create_vertex_array();
 }
 
 VertexArray::~VertexArray()
 {
-    glDeleteVertexArrays(1, &m_id);
+    if (m_id != 0)
+    {
+        RenderBackend::get().delete_vertex_array(m_id);
+    }
 }
 
 VertexArray& VertexArray::operator=(VertexArray&& vertex_buffer) noexcept
 {
+    if (m_id != 0)
+    {
+        RenderBackend::get().delete_vertex_array(m_id);
+    }
     m_id = vertex_buffer.m_id;
     m_elements_count = vertex_buffer.m_elements_count;
+    m_bindings_count = vertex_buffer.m_bindings_count;
+    m_indices_count = vertex_buffer.m_indices_count;
     vertex_buffer.m_id = 0;
     vertex_buffer.m_elements_count = 0;
+    vertex_buffer.m_bindings_count = 0;
+    vertex_buffer.m_indices_count = 0;
     return *this;
 }
 
 VertexArray::VertexArray(VertexArray&& vertex_buffer) noexcept
     : m_id(vertex_buffer.m_id),
-      m_elements_count(vertex_buffer.m_elements_count)
+      m_elements_count(vertex_buffer.m_elements_count),
+      m_bindings_count(vertex_buffer.m_bindings_count),
+      m_indices_count(vertex_buffer.m_indices_count)
 {
     vertex_buffer.m_id = 0;
     vertex_buffer.m_elements_count = 0;
+    vertex_buffer.m_bindings_count = 0;
+    vertex_buffer.m_indices_count = 0;
+}
+
+VertexArray& VertexArray::get_shared(const BufferLayout& layout)
+{
+    for (auto& [shared_layout, vertex_array] : s_shared_vertex_arrays)
+    {
+        if (shared_layout == layout)
+        {
+            return *vertex_array;
+        }
+    }
+
+    auto vertex_array = std::make_unique<VertexArray>();
+    vertex_array->add_vertex_format(layout);
+    s_shared_vertex_arrays.emplace_back(layout, std::move(vertex_array));
+    return *s_shared_vertex_arrays.back().second;
+}
+
+void VertexArray::release_shared()
+{
+    s_shared_vertex_arrays.clear();
 }
 
 void VertexArray::bind() const
 {
-    glBindVertexArray(m_id);
+    RenderBackend::get().bind_vertex_array(m_id);
 }
 
 void VertexArray::unbind()
 {
-    glBindVertexArray(0);
+    RenderBackend::get().bind_vertex_array(0);
 }
 
-void VertexArray::enable_vertex_buffer()
+u32 VertexArray::add_vertex_format(const BufferLayout& layout, const u32 divisor)
 {
-    for (int i = 0; i < m_elements_count; ++i)
+    RenderBackend& backend = RenderBackend::get();
+    const u32 binding = m_bindings_count++;
+    for(const BufferElement& current_element : layout)
     {
-        glEnableVertexAttribArray(i);
+        backend.vertex_array_attribute(m_id,
+            m_elements_count,
+            binding,
+            static_cast<u32>(current_element.components_count),
+            current_element.component_type,
+            static_cast<u32>(current_element.offset));
+
+        ++m_elements_count;
     }
+    backend.vertex_array_binding_divisor(m_id, binding, divisor);
+    return binding;
 }
 
 void VertexArray::add_vertex_buffer(const VertexBuffer& vertex_buffer)
 {
-    bind();
-    vertex_buffer.bind();
+    bind_vertex_buffer(vertex_buffer, add_vertex_format(vertex_buffer.get_layout()));
+}
 
-    for(const BufferElement& current_element : vertex_buffer.get_layout().get_elements())
-    {
-        glEnableVertexAttribArray(m_elements_count);
-        glVertexAttribPointer(
-                    m_elements_count,
-                    static_cast<GLint>(current_element.components_count),
-                    current_element.component_type,
-                    GL_FALSE,
-                    static_cast<GLsizei>(vertex_buffer.get_layout().get_stride()),
-                    reinterpret_cast<const void*>(current_element.offset));
+void VertexArray::add_instance_buffer(const VertexBuffer& instance_buffer)
+{
+    bind_vertex_buffer(instance_buffer, add_vertex_format(instance_buffer.get_layout(), 1));
+}
 
-        ++m_elements_count;
-    }
+void VertexArray::bind_vertex_buffer(const VertexBuffer& vertex_buffer, const u32 binding, const size_t offset)
+{
+    RenderBackend::get().vertex_array_vertex_buffer(m_id,
+        binding,
+        vertex_buffer.get_id(),
+        offset,
+        static_cast<u32>(vertex_buffer.get_layout().get_stride()));
 }
 
 void VertexArray::set_index_buffer(const IndexBuffer& index_buffer)
 {
-    bind();
-    index_buffer.bind();
+    RenderBackend::get().vertex_array_element_buffer(m_id, index_buffer.get_id());
     m_indices_count = index_buffer.get_count();
 }
 
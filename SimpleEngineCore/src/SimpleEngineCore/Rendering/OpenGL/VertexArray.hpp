@@ -6,6 +6,9 @@
 
 namespace SimpleEngine {
 
+// Vertex attribute formats are configured once per binding point and kept
+// separate from the buffers attached to them, so a VertexArray describes a
+// vertex format and buffers are swapped with bind_vertex_buffer().
 class VertexArray
 {
 public:
@@ -16,9 +19,18 @@ public:
     VertexArray& operator=(const VertexArray&) = delete;
     VertexArray& operator=(VertexArray&& vertex_buffer) noexcept;
     VertexArray(VertexArray&& vertex_buffer) noexcept;
-    
-    void enable_vertex_buffer();
+
+    // Shared VAO for a layout with a single binding point 0; meshes with the
+    // same layout only swap the attached buffers instead of owning a VAO
+    static VertexArray& get_shared(const BufferLayout& layout);
+    static void release_shared();
+
+    // Adds the buffer's layout as a new binding point and attaches the buffer to it
     void add_vertex_buffer(const VertexBuffer& vertex_buffer);
+    void add_instance_buffer(const VertexBuffer& instance_buffer);
+    u32 add_vertex_format(const BufferLayout& layout, const u32 divisor = 0);
+
+    void bind_vertex_buffer(const VertexBuffer& vertex_buffer, const u32 binding = 0, const size_t offset = 0);
     void set_index_buffer(const IndexBuffer& index_buffer);
     void bind() const;
     static void unbind();
@@ -28,6 +40,7 @@ public:
 private:
     u32 m_id = 0;
     u32 m_elements_count = 0;
+    u32 m_bindings_count = 0;
     size_t m_indices_count = 0;
 };
 
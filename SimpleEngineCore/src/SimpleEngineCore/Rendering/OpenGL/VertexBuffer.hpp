@@ -1,6 +1,9 @@
 #ifndef VERTEX_BUFFER_HPP
 #define VERTEX_BUFFER_HPP
-#include <vector>
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+#include <glad/glad.h>
 #include "SimpleEngineCore/Types.hpp"
 
 namespace SimpleEngine {
@@ -17,41 +20,147 @@ enum class ShaderDataType
     Int4
 };
 
+constexpr u32 shader_data_type_to_components_count(const ShaderDataType type)
+{
+    switch (type)
+    {
+        case SimpleEngine::ShaderDataType::Float:
+        case SimpleEngine::ShaderDataType::Int:
+            return 1;
+
+        case SimpleEngine::ShaderDataType::Float2:
+        case SimpleEngine::ShaderDataType::Int2:
+            return 2;
+
+        case SimpleEngine::ShaderDataType::Float3:
+        case SimpleEngine::ShaderDataType::Int3:
+            return 3;
+
+        case SimpleEngine::ShaderDataType::Float4:
+        case SimpleEngine::ShaderDataType::Int4:
+            return 4;
+    }
+    return 0;
+}
+
+constexpr u32 shader_data_type_to_component_type(const ShaderDataType type)
+{
+    switch(type)
+    {
+    case SimpleEngine::ShaderDataType::Float:
+    case SimpleEngine::ShaderDataType::Float2:
+    case SimpleEngine::ShaderDataType::Float3:
+    case SimpleEngine::ShaderDataType::Float4:
+        return GL_FLOAT;
+
+    case SimpleEngine::ShaderDataType::Int:
+    case SimpleEngine::ShaderDataType::Int2:
+    case SimpleEngine::ShaderDataType::Int3:
+    case SimpleEngine::ShaderDataType::Int4:
+        return GL_INT;
+    }
+    return GL_FLOAT;
+}
+
+constexpr size_t shader_data_type_size(const ShaderDataType type)
+{
+    return (shader_data_type_to_component_type(type) == GL_INT ? sizeof(GLint) : sizeof(GLfloat))
+           * shader_data_type_to_components_count(type);
+}
+
 struct BufferElement
 {
-    ShaderDataType type;
-    u32 component_type;
-    size_t components_count;
-    size_t size;
-    size_t offset;
+    ShaderDataType type = ShaderDataType::Float;
+    u32 component_type = GL_FLOAT;
+    size_t components_count = 0;
+    size_t size = 0;
+    size_t offset = 0;
 
-    BufferElement(const ShaderDataType type);
+    constexpr BufferElement() = default;
+    constexpr BufferElement(const ShaderDataType type)
+        : type(type),
+          component_type(shader_data_type_to_component_type(type)),
+          components_count(shader_data_type_to_components_count(type)),
+          size(shader_data_type_size(type)),
+          offset(0)
+    {
+    }
 };
 
+// Fixed-capacity layout: building one never touches the heap and it can be
+// evaluated at compile time (see VertexLayout below)
 class BufferLayout
 {
 public:
-    BufferLayout(std::initializer_list<BufferElement> elements)
-        : m_elements(elements),
-          m_stride(0)
+    static constexpr size_t max_elements = 16;
+
+    // More than max_elements fails to compile in a constant expression and throws at run time
+    constexpr BufferLayout(std::initializer_list<BufferElement> elements)
     {
+        if (elements.size() > max_elements)
+        {
+            throw std::length_error("BufferLayout: more than max_elements elements");
+        }
         size_t offset = 0;
-        for(auto& element : m_elements)
+        for(BufferElement element : elements)
         {
             element.offset = offset;
             offset += element.size;
             m_stride += element.size;
+            m_elements[m_elements_count++] = element;
         }
     }
 
-    const std::vector<BufferElement>& get_elements() const { return m_elements; }
-    size_t get_stride() const { return m_stride; }
+    constexpr const BufferElement* begin() const { return m_elements.data(); }
+    constexpr const BufferElement* end() const { return m_elements.data() + m_elements_count; }
+    constexpr const BufferElement& operator[](const size_t index) const { return m_elements[index]; }
+    constexpr size_t get_elements_count() const { return m_elements_count; }
+    constexpr size_t get_stride() const { return m_stride; }
+
+    constexpr bool operator==(const BufferLayout& other) const
+    {
+        if (m_stride != other.m_stride || m_elements_count != other.m_elements_count)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < m_elements_count; ++i)
+        {
+            if (m_elements[i].type != other.m_elements[i].type || m_elements[i].offset != other.m_elements[i].offset)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
 private:
-    std::vector<BufferElement> m_elements;
+    std::array<BufferElement, max_elements> m_elements{};
+    size_t m_elements_count = 0;
     size_t m_stride = 0;
 };
 
+template<typename T> struct ShaderDataTypeOf;
+template<> struct ShaderDataTypeOf<float>     { static constexpr ShaderDataType value = ShaderDataType::Float; };
+template<> struct ShaderDataTypeOf<glm::vec2> { static constexpr ShaderDataType value = ShaderDataType::Float2; };
+template<> struct ShaderDataTypeOf<glm::vec3> { static constexpr ShaderDataType value = ShaderDataType::Float3; };
+template<> struct ShaderDataTypeOf<glm::vec4> { static constexpr ShaderDataType value = ShaderDataType::Float4; };
+template<> struct ShaderDataTypeOf<i32>        { static constexpr ShaderDataType value = ShaderDataType::Int; };
+template<> struct ShaderDataTypeOf<glm::ivec2> { static constexpr ShaderDataType value = ShaderDataType::Int2; };
+template<> struct ShaderDataTypeOf<glm::ivec3> { static constexpr ShaderDataType value = ShaderDataType::Int3; };
+template<> struct ShaderDataTypeOf<glm::ivec4> { static constexpr ShaderDataType value = ShaderDataType::Int4; };
+
+// Layout deduced from the C++ types of a vertex struct's members, in order.
+// Declare it next to the struct and static_assert it against sizeof/offsetof.
+template<typename... Attributes>
+struct VertexLayout
+{
+    static constexpr BufferLayout layout{ BufferElement(ShaderDataTypeOf<Attributes>::value)... };
+    static constexpr size_t stride = layout.get_stride();
+
+    static constexpr size_t offset(const size_t index) { return layout[index].offset; }
+    static constexpr u32 component_type(const size_t index) { return layout[index].component_type; }
+};
+
 class VertexBuffer
 {
 public:
@@ -72,13 +181,19 @@ public:
 
     void bind() const;
     static void unbind();
+    void update_buffer(const void* data, const size_t size, const size_t offset = 0) const;
+    // New storage under the same buffer name, so vertex arrays using it stay valid
+    void set_data(const void* data, const size_t size, const EUsage usage = VertexBuffer::EUsage::Static);
     const BufferLayout& get_layout() const { return m_buffer_layout; }
+    u32 get_id() const { return m_id; }
 
 private:
     u32 m_id = 0;
     BufferLayout m_buffer_layout;
 };
 
+GLenum usage_to_GLenum(const VertexBuffer::EUsage usage);
+
 }
 
 #endif // VERTEX_BUFFER_HPP
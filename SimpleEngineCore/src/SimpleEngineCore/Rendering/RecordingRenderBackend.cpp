@@ -0,0 +1,850 @@
+#include "RecordingRenderBackend.hpp"
+#include "SimpleEngineCore/Log.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace SimpleEngine {
+
+// Stream layout: per call one ECommand byte, then the arguments in declaration
+// order as raw little-endian values. Names returned by create_* follow their
+// arguments. Data is a u64 size, a presence byte and the bytes; strings are a
+// u32 length and the characters.
+enum class RecordingRenderBackend::ECommand : u8
+{
+    CreateBuffer,
+    DeleteBuffer,
+    BindBuffer,
+    BindBufferBase,
+    BufferData,
+    BufferSubData,
+    CreateVertexArray,
+    DeleteVertexArray,
+    BindVertexArray,
+    VertexArrayAttribute,
+    VertexArrayBindingDivisor,
+    VertexArrayVertexBuffer,
+    VertexArrayElementBuffer,
+    CreateTexture,
+    DeleteTexture,
+    ActiveTexture,
+    BindTexture,
+    TextureParameter,
+    TextureSubImage,
+    CopyTextureRegion,
+    CreateProgram,
+    DeleteProgram,
+    UseProgram,
+    GetUniformLocation,
+    SetUniformInt,
+    SetUniformFloat,
+    SetUniformVec3,
+    SetUniformMat4,
+    DrawArrays,
+    DrawElements,
+    MultiDrawElementsIndirect,
+    CreateQuery,
+    DeleteQuery,
+    QueryTimestamp,
+    IsQueryAvailable,
+    GetQueryResult,
+    GetTimestamp,
+    InsertFence,
+    IsFenceSignaled,
+    DeleteFence,
+    Count
+};
+
+static constexpr u32 commands_magic = 0x43524553; // "SERC"
+static constexpr u32 commands_version = 1;
+
+RecordingRenderBackend::RecordingRenderBackend(std::unique_ptr<RenderBackend> target)
+    : m_target(std::move(target))
+{
+}
+
+void RecordingRenderBackend::clear()
+{
+    m_commands.clear();
+    m_commands_count = 0;
+}
+
+void RecordingRenderBackend::begin(const ECommand command)
+{
+    write(command);
+    ++m_commands_count;
+}
+
+template <typename T>
+void RecordingRenderBackend::write(const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values go into the stream");
+    const u8* bytes = reinterpret_cast<const u8*>(&value);
+    m_commands.insert(m_commands.end(), bytes, bytes + sizeof(T));
+}
+
+void RecordingRenderBackend::write_data(const void* data, const size_t size)
+{
+    write(static_cast<u64>(size));
+    write(static_cast<u8>(data != nullptr));
+    if (data != nullptr)
+    {
+        const u8* bytes = static_cast<const u8*>(data);
+        m_commands.insert(m_commands.end(), bytes, bytes + size);
+    }
+}
+
+void RecordingRenderBackend::write_string(const char* text)
+{
+    const u32 length = static_cast<u32>(std::strlen(text));
+    write(length);
+    m_commands.insert(m_commands.end(), text, text + length);
+}
+
+u32 RecordingRenderBackend::create_buffer(const GLenum target, const size_t size, const void* data, const GLenum usage)
+{
+    const u32 buffer = m_target->create_buffer(target, size, data, usage);
+    begin(ECommand::CreateBuffer);
+    write(target);
+    write_data(data, size);
+    write(usage);
+    write(buffer);
+    return buffer;
+}
+
+void RecordingRenderBackend::delete_buffer(const u32 buffer)
+{
+    begin(ECommand::DeleteBuffer);
+    write(buffer);
+    m_target->delete_buffer(buffer);
+}
+
+void RecordingRenderBackend::bind_buffer(const GLenum target, const u32 buffer)
+{
+    begin(ECommand::BindBuffer);
+    write(target);
+    write(buffer);
+    m_target->bind_buffer(target, buffer);
+}
+
+void RecordingRenderBackend::bind_buffer_base(const GLenum target, const u32 index, const u32 buffer)
+{
+    begin(ECommand::BindBufferBase);
+    write(target);
+    write(index);
+    write(buffer);
+    m_target->bind_buffer_base(target, index, buffer);
+}
+
+void RecordingRenderBackend::buffer_data(const GLenum target, const u32 buffer, const size_t size, const void* data, const GLenum usage)
+{
+    begin(ECommand::BufferData);
+    write(target);
+    write(buffer);
+    write_data(data, size);
+    write(usage);
+    m_target->buffer_data(target, buffer, size, data, usage);
+}
+
+void RecordingRenderBackend::buffer_sub_data(const GLenum target, const u32 buffer, const size_t offset, const size_t size, const void* data)
+{
+    begin(ECommand::BufferSubData);
+    write(target);
+    write(buffer);
+    write(static_cast<u64>(offset));
+    write_data(data, size);
+    m_target->buffer_sub_data(target, buffer, offset, size, data);
+}
+
+u32 RecordingRenderBackend::create_vertex_array()
+{
+    const u32 vertex_array = m_target->create_vertex_array();
+    begin(ECommand::CreateVertexArray);
+    write(vertex_array);
+    return vertex_array;
+}
+
+void RecordingRenderBackend::delete_vertex_array(const u32 vertex_array)
+{
+    begin(ECommand::DeleteVertexArray);
+    write(vertex_array);
+    m_target->delete_vertex_array(vertex_array);
+}
+
+void RecordingRenderBackend::bind_vertex_array(const u32 vertex_array)
+{
+    begin(ECommand::BindVertexArray);
+    write(vertex_array);
+    m_target->bind_vertex_array(vertex_array);
+}
+
+void RecordingRenderBackend::vertex_array_attribute(const u32 vertex_array, const u32 attribute, const u32 binding,
+                                                    const u32 components_count, const GLenum component_type, const u32 offset)
+{
+    begin(ECommand::VertexArrayAttribute);
+    write(vertex_array);
+    write(attribute);
+    write(binding);
+    write(components_count);
+    write(component_type);
+    write(offset);
+    m_target->vertex_array_attribute(vertex_array, attribute, binding, components_count, component_type, offset);
+}
+
+void RecordingRenderBackend::vertex_array_binding_divisor(const u32 vertex_array, const u32 binding, const u32 divisor)
+{
+    begin(ECommand::VertexArrayBindingDivisor);
+    write(vertex_array);
+    write(binding);
+    write(divisor);
+    m_target->vertex_array_binding_divisor(vertex_array, binding, divisor);
+}
+
+void RecordingRenderBackend::vertex_array_vertex_buffer(const u32 vertex_array, const u32 binding, const u32 buffer,
+                                                        const size_t offset, const u32 stride)
+{
+    begin(ECommand::VertexArrayVertexBuffer);
+    write(vertex_array);
+    write(binding);
+    write(buffer);
+    write(static_cast<u64>(offset));
+    write(stride);
+    m_target->vertex_array_vertex_buffer(vertex_array, binding, buffer, offset, stride);
+}
+
+void RecordingRenderBackend::vertex_array_element_buffer(const u32 vertex_array, const u32 buffer)
+{
+    begin(ECommand::VertexArrayElementBuffer);
+    write(vertex_array);
+    write(buffer);
+    m_target->vertex_array_element_buffer(vertex_array, buffer);
+}
+
+u32 RecordingRenderBackend::create_texture(const GLenum type, const u32 levels_count, const GLenum internal_format,
+                                           const u32 width, const u32 height, const u32 depth)
+{
+    const u32 texture = m_target->create_texture(type, levels_count, internal_format, width, height, depth);
+    begin(ECommand::CreateTexture);
+    write(type);
+    write(levels_count);
+    write(internal_format);
+    write(width);
+    write(height);
+    write(depth);
+    write(texture);
+    return texture;
+}
+
+void RecordingRenderBackend::delete_texture(const u32 texture)
+{
+    begin(ECommand::DeleteTexture);
+    write(texture);
+    m_target->delete_texture(texture);
+}
+
+void RecordingRenderBackend::active_texture(const u32 unit)
+{
+    begin(ECommand::ActiveTexture);
+    write(unit);
+    m_target->active_texture(unit);
+}
+
+void RecordingRenderBackend::bind_texture(const GLenum type, const u32 texture)
+{
+    begin(ECommand::BindTexture);
+    write(type);
+    write(texture);
+    m_target->bind_texture(type, texture);
+}
+
+void RecordingRenderBackend::texture_parameter(const GLenum type, const u32 texture, const GLenum name, const i32 value)
+{
+    begin(ECommand::TextureParameter);
+    write(type);
+    write(texture);
+    write(name);
+    write(value);
+    m_target->texture_parameter(type, texture, name, value);
+}
+
+void RecordingRenderBackend::texture_sub_image(const TextureRegion& region, const GLenum format, const GLenum pixel_type,
+                                               const size_t size, const void* data)
+{
+    begin(ECommand::TextureSubImage);
+    write(region);
+    write(format);
+    write(pixel_type);
+    write_data(data, size);
+    m_target->texture_sub_image(region, format, pixel_type, size, data);
+}
+
+void RecordingRenderBackend::copy_texture_region(const TextureRegion& source, const TextureRegion& target)
+{
+    begin(ECommand::CopyTextureRegion);
+    write(source);
+    write(target);
+    m_target->copy_texture_region(source, target);
+}
+
+u32 RecordingRenderBackend::begin_program(const char* vertex_source, const char* fragment_source)
+{
+    const u32 program = m_target->begin_program(vertex_source, fragment_source);
+    begin(ECommand::CreateProgram);
+    write_string(vertex_source);
+    write_string(fragment_source);
+    write(program);
+    return program;
+}
+
+// Not recorded: replay builds each program as soon as it is created
+bool RecordingRenderBackend::is_program_ready(const u32 program)
+{
+    return m_target->is_program_ready(program);
+}
+
+bool RecordingRenderBackend::finish_program(const u32 program, std::string& error_log)
+{
+    return m_target->finish_program(program, error_log);
+}
+
+void RecordingRenderBackend::delete_program(const u32 program)
+{
+    begin(ECommand::DeleteProgram);
+    write(program);
+    m_target->delete_program(program);
+}
+
+void RecordingRenderBackend::use_program(const u32 program)
+{
+    begin(ECommand::UseProgram);
+    write(program);
+    m_target->use_program(program);
+}
+
+i32 RecordingRenderBackend::get_uniform_location(const u32 program, const char* name)
+{
+    const i32 location = m_target->get_uniform_location(program, name);
+    begin(ECommand::GetUniformLocation);
+    write(program);
+    write_string(name);
+    write(location);
+    return location;
+}
+
+void RecordingRenderBackend::set_uniform(const i32 location, const i32 value)
+{
+    begin(ECommand::SetUniformInt);
+    write(location);
+    write(value);
+    m_target->set_uniform(location, value);
+}
+
+void RecordingRenderBackend::set_uniform(const i32 location, const float value)
+{
+    begin(ECommand::SetUniformFloat);
+    write(location);
+    write(value);
+    m_target->set_uniform(location, value);
+}
+
+void RecordingRenderBackend::set_uniform(const i32 location, const glm::vec3& value)
+{
+    begin(ECommand::SetUniformVec3);
+    write(location);
+    write(value);
+    m_target->set_uniform(location, value);
+}
+
+void RecordingRenderBackend::set_uniform(const i32 location, const glm::mat4& value)
+{
+    begin(ECommand::SetUniformMat4);
+    write(location);
+    write(value);
+    m_target->set_uniform(location, value);
+}
+
+void RecordingRenderBackend::draw_arrays(const GLenum mode, const u32 first, const u32 count, const u32 instances_count)
+{
+    begin(ECommand::DrawArrays);
+    write(mode);
+    write(first);
+    write(count);
+    write(instances_count);
+    m_target->draw_arrays(mode, first, count, instances_count);
+}
+
+void RecordingRenderBackend::draw_elements(const GLenum mode, const u32 count, const size_t offset, const u32 instances_count)
+{
+    begin(ECommand::DrawElements);
+    write(mode);
+    write(count);
+    write(static_cast<u64>(offset));
+    write(instances_count);
+    m_target->draw_elements(mode, count, offset, instances_count);
+}
+
+void RecordingRenderBackend::multi_draw_elements_indirect(const GLenum mode, const size_t offset, const u32 draws_count)
+{
+    begin(ECommand::MultiDrawElementsIndirect);
+    write(mode);
+    write(static_cast<u64>(offset));
+    write(draws_count);
+    m_target->multi_draw_elements_indirect(mode, offset, draws_count);
+}
+
+u32 RecordingRenderBackend::create_query()
+{
+    const u32 query = m_target->create_query();
+    begin(ECommand::CreateQuery);
+    write(query);
+    return query;
+}
+
+void RecordingRenderBackend::delete_query(const u32 query)
+{
+    begin(ECommand::DeleteQuery);
+    write(query);
+    m_target->delete_query(query);
+}
+
+void RecordingRenderBackend::query_timestamp(const u32 query)
+{
+    begin(ECommand::QueryTimestamp);
+    write(query);
+    m_target->query_timestamp(query);
+}
+
+bool RecordingRenderBackend::is_query_available(const u32 query)
+{
+    begin(ECommand::IsQueryAvailable);
+    write(query);
+    return m_target->is_query_available(query);
+}
+
+u64 RecordingRenderBackend::get_query_result(const u32 query)
+{
+    begin(ECommand::GetQueryResult);
+    write(query);
+    return m_target->get_query_result(query);
+}
+
+u64 RecordingRenderBackend::get_timestamp()
+{
+    begin(ECommand::GetTimestamp);
+    return m_target->get_timestamp();
+}
+
+u32 RecordingRenderBackend::insert_fence()
+{
+    const u32 fence = m_target->insert_fence();
+    begin(ECommand::InsertFence);
+    write(fence);
+    return fence;
+}
+
+bool RecordingRenderBackend::is_fence_signaled(const u32 fence)
+{
+    begin(ECommand::IsFenceSignaled);
+    write(fence);
+    return m_target->is_fence_signaled(fence);
+}
+
+void RecordingRenderBackend::delete_fence(const u32 fence)
+{
+    begin(ECommand::DeleteFence);
+    write(fence);
+    m_target->delete_fence(fence);
+}
+
+bool RecordingRenderBackend::save(const char* path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        LOG_ERROR("Recording: can't write '{0}'", path);
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&commands_magic), sizeof(commands_magic));
+    out.write(reinterpret_cast<const char*>(&commands_version), sizeof(commands_version));
+    out.write(reinterpret_cast<const char*>(m_commands.data()), static_cast<std::streamsize>(m_commands.size()));
+    return static_cast<bool>(out);
+}
+
+bool RecordingRenderBackend::load(const char* path, std::vector<u8>& commands)
+{
+    std::ifstream in(path, std::ios::binary);
+    u32 magic = 0;
+    u32 version = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in || magic != commands_magic || version != commands_version)
+    {
+        LOG_ERROR("Recording: '{0}' is not a command stream", path);
+        return false;
+    }
+    commands.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+namespace {
+
+class CommandReader
+{
+public:
+    explicit CommandReader(const std::vector<u8>& commands)
+        : m_position(commands.data()), m_end(commands.data() + commands.size())
+    {
+    }
+
+    bool at_end() const { return m_position == m_end; }
+    bool is_valid() const { return m_valid; }
+
+    template <typename T>
+    T read()
+    {
+        T value{};
+        if (!take(sizeof(T)))
+        {
+            return value;
+        }
+        std::memcpy(&value, m_position - sizeof(T), sizeof(T));
+        return value;
+    }
+
+    // nullptr when the call passed no data (or the stream is cut short)
+    const void* read_data(size_t& size)
+    {
+        size = static_cast<size_t>(read<u64>());
+        if (read<u8>() == 0 || !take(size))
+        {
+            return nullptr;
+        }
+        return m_position - size;
+    }
+
+    std::string read_string()
+    {
+        const u32 length = read<u32>();
+        if (!take(length))
+        {
+            return std::string();
+        }
+        return std::string(reinterpret_cast<const char*>(m_position - length), length);
+    }
+
+private:
+    bool take(const size_t size)
+    {
+        if (!m_valid || static_cast<size_t>(m_end - m_position) < size)
+        {
+            m_valid = false;
+            return false;
+        }
+        m_position += size;
+        return true;
+    }
+
+    const u8* m_position;
+    const u8* m_end;
+    bool m_valid = true;
+};
+
+// Recorded name -> name on the replay target; unknown names pass through
+class NameMap
+{
+public:
+    void add(const u32 recorded, const u32 replayed) { m_names[recorded] = replayed; }
+    u32 operator()(const u32 recorded) const
+    {
+        const auto it = m_names.find(recorded);
+        return it != m_names.end() ? it->second : recorded;
+    }
+
+private:
+    std::unordered_map<u32, u32> m_names;
+};
+
+}
+
+bool RecordingRenderBackend::replay(const std::vector<u8>& commands, RenderBackend& target)
+{
+    CommandReader reader(commands);
+    NameMap buffers;
+    NameMap vertex_arrays;
+    NameMap textures;
+    NameMap programs;
+    NameMap queries;
+    NameMap fences;
+    // (recorded program, recorded location) -> location on the target
+    std::unordered_map<u64, i32> locations;
+    u32 recorded_program = 0;
+
+    const auto location = [&](const i32 recorded)
+    {
+        const auto it = locations.find((u64(recorded_program) << 32) | static_cast<u32>(recorded));
+        return it != locations.end() ? it->second : recorded;
+    };
+    const auto texture_region = [&]()
+    {
+        TextureRegion region = reader.read<TextureRegion>();
+        region.texture = textures(region.texture);
+        return region;
+    };
+
+    while (!reader.at_end() && reader.is_valid())
+    {
+        const ECommand command = reader.read<ECommand>();
+        switch (command)
+        {
+        case ECommand::CreateBuffer:
+        {
+            const GLenum buffer_target = reader.read<GLenum>();
+            size_t size = 0;
+            const void* data = reader.read_data(size);
+            const GLenum usage = reader.read<GLenum>();
+            buffers.add(reader.read<u32>(), target.create_buffer(buffer_target, size, data, usage));
+            break;
+        }
+        case ECommand::DeleteBuffer:
+            target.delete_buffer(buffers(reader.read<u32>()));
+            break;
+        case ECommand::BindBuffer:
+        {
+            const GLenum buffer_target = reader.read<GLenum>();
+            target.bind_buffer(buffer_target, buffers(reader.read<u32>()));
+            break;
+        }
+        case ECommand::BindBufferBase:
+        {
+            const GLenum buffer_target = reader.read<GLenum>();
+            const u32 index = reader.read<u32>();
+            target.bind_buffer_base(buffer_target, index, buffers(reader.read<u32>()));
+            break;
+        }
+        case ECommand::BufferData:
+        {
+            const GLenum buffer_target = reader.read<GLenum>();
+            const u32 buffer = buffers(reader.read<u32>());
+            size_t size = 0;
+            const void* data = reader.read_data(size);
+            target.buffer_data(buffer_target, buffer, size, data, reader.read<GLenum>());
+            break;
+        }
+        case ECommand::BufferSubData:
+        {
+            const GLenum buffer_target = reader.read<GLenum>();
+            const u32 buffer = buffers(reader.read<u32>());
+            const size_t offset = static_cast<size_t>(reader.read<u64>());
+            size_t size = 0;
+            const void* data = reader.read_data(size);
+            target.buffer_sub_data(buffer_target, buffer, offset, size, data);
+            break;
+        }
+        case ECommand::CreateVertexArray:
+            vertex_arrays.add(reader.read<u32>(), target.create_vertex_array());
+            break;
+        case ECommand::DeleteVertexArray:
+            target.delete_vertex_array(vertex_arrays(reader.read<u32>()));
+            break;
+        case ECommand::BindVertexArray:
+            target.bind_vertex_array(vertex_arrays(reader.read<u32>()));
+            break;
+        case ECommand::VertexArrayAttribute:
+        {
+            const u32 vertex_array = vertex_arrays(reader.read<u32>());
+            const u32 attribute = reader.read<u32>();
+            const u32 binding = reader.read<u32>();
+            const u32 components_count = reader.read<u32>();
+            const GLenum component_type = reader.read<GLenum>();
+            target.vertex_array_attribute(vertex_array, attribute, binding, components_count, component_type, reader.read<u32>());
+            break;
+        }
+        case ECommand::VertexArrayBindingDivisor:
+        {
+            const u32 vertex_array = vertex_arrays(reader.read<u32>());
+            const u32 binding = reader.read<u32>();
+            target.vertex_array_binding_divisor(vertex_array, binding, reader.read<u32>());
+            break;
+        }
+        case ECommand::VertexArrayVertexBuffer:
+        {
+            const u32 vertex_array = vertex_arrays(reader.read<u32>());
+            const u32 binding = reader.read<u32>();
+            const u32 buffer = buffers(reader.read<u32>());
+            const size_t offset = static_cast<size_t>(reader.read<u64>());
+            target.vertex_array_vertex_buffer(vertex_array, binding, buffer, offset, reader.read<u32>());
+            break;
+        }
+        case ECommand::VertexArrayElementBuffer:
+        {
+            const u32 vertex_array = vertex_arrays(reader.read<u32>());
+            target.vertex_array_element_buffer(vertex_array, buffers(reader.read<u32>()));
+            break;
+        }
+        case ECommand::CreateTexture:
+        {
+            const GLenum type = reader.read<GLenum>();
+            const u32 levels_count = reader.read<u32>();
+            const GLenum internal_format = reader.read<GLenum>();
+            const u32 width = reader.read<u32>();
+            const u32 height = reader.read<u32>();
+            const u32 depth = reader.read<u32>();
+            textures.add(reader.read<u32>(), target.create_texture(type, levels_count, internal_format, width, height, depth));
+            break;
+        }
+        case ECommand::DeleteTexture:
+            target.delete_texture(textures(reader.read<u32>()));
+            break;
+        case ECommand::ActiveTexture:
+            target.active_texture(reader.read<u32>());
+            break;
+        case ECommand::BindTexture:
+        {
+            const GLenum type = reader.read<GLenum>();
+            target.bind_texture(type, textures(reader.read<u32>()));
+            break;
+        }
+        case ECommand::TextureParameter:
+        {
+            const GLenum type = reader.read<GLenum>();
+            const u32 texture = textures(reader.read<u32>());
+            const GLenum name = reader.read<GLenum>();
+            target.texture_parameter(type, texture, name, reader.read<i32>());
+            break;
+        }
+        case ECommand::TextureSubImage:
+        {
+            const TextureRegion region = texture_region();
+            const GLenum format = reader.read<GLenum>();
+            const GLenum pixel_type = reader.read<GLenum>();
+            size_t size = 0;
+            const void* data = reader.read_data(size);
+            target.texture_sub_image(region, format, pixel_type, size, data);
+            break;
+        }
+        case ECommand::CopyTextureRegion:
+        {
+            const TextureRegion source = texture_region();
+            target.copy_texture_region(source, texture_region());
+            break;
+        }
+        case ECommand::CreateProgram:
+        {
+            const std::string vertex_source = reader.read_string();
+            const std::string fragment_source = reader.read_string();
+            const u32 recorded = reader.read<u32>();
+            std::string error_log;
+            const u32 program = target.create_program(vertex_source.c_str(), fragment_source.c_str(), error_log);
+            if (program == 0 && recorded != 0)
+            {
+                LOG_ERROR("Replay: program failed to build:\n{0}", error_log);
+            }
+            programs.add(recorded, program);
+            break;
+        }
+        case ECommand::DeleteProgram:
+            target.delete_program(programs(reader.read<u32>()));
+            break;
+        case ECommand::UseProgram:
+            recorded_program = reader.read<u32>();
+            target.use_program(programs(recorded_program));
+            break;
+        case ECommand::GetUniformLocation:
+        {
+            const u32 program = reader.read<u32>();
+            const std::string name = reader.read_string();
+            const i32 recorded = reader.read<i32>();
+            locations[(u64(program) << 32) | static_cast<u32>(recorded)] = target.get_uniform_location(programs(program), name.c_str());
+            break;
+        }
+        case ECommand::SetUniformInt:
+        {
+            const i32 recorded = reader.read<i32>();
+            target.set_uniform(location(recorded), reader.read<i32>());
+            break;
+        }
+        case ECommand::SetUniformFloat:
+        {
+            const i32 recorded = reader.read<i32>();
+            target.set_uniform(location(recorded), reader.read<float>());
+            break;
+        }
+        case ECommand::SetUniformVec3:
+        {
+            const i32 recorded = reader.read<i32>();
+            target.set_uniform(location(recorded), reader.read<glm::vec3>());
+            break;
+        }
+        case ECommand::SetUniformMat4:
+        {
+            const i32 recorded = reader.read<i32>();
+            target.set_uniform(location(recorded), reader.read<glm::mat4>());
+            break;
+        }
+        case ECommand::DrawArrays:
+        {
+            const GLenum mode = reader.read<GLenum>();
+            const u32 first = reader.read<u32>();
+            const u32 count = reader.read<u32>();
+            target.draw_arrays(mode, first, count, reader.read<u32>());
+            break;
+        }
+        case ECommand::DrawElements:
+        {
+            const GLenum mode = reader.read<GLenum>();
+            const u32 count = reader.read<u32>();
+            const size_t offset = static_cast<size_t>(reader.read<u64>());
+            target.draw_elements(mode, count, offset, reader.read<u32>());
+            break;
+        }
+        case ECommand::MultiDrawElementsIndirect:
+        {
+            const GLenum mode = reader.read<GLenum>();
+            const size_t offset = static_cast<size_t>(reader.read<u64>());
+            target.multi_draw_elements_indirect(mode, offset, reader.read<u32>());
+            break;
+        }
+        case ECommand::CreateQuery:
+            queries.add(reader.read<u32>(), target.create_query());
+            break;
+        case ECommand::DeleteQuery:
+            target.delete_query(queries(reader.read<u32>()));
+            break;
+        case ECommand::QueryTimestamp:
+            target.query_timestamp(queries(reader.read<u32>()));
+            break;
+        case ECommand::IsQueryAvailable:
+            target.is_query_available(queries(reader.read<u32>()));
+            break;
+        case ECommand::GetQueryResult:
+            target.get_query_result(queries(reader.read<u32>()));
+            break;
+        case ECommand::GetTimestamp:
+            target.get_timestamp();
+            break;
+        case ECommand::InsertFence:
+            fences.add(reader.read<u32>(), target.insert_fence());
+            break;
+        case ECommand::IsFenceSignaled:
+            target.is_fence_signaled(fences(reader.read<u32>()));
+            break;
+        case ECommand::DeleteFence:
+            target.delete_fence(fences(reader.read<u32>()));
+            break;
+        default:
+            LOG_ERROR("Replay: unknown command {0}", static_cast<u32>(command));
+            return false;
+        }
+    }
+
+    if (!reader.is_valid())
+    {
+        LOG_ERROR("Replay: command stream is cut short");
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,38 @@
+#include "RenderBackend.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/OpenGLRenderBackend.hpp"
+
+namespace SimpleEngine {
+
+static std::unique_ptr<RenderBackend> s_p_render_backend;
+
+RenderBackend& RenderBackend::get()
+{
+    if (s_p_render_backend == nullptr)
+    {
+        s_p_render_backend = std::make_unique<OpenGLRenderBackend>();
+    }
+    return *s_p_render_backend;
+}
+
+void RenderBackend::set(std::unique_ptr<RenderBackend> backend)
+{
+    s_p_render_backend = std::move(backend);
+}
+
+void RenderBackend::release()
+{
+    s_p_render_backend.reset();
+}
+
+u32 RenderBackend::create_program(const char* vertex_source, const char* fragment_source, std::string& error_log)
+{
+    const u32 program = begin_program(vertex_source, fragment_source);
+    if (!finish_program(program, error_log))
+    {
+        delete_program(program);
+        return 0;
+    }
+    return program;
+}
+
+}
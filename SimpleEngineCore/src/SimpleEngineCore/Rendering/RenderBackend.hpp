@@ -0,0 +1,122 @@
+#ifndef RENDER_BACKEND_HPP
+#define RENDER_BACKEND_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <memory>
+#include <string>
+#include <glad/glad.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace SimpleEngine {
+
+// Part of one texture level; depth counts array layers for array textures
+struct TextureRegion
+{
+    GLenum type = GL_TEXTURE_2D;
+    u32 texture = 0;
+    i32 level = 0;
+    u32 x = 0;
+    u32 y = 0;
+    u32 z = 0;
+    u32 width = 0;
+    u32 height = 0;
+    u32 depth = 1;
+};
+
+// Everything the renderer asks of the graphics API. The vocabulary is OpenGL's
+// (enums are GL values, objects are u32 names) so the GL backend stays a thin
+// forwarder; other backends only have to agree on the meaning. The window
+// owns the context and still talks to GL directly, as does ImGui.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    // OpenGL until set() is called. Objects keep the backend they were created
+    // with in mind, so switch before creating any.
+    static RenderBackend& get();
+    static void set(std::unique_ptr<RenderBackend> backend);
+    static void release();
+
+    virtual const char* get_name() const = 0;
+
+    // Buffers
+    virtual u32 create_buffer(const GLenum target, const size_t size, const void* data, const GLenum usage) = 0;
+    virtual void delete_buffer(const u32 buffer) = 0;
+    virtual void bind_buffer(const GLenum target, const u32 buffer) = 0;
+    virtual void bind_buffer_base(const GLenum target, const u32 index, const u32 buffer) = 0;
+    // Reallocates the storage; the old contents are lost
+    virtual void buffer_data(const GLenum target, const u32 buffer, const size_t size, const void* data, const GLenum usage) = 0;
+    virtual void buffer_sub_data(const GLenum target, const u32 buffer, const size_t offset, const size_t size, const void* data) = 0;
+
+    // Vertex arrays with separate attribute formats and buffer bindings
+    virtual u32 create_vertex_array() = 0;
+    virtual void delete_vertex_array(const u32 vertex_array) = 0;
+    virtual void bind_vertex_array(const u32 vertex_array) = 0;
+    // Enables `attribute` and sources it from `binding`; GL_INT components stay integers
+    virtual void vertex_array_attribute(const u32 vertex_array, const u32 attribute, const u32 binding,
+                                        const u32 components_count, const GLenum component_type, const u32 offset) = 0;
+    virtual void vertex_array_binding_divisor(const u32 vertex_array, const u32 binding, const u32 divisor) = 0;
+    virtual void vertex_array_vertex_buffer(const u32 vertex_array, const u32 binding, const u32 buffer,
+                                            const size_t offset, const u32 stride) = 0;
+    virtual void vertex_array_element_buffer(const u32 vertex_array, const u32 buffer) = 0;
+
+    // Textures, always immutable storage; depth > 1 only for array textures
+    virtual u32 create_texture(const GLenum type, const u32 levels_count, const GLenum internal_format,
+                               const u32 width, const u32 height, const u32 depth) = 0;
+    virtual void delete_texture(const u32 texture) = 0;
+    // unit is 0-based, not GL_TEXTURE0-based
+    virtual void active_texture(const u32 unit) = 0;
+    virtual void bind_texture(const GLenum type, const u32 texture) = 0;
+    virtual void texture_parameter(const GLenum type, const u32 texture, const GLenum name, const i32 value) = 0;
+    // `size` bytes of texels in `format`/`pixel_type`; for compressed uploads
+    // `format` is the compressed internal format and `pixel_type` is 0
+    virtual void texture_sub_image(const TextureRegion& region, const GLenum format, const GLenum pixel_type,
+                                   const size_t size, const void* data) = 0;
+    virtual void copy_texture_region(const TextureRegion& source, const TextureRegion& target) = 0;
+
+    // Shader programs. begin_program() hands the sources to the driver and
+    // returns without waiting for them to compile, so several programs can
+    // build at once; is_program_ready() polls without blocking and
+    // finish_program() waits, false with the reason in error_log. A failed
+    // program still has to be deleted. Without GL_KHR_parallel_shader_compile
+    // OpenGL can't be polled: a program reads as ready on the poll after the
+    // first, and finish_program() may still stall on the rest of the build.
+    virtual u32 begin_program(const char* vertex_source, const char* fragment_source) = 0;
+    virtual bool is_program_ready(const u32 program) = 0;
+    virtual bool finish_program(const u32 program, std::string& error_log) = 0;
+    // Both steps at once; 0 when compiling or linking fails
+    u32 create_program(const char* vertex_source, const char* fragment_source, std::string& error_log);
+    virtual void delete_program(const u32 program) = 0;
+    virtual void use_program(const u32 program) = 0;
+    virtual i32 get_uniform_location(const u32 program, const char* name) = 0;
+    // Uniforms of the program in use
+    virtual void set_uniform(const i32 location, const i32 value) = 0;
+    virtual void set_uniform(const i32 location, const float value) = 0;
+    virtual void set_uniform(const i32 location, const glm::vec3& value) = 0;
+    virtual void set_uniform(const i32 location, const glm::mat4& value) = 0;
+
+    // Draws with the bound program, vertex array and textures; indices are u32
+    virtual void draw_arrays(const GLenum mode, const u32 first, const u32 count, const u32 instances_count) = 0;
+    virtual void draw_elements(const GLenum mode, const u32 count, const size_t offset, const u32 instances_count) = 0;
+    // Commands come from the bound GL_DRAW_INDIRECT_BUFFER starting at `offset`
+    virtual void multi_draw_elements_indirect(const GLenum mode, const size_t offset, const u32 draws_count) = 0;
+
+    // GPU timestamps, in nanoseconds
+    virtual u32 create_query() = 0;
+    virtual void delete_query(const u32 query) = 0;
+    virtual void query_timestamp(const u32 query) = 0;
+    virtual bool is_query_available(const u32 query) = 0;
+    virtual u64 get_query_result(const u32 query) = 0;
+    virtual u64 get_timestamp() = 0;
+
+    // Signaled once the GPU has finished every command issued before it
+    virtual u32 insert_fence() = 0;
+    virtual bool is_fence_signaled(const u32 fence) = 0;
+    virtual void delete_fence(const u32 fence) = 0;
+};
+
+}
+
+#endif // RENDER_BACKEND_HPP
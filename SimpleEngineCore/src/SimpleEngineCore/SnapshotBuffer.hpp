@@ -0,0 +1,85 @@
+#ifndef SNAPSHOT_BUFFER_HPP
+#define SNAPSHOT_BUFFER_HPP
+#include "SimpleEngineCore/Types.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+namespace SimpleEngine {
+
+// Triple buffer handing whole snapshots from one producer thread to one
+// consumer thread. The producer fills write_slot() and publishes it; the
+// consumer takes the latest published one. Neither ever touches the slot the
+// other is using, so a snapshot is immutable while it is being consumed.
+// publish() waits while the previous snapshot has not been taken yet, so at
+// most one snapshot is ever queued and none are dropped.
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    T& write_slot() noexcept { return m_slots[m_write]; }
+
+    // False once close() was called
+    bool publish()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taken.wait(lock, [this]() { return !m_has_ready || m_closed; });
+        if (m_closed)
+        {
+            return false;
+        }
+        std::swap(m_write, m_ready);
+        m_has_ready = true;
+        m_published.notify_one();
+        return true;
+    }
+
+    // Waits for a snapshot newer than the last one taken. It stays valid
+    // until the next acquire(); nullptr once closed.
+    const T* acquire()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_published.wait(lock, [this]() { return m_has_ready || m_closed; });
+        if (m_closed)
+        {
+            return nullptr;
+        }
+        std::swap(m_read, m_ready);
+        m_has_ready = false;
+        m_taken.notify_one();
+        return &m_slots[m_read];
+    }
+
+    // Wakes both sides; a snapshot still waiting is dropped
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_published.notify_all();
+        m_taken.notify_all();
+    }
+
+    // Only while neither side is running
+    void reopen()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = false;
+        m_has_ready = false;
+    }
+
+private:
+    std::array<T, 3> m_slots;
+    size_t m_write = 0;
+    size_t m_ready = 1;
+    size_t m_read = 2;
+    bool m_has_ready = false;
+    bool m_closed = false;
+    std::mutex m_mutex;
+    std::condition_variable m_published;
+    std::condition_variable m_taken;
+};
+
+}
+
+#endif // SNAPSHOT_BUFFER_HPP
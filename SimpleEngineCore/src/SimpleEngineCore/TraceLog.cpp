@@ -0,0 +1,209 @@
+#include "SimpleEngineCore/TraceLog.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <iterator>
+
+namespace SimpleEngine {
+
+static spdlog::level::level_enum to_spdlog_level(const ETraceLevel level)
+{
+    switch (level)
+    {
+        case ETraceLevel::Info:     return spdlog::level::info;
+        case ETraceLevel::Warn:     return spdlog::level::warn;
+        case ETraceLevel::Error:    return spdlog::level::err;
+        case ETraceLevel::Critical: return spdlog::level::critical;
+        case ETraceLevel::Off:      break;
+    }
+    return spdlog::level::off;
+}
+
+TraceLog& TraceLog::get()
+{
+    static TraceLog trace_log;
+    return trace_log;
+}
+
+TraceLog::TraceLog()
+{
+    // Records are flushed to the default logger on destruction, so it has to outlive us
+    spdlog::default_logger();
+    m_flush_thread = std::thread(&TraceLog::flush_loop, this);
+}
+
+TraceLog::~TraceLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_flush_mutex);
+        m_stopping = true;
+    }
+    m_flush_wake.notify_all();
+    m_flush_thread.join();
+    flush();
+}
+
+TraceLog::ThreadRing& TraceLog::thread_ring()
+{
+    // The owner's guarded access stays off the hot path
+    thread_local ThreadRing* ring = nullptr;
+
+    // m_rings owns the ring too, so records still get out after their thread
+    // exits; the owner only flags it then, flush() drops it once drained
+    struct RingOwner
+    {
+        std::shared_ptr<ThreadRing> owned;
+        ~RingOwner()
+        {
+            if (owned != nullptr)
+            {
+                ring = nullptr;
+                owned->abandoned.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    if (ring == nullptr)
+    {
+        thread_local RingOwner owner;
+        owner.owned = std::make_shared<ThreadRing>();
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        m_rings.push_back(owner.owned);
+        ring = owner.owned.get();
+    }
+    return *ring;
+}
+
+bool TraceLog::pass_rate_limit(TraceSite& site, const std::chrono::system_clock::time_point time)
+{
+    const u32 rate_limit = m_rate_limit.load(std::memory_order_relaxed);
+    if (rate_limit == 0)
+    {
+        return true;
+    }
+
+    // Racing threads may both start a window or count as one, without a locked
+    // increment per record; that only lets a few more through
+    const i64 now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    const i64 window_start_ns = site.window_start_ns.load(std::memory_order_relaxed);
+    if (now_ns - window_start_ns >= 1000000000 || now_ns < window_start_ns)
+    {
+        site.window_start_ns.store(now_ns, std::memory_order_relaxed);
+        site.window_count.store(1, std::memory_order_relaxed);
+        return true;
+    }
+    const u32 window_count = site.window_count.load(std::memory_order_relaxed);
+    if (window_count < rate_limit)
+    {
+        site.window_count.store(window_count + 1, std::memory_order_relaxed);
+        return true;
+    }
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+unsigned char* TraceLog::reserve(ThreadRing& ring, const size_t max_size)
+{
+    const size_t write = ring.write.load(std::memory_order_relaxed);
+    const size_t offset = write % ring_capacity;
+    // A record that could reach past the end starts over at the beginning
+    const size_t skipped = offset + max_size > ring_capacity ? ring_capacity - offset : 0;
+    if (ring_capacity - (write - ring.read.load(std::memory_order_acquire)) < skipped + max_size)
+    {
+        m_dropped_records.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    // Shorter than a header, the reader skips it on its own
+    if (skipped >= sizeof(RecordHeader))
+    {
+        const RecordHeader skip{};
+        std::memcpy(ring.data + offset, &skip, sizeof(RecordHeader));
+    }
+    ring.reserved = write + skipped;
+    return ring.data + ring.reserved % ring_capacity;
+}
+
+void TraceLog::flush()
+{
+    std::lock_guard<std::mutex> drain_lock(m_drain_mutex);
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        rings = m_rings;
+    }
+
+    const std::shared_ptr<spdlog::logger> logger = spdlog::default_logger();
+    // Threads are drained one after the other: records of different threads
+    // may come out of order, those of one thread never do
+    for (const std::shared_ptr<ThreadRing>& ring : rings)
+    {
+        size_t read = ring->read.load(std::memory_order_relaxed);
+        const size_t write = ring->write.load(std::memory_order_acquire);
+        while (read != write)
+        {
+            const size_t offset = read % ring_capacity;
+            RecordHeader header{};
+            if (ring_capacity - offset >= sizeof(RecordHeader))
+            {
+                std::memcpy(&header, ring->data + offset, sizeof(RecordHeader));
+            }
+            if (header.site == nullptr)
+            {
+                read += ring_capacity - offset;
+                continue;
+            }
+
+            m_message.clear();
+            try
+            {
+                header.decode(m_message, header.format, ring->data + offset + sizeof(RecordHeader));
+            }
+            catch (const fmt::format_error& e)
+            {
+                m_message.clear();
+                fmt::format_to(std::back_inserter(m_message), "{0} (bad format: {1})", header.format, e.what());
+            }
+            read += (sizeof(RecordHeader) + header.size + alignof(RecordHeader) - 1) & ~(alignof(RecordHeader) - 1);
+            if (header.suppressed > 0)
+            {
+                fmt::format_to(std::back_inserter(m_message), " ({0} more suppressed by the rate limit)", header.suppressed);
+            }
+            const spdlog::source_loc location(header.site->file, static_cast<int>(header.site->line), nullptr);
+            logger->log(header.time, location, to_spdlog_level(header.site->level), spdlog::string_view_t(m_message.data(), m_message.size()));
+        }
+        ring->read.store(read, std::memory_order_release);
+    }
+
+    {
+        // Nothing is written after `abandoned` is set, so an empty ring of an
+        // exited thread stays empty. Reads only move under m_drain_mutex.
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const std::shared_ptr<ThreadRing>& ring)
+        {
+            return ring->abandoned.load(std::memory_order_acquire)
+                && ring->read.load(std::memory_order_relaxed) == ring->write.load(std::memory_order_relaxed);
+        }), m_rings.end());
+    }
+
+    const u64 dropped = m_dropped_records.load(std::memory_order_relaxed);
+    if (dropped != m_reported_dropped_records)
+    {
+        logger->warn("TraceLog: {0} records dropped on full rings", dropped - m_reported_dropped_records);
+        m_reported_dropped_records = dropped;
+    }
+    logger->flush();
+}
+
+void TraceLog::flush_loop()
+{
+    std::unique_lock<std::mutex> lock(m_flush_mutex);
+    while (!m_stopping)
+    {
+        m_flush_wake.wait_for(lock, flush_interval, [this]() { return m_stopping; });
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+}
@@ -1,5 +1,10 @@
 #include "SimpleEngineCore/Window.hpp"
+#include "SimpleEngineCore/AllocationTracker.hpp"
+#include "SimpleEngineCore/AssetReloader.hpp"
+#include "SimpleEngineCore/FramePacer.hpp"
 #include "SimpleEngineCore/Log.hpp"
+#include "SimpleEngineCore/Memory.hpp"
+#include "SimpleEngineCore/Profiler.hpp"
 
 #include "SimpleEngineCore/Rendering/OpenGL/ShaderProgram.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/VertexBuffer.hpp"
@@ -12,10 +17,15 @@
 #include "SimpleEngineCore/Rendering/OpenGL/Trapezoid.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/Torus.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/Spiral.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/ParametricMesh.hpp"
 
 #include "SimpleEngineCore/Rendering/OpenGL/Cube.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/Model.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/InstancedModel.hpp"
 #include "SimpleEngineCore/Rendering/OpenGL/Light.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureStreamer.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/GpuProfiler.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/OpenGLRenderBackend.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -33,6 +43,10 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include<filesystem>
+#include <random>
+#include <algorithm>
+#include <cfloat>
+#include <deque>
 #include <SimpleEngineCore/Rendering/OpenGL/ComplexModel.hpp>
 namespace fs = std::filesystem;
 
@@ -40,19 +54,315 @@ namespace SimpleEngine {
 
 static bool s_GLFW_initialized = false;
 
-Window::Window(string title, const u32 width, const u32 height)
-    : m_data({std::move(title), width, height})
+static std::vector<InstanceData> scatter_instances(const size_t count)
 {
-    //i32 resultCode =
-            init();
+    std::vector<InstanceData> instances(count);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> tint(0.7f, 1.f);
+
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const float spacing = 2.f;
+    const float half_extent = spacing * static_cast<float>(side) * 0.5f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float x = static_cast<float>(i % side) * spacing - half_extent + jitter(generator);
+        const float z = static_cast<float>(i / side) * spacing - half_extent + jitter(generator);
+        instances[i].transform = glm::translate(glm::vec3(x, 0.f, z));
+        instances[i].color = glm::vec4(tint(generator), tint(generator), tint(generator), 1.f);
+    }
+    return instances;
+}
+
+static void draw_texture_streaming_panel(TextureStreamer::Settings& settings, const TextureStreamer::Stats& stats)
+{
+    constexpr float mib = 1024.f * 1024.f;
+
+    ImGui::Begin("Texture streaming");
+    i32 budget_mib = static_cast<i32>(settings.vram_budget >> 20);
+    if (ImGui::InputInt("VRAM budget, MiB", &budget_mib, 16, 128))
+    {
+        settings.vram_budget = size_t(std::max(budget_mib, 1)) << 20;
+    }
+    i32 upload_mib = static_cast<i32>(settings.max_upload_bytes_per_frame >> 20);
+    if (ImGui::InputInt("Upload per frame, MiB", &upload_mib, 1, 8))
+    {
+        settings.max_upload_bytes_per_frame = size_t(std::max(upload_mib, 1)) << 20;
+    }
+    ImGui::SliderFloat("Upload time per frame, ms", &settings.max_upload_ms, 0.1f, 16.f);
+
+    ImGui::Text("Resident: %.1f / %.1f MiB in %zu textures", stats.resident_bytes / mib, settings.vram_budget / mib, stats.textures_count);
+    ImGui::Text("Pending requests: %zu", stats.pending_requests);
+    ImGui::Text("Last frame: %zu uploads, %.2f MiB, %.2f ms", stats.uploads, stats.uploaded_bytes / mib, stats.upload_ms);
+    ImGui::Text("Evictions: %zu, %.1f MiB", stats.evictions, stats.evicted_bytes / mib);
+    ImGui::End();
+}
+
+// Frame time history plus a timeline of one frame: a row per CPU thread and
+// one for the GPU, nested scopes stacked below their parents
+static void draw_profiler_panel()
+{
+    Profiler& profiler = Profiler::get();
+    const std::deque<ProfiledFrame>& frames = profiler.get_frames();
+
+    ImGui::Begin("Profiler");
+    bool enabled = profiler.is_enabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+    {
+        profiler.set_enabled(enabled);
+    }
+    ImGui::SameLine();
+    bool paused = profiler.is_paused();
+    if (ImGui::Checkbox("Pause", &paused))
+    {
+        profiler.set_paused(paused);
+    }
+    ImGui::SameLine();
+    static std::string export_status;
+    if (ImGui::Button("Export Chrome trace"))
+    {
+        export_status = profiler.export_chrome_trace("profile_trace.json") ? "Saved profile_trace.json" : "Export failed";
+    }
+    if (!export_status.empty())
+    {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(export_status.c_str());
+    }
+
+    if (frames.empty())
+    {
+        ImGui::End();
+        return;
+    }
+
+    ArenaVector<float> frame_ms(frames.size(), 0.f, frame_allocator<float>(EMemoryTag::Editor));
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        frame_ms[i] = (frames[i].end_ns - frames[i].start_ns) / 1e6f;
+    }
+    ImGui::PlotLines("Frame, ms", frame_ms.data(), static_cast<i32>(frame_ms.size()), 0, nullptr, 0.f, 33.3f, ImVec2(0.f, 60.f));
+
+    // GPU results arrive a few frames late, so look that far back by default
+    static i32 frames_back = static_cast<i32>(GpuProfiler::frames_in_flight);
+    ImGui::SliderInt("Frames back", &frames_back, 0, static_cast<i32>(frames.size()) - 1);
+    frames_back = std::clamp(frames_back, 0, static_cast<i32>(frames.size()) - 1);
+    const ProfiledFrame& frame = frames[frames.size() - 1 - static_cast<size_t>(frames_back)];
+    ImGui::Text("Frame %llu: %.2f ms, %zu CPU / %zu GPU scopes, %llu events dropped",
+                static_cast<unsigned long long>(frame.number), (frame.end_ns - frame.start_ns) / 1e6,
+                frame.cpu_events.size(), frame.gpu_events.size(),
+                static_cast<unsigned long long>(profiler.get_dropped_events()));
+
+    u32 threads_count = 0;
+    u32 max_depth = 0;
+    for (const ProfileEvent& event : frame.cpu_events)
+    {
+        threads_count = std::max(threads_count, event.thread + 1);
+        max_depth = std::max(max_depth, event.depth);
+    }
+    for (const ProfileEvent& event : frame.gpu_events)
+    {
+        max_depth = std::max(max_depth, event.depth);
+    }
+
+    constexpr float bar_height = 18.f;
+    constexpr float label_width = 70.f;
+    const float row_height = bar_height * (max_depth + 1) + 6.f;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = std::max(100.f, ImGui::GetContentRegionAvail().x - label_width);
+    const double frame_ns = static_cast<double>(std::max<u64>(frame.end_ns - frame.start_ns, 1));
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    const auto draw_row = [&](const u32 row, const char* label, const std::vector<ProfileEvent>& events, const bool gpu, const u32 thread)
+    {
+        const float top = origin.y + row * row_height;
+        draw_list->AddText(ImVec2(origin.x, top), ImGui::GetColorU32(ImGuiCol_Text), label);
+        for (const ProfileEvent& event : events)
+        {
+            if (!gpu && event.thread != thread)
+            {
+                continue;
+            }
+            // Clamped to the frame, loading and late GPU work can spill over
+            const double start = std::clamp((static_cast<double>(event.start_ns) - frame.start_ns) / frame_ns, 0.0, 1.0);
+            const double end = std::clamp((static_cast<double>(event.end_ns) - frame.start_ns) / frame_ns, 0.0, 1.0);
+            const ImVec2 min(origin.x + label_width + static_cast<float>(start) * width, top + event.depth * bar_height);
+            const ImVec2 max(std::max(min.x + 1.f, origin.x + label_width + static_cast<float>(end) * width), min.y + bar_height - 1.f);
+            const ImU32 color = gpu ? IM_COL32(200, 110, 60, 255) : IM_COL32(70, 130, 200 - 25 * (event.depth % 4), 255);
+            draw_list->AddRectFilled(min, max, color);
+            if (max.x - min.x > 30.f)
+            {
+                draw_list->PushClipRect(min, max, true);
+                draw_list->AddText(ImVec2(min.x + 2.f, min.y + 1.f), IM_COL32_WHITE, event.name);
+                draw_list->PopClipRect();
+            }
+            if (ImGui::IsMouseHoveringRect(min, max))
+            {
+                ImGui::SetTooltip("%s: %.3f ms", event.name, (event.end_ns - event.start_ns) / 1e6);
+            }
+        }
+    };
+
+    for (u32 thread = 0; thread < threads_count; ++thread)
+    {
+        draw_row(thread, profiler.get_thread_name(thread), frame.cpu_events, false, thread);
+    }
+    draw_row(threads_count, "GPU", frame.gpu_events, true, 0);
+    ImGui::Dummy(ImVec2(label_width + width, row_height * (threads_count + 1)));
+    ImGui::End();
+}
+
+static void draw_frame_pacing_panel(FramePacer& pacer, Window& window)
+{
+    ImGui::Begin("Frame pacing");
+    float target_fps = static_cast<float>(pacer.get_target_fps());
+    if (ImGui::InputFloat("Target FPS (0 = off)", &target_fps, 10.f, 30.f, "%.0f"))
+    {
+        pacer.set_target_fps(target_fps);
+    }
+    i32 swap_interval = window.get_swap_interval();
+    if (ImGui::SliderInt("Swap interval", &swap_interval, 0, 2))
+    {
+        window.set_swap_interval(swap_interval);
+    }
+
+    const FramePacingStats stats = pacer.get_stats();
+    ImGui::Text("Interval %.2f ms (%.0f FPS), jitter %.3f ms, min %.2f / max %.2f ms",
+                stats.mean_ms, stats.mean_ms > 0.0 ? 1000.0 / stats.mean_ms : 0.0, stats.jitter_ms, stats.min_ms, stats.max_ms);
+    const std::vector<float>& intervals = pacer.get_intervals_ms();
+    ImGui::PlotLines("Interval, ms", intervals.data(), static_cast<i32>(intervals.size()),
+                     static_cast<i32>(pacer.get_intervals_offset()), nullptr, 0.f, 33.3f, ImVec2(0.f, 60.f));
+    ImGui::End();
+}
+
+// Arena and pool usage per subsystem, and with allocation tracking compiled
+// in, what the last frame took from the heap and where from
+static void draw_memory_panel()
+{
+    constexpr float kib = 1024.f;
+
+    ImGui::Begin("Memory");
+    const MemoryStats& stats = MemoryStats::get();
+    const AllocationTracker& tracker = AllocationTracker::get();
+    const AllocationTracker::FrameAllocations& frame = tracker.get_last_frame();
+    const bool tracked = AllocationTracker::is_compiled_in();
+    if (ImGui::BeginTable("Memory tags", tracked ? 7 : 5))
+    {
+        ImGui::TableSetupColumn("Subsystem");
+        ImGui::TableSetupColumn("Reserved, KiB");
+        ImGui::TableSetupColumn("Peak, KiB");
+        ImGui::TableSetupColumn("Allocated, KiB");
+        ImGui::TableSetupColumn("Allocations");
+        if (tracked)
+        {
+            ImGui::TableSetupColumn("Heap / frame");
+            ImGui::TableSetupColumn("Heap KiB / frame");
+        }
+        ImGui::TableHeadersRow();
+        for (u8 tag = 0; tag < static_cast<u8>(EMemoryTag::Count); ++tag)
+        {
+            const MemoryStats::Counters counters = stats.get_counters(static_cast<EMemoryTag>(tag));
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(MemoryStats::get_tag_name(static_cast<EMemoryTag>(tag)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", counters.reserved_bytes / kib);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", counters.peak_reserved_bytes / kib);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", counters.allocated_bytes / kib);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(counters.allocations_count));
+            if (tracked)
+            {
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(frame.counts[tag]));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", frame.bytes[tag] / kib);
+            }
+        }
+        ImGui::EndTable();
+    }
+    if (!tracked)
+    {
+        ImGui::TextUnformatted("Build with SIMPLE_ENGINE_TRACK_ALLOCATIONS for heap allocations per frame");
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Last frame: %llu unexpected, %llu on background threads (%.2f KiB), %llu frees",
+                static_cast<unsigned long long>(frame.get_unexpected_count()), static_cast<unsigned long long>(frame.background_count),
+                frame.background_bytes / kib, static_cast<unsigned long long>(frame.frees));
+    if (ImGui::CollapsingHeader("Sampled call sites"))
+    {
+        i32 interval = static_cast<i32>(AllocationTracker::get().get_sampling_interval());
+        if (ImGui::InputInt("One allocation in", &interval))
+        {
+            AllocationTracker::get().set_sampling_interval(static_cast<u32>(std::max(interval, 0)));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            AllocationTracker::get().clear_call_sites();
+        }
+        for (const AllocationTracker::CallSite& call_site : tracker.get_call_sites(10))
+        {
+            ImGui::Separator();
+            ImGui::Text("%llu samples, %.1f KiB, %s", static_cast<unsigned long long>(call_site.samples), call_site.bytes / kib,
+                        MemoryStats::get_tag_name(call_site.tag));
+            ImGui::TextUnformatted(AllocationTracker::describe(call_site).c_str());
+        }
+    }
+    ImGui::End();
+}
+
+static void draw_input_latency_panel(InputLatencyTracker& tracker)
+{
+    ImGui::Begin("Input latency");
+    ImGui::TextUnformatted("From the input callback to the GPU finishing the first frame showing it");
+    for (const EventType type : { EventType::KeyPressed, EventType::KeyReleased, EventType::MouseMoved })
+    {
+        const LatencyHistogram histogram = tracker.get_histogram(type);
+        ImGui::Text("%s: %llu events, mean %.2f ms, p50 %.2f / p95 %.2f / p99 %.2f / max %.2f ms",
+                    get_event_type_name(type), static_cast<unsigned long long>(histogram.get_count()), histogram.get_mean_ms(),
+                    histogram.get_percentile_ms(0.5), histogram.get_percentile_ms(0.95), histogram.get_percentile_ms(0.99),
+                    histogram.get_max_ms());
+        if (histogram.get_count() == 0)
+        {
+            continue;
+        }
+        std::array<float, LatencyHistogram::buckets_count> buckets;
+        std::copy(histogram.get_buckets().begin(), histogram.get_buckets().end(), buckets.begin());
+        ImGui::PushID(static_cast<int>(type));
+        ImGui::PlotHistogram("Events per ms", buckets.data(), static_cast<i32>(buckets.size()), 0, nullptr, 0.f, FLT_MAX, ImVec2(0.f, 60.f));
+        ImGui::PopID();
+    }
+    if (ImGui::Button("Reset"))
+    {
+        tracker.reset();
+    }
+    ImGui::End();
+}
+
+Window::Window(string title, const u32 width, const u32 height, const EWindowMode mode)
+    : m_data({std::move(title), width, height, {}}),
+      m_mode(mode)
+{
+    m_init_code = init();
+    if (m_init_code != 0)
+    {
+        return;
+    }
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGui_ImplOpenGL3_Init();
+    // Creates the font texture now, while this thread has the context
+    ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_InitForOpenGL(m_pWindow, true);
 }
 
 Window::~Window()
 {
+    stop_render_thread();
     shutdown();
 }
 
@@ -70,6 +380,19 @@ i32 Window::init()
         s_GLFW_initialized = true;
     }
 
+    glfwDefaultWindowHints();
+    if (m_mode == EWindowMode::Headless)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef SIMPLE_ENGINE_OSMESA
+        // GLFW built with GLFW_USE_OSMESA: no display server, Mesa renders into memory
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+    }
+
     m_pWindow = glfwCreateWindow(m_data.width, m_data.height, m_data.title.c_str(), nullptr, nullptr);
     if (!m_pWindow)
     {
@@ -85,7 +408,11 @@ i32 Window::init()
         LOG_CRITICAL("Failed to initialize GLAD");
         return -3;
     }
-    
+    LOG_INFO("OpenGL {0} on {1}", reinterpret_cast<const char*>(glGetString(GL_VERSION)), reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    OpenGLRenderBackend::load_extensions((GLADloadproc)glfwGetProcAddress);
+
+    set_swap_interval(m_mode == EWindowMode::Headless ? 0 : 1);
+
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_TRUE);
     glDepthFunc(GL_LEQUAL);
@@ -93,6 +420,7 @@ i32 Window::init()
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    m_data.p_input_latency = &m_input_latency;
     glfwSetWindowUserPointer(m_pWindow, &m_data);
     glfwSetWindowSizeCallback(m_pWindow,
         [](GLFWwindow* pWindow, int width, int height)
@@ -102,6 +430,7 @@ i32 Window::init()
             data.height = height;
 
             EventWindowResize event(width, height);
+            event.time_ns = Profiler::get().now_ns();
             data.eventCallbackFn(event);
         });
 
@@ -111,6 +440,8 @@ i32 Window::init()
             WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(pWindow));
 
             EventMouseMoved event(x, y);
+            event.time_ns = Profiler::get().now_ns();
+            data.p_input_latency->on_input(EventMouseMoved::type, event.time_ns);
             data.eventCallbackFn(event);
         });
 
@@ -119,14 +450,23 @@ i32 Window::init()
         {
             WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(pWindow));
             EventWindowClose event;
+            event.time_ns = Profiler::get().now_ns();
             data.eventCallbackFn(event);
         });
 
+    // The viewport follows in render(), on the thread owning the context
     glfwSetFramebufferSizeCallback(m_pWindow,
         [](GLFWwindow* pWindow, int width, int height)
         {
-            glViewport(0, 0, width, height);
+            WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(pWindow));
+            data.framebuffer_width = width;
+            data.framebuffer_height = height;
         });
+    i32 framebuffer_width = 0;
+    i32 framebuffer_height = 0;
+    glfwGetFramebufferSize(m_pWindow, &framebuffer_width, &framebuffer_height);
+    m_data.framebuffer_width = m_viewport_width = static_cast<u32>(framebuffer_width);
+    m_data.framebuffer_height = m_viewport_height = static_cast<u32>(framebuffer_height);
 
     glfwSetKeyCallback(m_pWindow, 
         [](GLFWwindow* pWindow, i32 key, i32 scancode, i32 action, i32 mods)
@@ -140,6 +480,8 @@ i32 Window::init()
                 event.scancode = scancode;
                 event.action = action;
                 event.mods = mods;
+                event.time_ns = Profiler::get().now_ns();
+                data.p_input_latency->on_input(EventKeyPressed::type, event.time_ns);
                 data.eventCallbackFn(event);
             }
             else if (action == GLFW_RELEASE)
@@ -149,6 +491,8 @@ i32 Window::init()
                 event.scancode = scancode;
                 event.action = action;
                 event.mods = mods;
+                event.time_ns = Profiler::get().now_ns();
+                data.p_input_latency->on_input(EventKeyReleased::type, event.time_ns);
                 data.eventCallbackFn(event);
             }
             else//GLFW_REPEAT
@@ -158,67 +502,209 @@ i32 Window::init()
         });
 
     p_camera = std::make_unique<Camera>(*this, glm::vec3(0.0f, 0.0f, 2.0f));
+    p_render_camera = std::make_unique<Camera>(*this, glm::vec3(0.0f, 0.0f, 2.0f));
 
-    std::string parentDir = (fs::current_path().fs::path::parent_path()).string();
-    LOG_INFO("parentDir: " + parentDir);
+    PROFILE_SCOPE("Load scene");
+    const fs::path zelda_dir = fs::current_path().parent_path() / "resources" / "zelda";
+    LOG_INFO("Scene directory: {0}", zelda_dir.string());
+    const auto resource = [&zelda_dir](const char* name) { return (zelda_dir / name).string(); };
 
     zelda = std::make_unique<ComplexModel>(
         ComplexModel({
-            ModelData{ (parentDir + "\\resources\\zelda\\eyes.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\eyes_diff.png").c_str() },
-            ModelData{ (parentDir + "\\resources\\zelda\\hair.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\hair_diff.png").c_str() },
-            ModelData{ (parentDir + "\\resources\\zelda\\mouth.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\zelda_diff.png").c_str() },
-            ModelData{ (parentDir + "\\resources\\zelda\\sheikaSlate.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\misc_diff.png").c_str()},
-            ModelData{ (parentDir + "\\resources\\zelda\\terrain.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\setCave_diff.png").c_str()},
-            ModelData{ (parentDir + "\\resources\\zelda\\torch.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\misc_diff.png").c_str()},
-            ModelData{ (parentDir + "\\resources\\zelda\\fire.obj").c_str(), (parentDir + "\\resources\\zelda\\textures\\fire_diff.png").c_str() },
+            ModelData{ resource("eyes.obj"), resource("textures/eyes_diff.png") },
+            ModelData{ resource("hair.obj"), resource("textures/hair_diff.png") },
+            ModelData{ resource("mouth.obj"), resource("textures/zelda_diff.png") },
+            ModelData{ resource("sheikaSlate.obj"), resource("textures/misc_diff.png") },
+            ModelData{ resource("terrain.obj"), resource("textures/setCave_diff.png") },
+            ModelData{ resource("torch.obj"), resource("textures/misc_diff.png") },
+            ModelData{ resource("fire.obj"), resource("textures/fire_diff.png") },
         }));
 
     zelda->set_material(Material(glm::vec3(1.f)), 6);
     zelda->set_material(Material(glm::vec3(0.1f), glm::vec3(1.f), glm::vec3(1.f), 0, 0), 2);
     zelda->set_location({ 0, -1, -1 });
 
+    p_torches = std::make_unique<InstancedModel>(zelda->get_model(5));
+
+    // Edited meshes and textures show up without restarting
+    p_asset_reloader = std::make_unique<AssetReloader>(zelda_dir);
+    zelda->watch_assets(*p_asset_reloader);
+    // Every program of the scene has been created by now
+    p_shader_reloader = std::make_unique<AssetReloader>(ShaderProgram::get_shared_directory());
+    ShaderProgram::watch_shared(*p_shader_reloader);
+
     p_point_light = std::make_unique<PointLight>(glm::vec3(-1, 4, 3));
-    p_point_light->init_shader(zelda->get_shader_program());
+
+    m_scene.scale = zelda->get_scale();
+    m_scene.rotation = zelda->get_rotation();
+    m_scene.location = zelda->get_location();
+    m_scene.light_position = p_point_light->get_position();
+    m_scene.torch_instances = p_torches->get_instances_count();
+    m_scene.indirect_rendering = zelda->is_indirect_rendering();
+    for (size_t i = 0; i < SceneSettings::materials_count; ++i)
+    {
+        m_scene.materials[i] = zelda->get_material(i);
+    }
+    m_scene.streaming = TextureStreamer::get().get_settings();
     return 0;
 }
 
-void Window::on_update()
+void Window::set_camera_override(const glm::vec3& position, const glm::vec3& target)
 {
-    glClearColor(m_background_color[0], m_background_color[1], m_background_color[2], m_background_color[3]);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_camera_override = true;
+    m_camera_position = position;
+    m_camera_target = target;
+}
+
+void Window::set_torch_instances(const size_t count)
+{
+    m_scene.torch_instances = count;
+}
+
+void Window::start_render_thread()
+{
+    if (m_render_thread.joinable())
+    {
+        return;
+    }
+    m_snapshots.reopen();
+    glfwMakeContextCurrent(nullptr);
+    m_render_thread = std::thread([this]()
+    {
+        glfwMakeContextCurrent(m_pWindow);
+        Profiler::get().set_thread_name("Render");
+        AllocationTracker::register_frame_thread();
+        while (const RenderSnapshot* p_snapshot = m_snapshots.acquire())
+        {
+            render(*p_snapshot);
+            LinearArena::get_frame().reset();
+        }
+        glfwMakeContextCurrent(nullptr);
+    });
+}
 
+void Window::stop_render_thread()
+{
+    if (!m_render_thread.joinable())
+    {
+        return;
+    }
+    m_snapshots.close();
+    m_render_thread.join();
+    glfwMakeContextCurrent(m_pWindow);
+}
+
+void Window::simulate(const float dt)
+{
+    PROFILE_SCOPE("Window::simulate");
+    p_camera->save_previous_pose();
+    m_consumed_inputs.merge(m_input_latency.take_pending());
+    if (m_camera_override)
+    {
+        p_camera->look_at(m_camera_position, m_camera_target);
+    }
+    else
+    {
+        p_camera->inputs(dt);
+    }
+}
+
+void Window::on_update(const float alpha)
+{
+    PROFILE_SCOPE("Window::on_update");
+    RenderSnapshot& snapshot = has_render_thread() ? m_snapshots.write_slot() : m_inline_snapshot;
+    build_frame(snapshot, alpha);
+    if (has_render_thread())
+    {
+        PROFILE_SCOPE("Wait for render thread");
+        m_snapshots.publish();
+    }
+    else
+    {
+        render(snapshot);
+    }
+
+    {
+        PROFILE_SCOPE("PollEvents");
+        glfwPollEvents();
+    }
+}
+
+void Window::build_frame(RenderSnapshot& snapshot, const float alpha)
+{
+    // ImGui's, and the panels'; the rest of the frame only copies values
+    const MemoryTagScope imgui_memory_tag(EMemoryTag::Editor);
     ImGuiIO& io = ImGui::GetIO();
     io.DisplaySize.x = static_cast<float>(get_width());
     io.DisplaySize.y = static_cast<float>(get_height());
 
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
-    ImGui::NewFrame();
+    {
+        PROFILE_SCOPE("ImGui::NewFrame");
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
+    }
+
+    RenderFeedback feedback;
+    {
+        std::lock_guard<std::mutex> lock(m_feedback_mutex);
+        feedback = m_feedback;
+    }
+    draw_editor_panels(feedback);
+    draw_texture_streaming_panel(m_scene.streaming, feedback.streaming);
+    draw_profiler_panel();
+    if (m_p_frame_pacer != nullptr)
+    {
+        draw_frame_pacing_panel(*m_p_frame_pacer, *this);
+    }
+    draw_input_latency_panel(m_input_latency);
+    draw_memory_panel();
+
+    {
+        PROFILE_SCOPE("ImGui::Render");
+        ImGui::Render();
+        snapshot.imgui.capture(*ImGui::GetDrawData());
+    }
+
+    snapshot.frame_number = Profiler::get().get_frame_number();
+    snapshot.window_width = m_data.width;
+    snapshot.window_height = m_data.height;
+    snapshot.framebuffer_width = m_data.framebuffer_width;
+    snapshot.framebuffer_height = m_data.framebuffer_height;
+    snapshot.swap_interval = m_swap_interval;
+    snapshot.previous_camera = p_camera->get_previous_pose();
+    snapshot.camera = p_camera->get_pose();
+    snapshot.alpha = alpha;
+    snapshot.inputs = m_consumed_inputs;
+    m_consumed_inputs = InputTimes();
+    snapshot.scene = m_scene;
+}
+
+void Window::draw_editor_panels(const RenderFeedback& feedback)
+{
     ImGui::Begin("Editor");
-    ImGui::ColorEdit4("Background Color", m_background_color);
-
-    p_camera->inputs();
-    p_camera->update_matrix(45.0f, 0.1f, 100.0f);
-
-    static glm::vec3 scale = zelda->get_scale();
-    static glm::vec3 rotation = zelda->get_rotation();
-    static glm::vec3 location = zelda->get_location();
-    static glm::vec3 light_position = p_point_light->get_position();
-    ImGui::InputFloat3("Scale", glm::value_ptr(scale));
-    ImGui::InputFloat3("Rotation", glm::value_ptr(rotation));
-    ImGui::InputFloat3("Location", glm::value_ptr(location));
-    ImGui::InputFloat3("Light Position", glm::value_ptr(light_position));
+    ImGui::ColorEdit4("Background Color", m_scene.background_color.data());
+    ImGui::InputFloat3("Scale", glm::value_ptr(m_scene.scale));
+    ImGui::InputFloat3("Rotation", glm::value_ptr(m_scene.rotation));
+    ImGui::InputFloat3("Location", glm::value_ptr(m_scene.location));
+    ImGui::InputFloat3("Light Position", glm::value_ptr(m_scene.light_position));
+    i32 torches_count = static_cast<i32>(m_scene.torch_instances);
+    if (ImGui::InputInt("Torch instances", &torches_count, 1000, 10000))
+    {
+        m_scene.torch_instances = static_cast<size_t>(std::max(torches_count, 0));
+    }
+    ImGui::Text("Visible torches: %zu", feedback.visible_torches);
+    ImGui::Checkbox("Multi-draw indirect", &m_scene.indirect_rendering);
+    if (m_scene.indirect_rendering)
+    {
+        ImGui::Text("Indirect draws: %zu in %zu calls", feedback.indirect_draws, feedback.indirect_submit_calls);
+    }
     ImGui::End();
-    p_point_light->set_position(light_position);
-    zelda->set_scale(scale);
-    zelda->set_location(location);
-    zelda->set_rotation(rotation);
 
     int i = 0;
-    auto make_material_edit_widget = [&](const std::string& name, int number)
+    auto make_material_edit_widget = [&](const char* name, int number)
     {
-        ImGui::Begin(name.c_str());
-        const auto& material = zelda->get_material(number);
+        ImGui::Begin(name);
+        const auto& material = m_scene.materials[number];
         glm::vec3 l_ambient = material.get_ambient();
         glm::vec3 l_diffuse = material.get_diffuse();
         glm::vec3 l_specular = material.get_specular();
@@ -229,7 +715,7 @@ void Window::on_update()
         ImGui::InputFloat3("Specular", glm::value_ptr(l_specular));
         ImGui::InputInt("DiffuseTex", &l_diffuseTex);
         ImGui::InputInt("SpecularTex", &l_specularTex);
-        zelda->set_material(Material(l_ambient, l_diffuse, l_specular, l_diffuseTex, l_specularTex), number);
+        m_scene.materials[number] = Material(l_ambient, l_diffuse, l_specular, l_diffuseTex, l_specularTex);
 
         ImGui::End();
     };
@@ -240,20 +726,119 @@ void Window::on_update()
     make_material_edit_widget("terrain", i++);
     make_material_edit_widget("torch", i++);
     make_material_edit_widget("fire", i++);
+}
 
-    zelda->update_camera(*p_camera, "view_matrix", "cameraPos");
+void Window::render(const RenderSnapshot& snapshot)
+{
+    const MemoryTagScope memory_tag(EMemoryTag::Rendering);
+#ifdef SIMPLE_ENGINE_PROFILE
+    GpuProfiler::get_shared().begin_frame(snapshot.frame_number);
+#endif
+    PROFILE_SCOPE("Window::render");
+    // Between two frames, so no frame draws half a reload
+    p_asset_reloader->update();
+    p_shader_reloader->update();
+    ShaderProgram::update_shared();
+    if (snapshot.swap_interval != m_applied_swap_interval)
+    {
+        glfwSwapInterval(snapshot.swap_interval);
+        m_applied_swap_interval = snapshot.swap_interval;
+    }
+    if (snapshot.framebuffer_width != m_viewport_width || snapshot.framebuffer_height != m_viewport_height)
+    {
+        m_viewport_width = snapshot.framebuffer_width;
+        m_viewport_height = snapshot.framebuffer_height;
+        glViewport(0, 0, static_cast<GLsizei>(m_viewport_width), static_cast<GLsizei>(m_viewport_height));
+    }
+
+    const SceneSettings& scene = snapshot.scene;
+    {
+        PROFILE_GPU_SCOPE("Clear");
+        glClearColor(scene.background_color[0], scene.background_color[1], scene.background_color[2], scene.background_color[3]);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    {
+        PROFILE_SCOPE("Camera");
+        p_render_camera->set_viewport(snapshot.window_width, snapshot.window_height);
+        p_render_camera->set_poses(snapshot.previous_camera, snapshot.camera);
+        p_render_camera->update_matrix(45.0f, 0.1f, 100.0f, snapshot.alpha);
+    }
+
+    if (scene.torch_instances != p_torches->get_instances_count())
+    {
+        p_torches->set_instances(scatter_instances(scene.torch_instances));
+    }
+    zelda->set_indirect_rendering(scene.indirect_rendering);
+    p_point_light->set_position(scene.light_position);
+    zelda->set_scale(scene.scale);
+    zelda->set_location(scene.location);
+    zelda->set_rotation(scene.rotation);
+    p_torches->set_scale(scene.scale);
+    p_torches->set_location(scene.location);
+    p_torches->set_rotation(scene.rotation);
+    for (size_t i = 0; i < SceneSettings::materials_count; ++i)
+    {
+        zelda->set_material(scene.materials[i], i);
+    }
+    TextureStreamer& texture_streamer = TextureStreamer::get();
+    texture_streamer.get_settings() = scene.streaming;
+
+    zelda->update_camera(*p_render_camera, "view_matrix", "cameraPos");
     zelda->update_light(*p_point_light);
     zelda->Render();
 
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (p_torches->get_instances_count() > 0)
+    {
+        {
+            PROFILE_SCOPE("Uniform upload");
+            p_torches->set_material(zelda->get_material(5));
+            p_render_camera->set_matrix(p_torches->get_shader_program(), "view_matrix");
+            p_render_camera->set_position(p_torches->get_shader_program(), "cameraPos");
+            p_point_light->update_shader(p_torches->get_shader_program());
+        }
+        p_torches->cull(*p_render_camera);
+        p_torches->render();
+    }
+
+    // After every draw has requested its mips
+    texture_streamer.update();
+
+    if (ImDrawData* p_draw_data = snapshot.imgui.get_draw_data())
+    {
+        PROFILE_GPU_SCOPE("ImGui");
+        const MemoryTagScope imgui_memory_tag(EMemoryTag::Editor);
+        ImGui_ImplOpenGL3_RenderDrawData(p_draw_data);
+    }
 
-    glfwSwapBuffers(m_pWindow);
-    glfwPollEvents();
+    {
+        PROFILE_SCOPE("SwapBuffers");
+        glfwSwapBuffers(m_pWindow);
+        if (m_mode == EWindowMode::Headless)
+        {
+            // Without vsync the driver could queue frames; finish so frame times include the GPU
+            glFinish();
+        }
+    }
+    m_input_latency.on_frame_submitted(snapshot.inputs);
+    m_input_latency.collect();
+
+    std::lock_guard<std::mutex> lock(m_feedback_mutex);
+    m_feedback.visible_torches = p_torches->get_visible_count();
+    m_feedback.indirect_draws = zelda->get_draw_batch().get_draws_count();
+    m_feedback.indirect_submit_calls = zelda->get_draw_batch().get_submit_calls_count();
+    m_feedback.streaming = texture_streamer.get_stats();
 }
 
 void Window::shutdown()
 {
+    p_asset_reloader.reset();
+    p_shader_reloader.reset();
+    m_input_latency.release();
+    GpuProfiler::release_shared();
+    PrimitiveMesh::release_shared();
+    ShaderProgram::release_shared();
+    VertexArray::release_shared();
     glfwDestroyWindow(m_pWindow);
     glfwTerminate();
 }
@@ -2,18 +2,36 @@
 #define WINDOW_HPP
 #include "SimpleEngineCore/Types.hpp"
 #include "SimpleEngineCore/Event.hpp"
+#include "SimpleEngineCore/InputLatency.hpp"
+#include "SimpleEngineCore/RenderSnapshot.hpp"
+#include "SimpleEngineCore/SnapshotBuffer.hpp"
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <glm/vec3.hpp>
 struct GLFWwindow;
 
 namespace SimpleEngine {
 
+// Headless windows are never shown, render without vsync and finish every
+// frame on the GPU before returning from on_update()
+enum class EWindowMode
+{
+    Windowed,
+    Headless
+};
+
+// A frame is built on the thread calling on_update() (events, ImGui, camera,
+// editor state) into a RenderSnapshot, which render() turns into GL calls.
+// Without a render thread both halves run in on_update(); with one, the GL
+// context moves to it and it renders frame N while frame N+1 is built.
 class Window
 {
 public:
     using EventCallbackFn = std::function<void(BaseEvent&)>;
 
-    Window(string title, const u32 width, const u32 height);
+    Window(string title, const u32 width, const u32 height, const EWindowMode mode = EWindowMode::Windowed);
     ~Window();
 
     Window(const Window&) = delete;
@@ -21,7 +39,34 @@ public:
     Window& operator=(const Window&) = delete;
     Window& operator=(Window&&) = delete;
 
-    void on_update();
+    // One fixed simulation step of `dt` seconds: camera movement
+    void simulate(const float dt);
+    // Builds a frame `alpha` of the way from the previous simulation step to
+    // the latest one and renders it, or hands it to the render thread, then
+    // polls events
+    void on_update(const float alpha = 1.f);
+
+    // The GL context belongs to the render thread in between; nothing else
+    // may use GL until stop_render_thread() returns
+    void start_render_thread();
+    void stop_render_thread();
+    bool has_render_thread() const { return m_render_thread.joinable(); }
+
+    // False when GLFW, the window or its GL context could not be created
+    bool is_initialized() const { return m_init_code == 0; }
+
+    // Replaces keyboard and mouse camera control from the next simulate() on
+    void set_camera_override(const glm::vec3& position, const glm::vec3& target);
+    void set_torch_instances(const size_t count);
+
+    // 0 presents immediately, 1 waits for vsync, 2 for every other one
+    void set_swap_interval(const i32 interval) { m_swap_interval = interval; }
+    i32 get_swap_interval() const { return m_swap_interval; }
+    // Input-to-frame-completion latencies, also shown in the "Input latency" panel
+    InputLatencyTracker& get_input_latency() { return m_input_latency; }
+
+    // Shown and tuned in the "Frame pacing" panel while set
+    void set_frame_pacer(class FramePacer* p_frame_pacer) { m_p_frame_pacer = p_frame_pacer; }
 
     u32 get_width() const { return m_data.width; }
     u32 get_height() const { return m_data.height; }
@@ -37,18 +82,53 @@ private:
         u32 width;
         u32 height;
         EventCallbackFn eventCallbackFn;
+        InputLatencyTracker* p_input_latency = nullptr;
+        u32 framebuffer_width = 0;
+        u32 framebuffer_height = 0;
     };
 
     i32 init();
     void shutdown();
+    void build_frame(RenderSnapshot& snapshot, const float alpha);
+    void draw_editor_panels(const RenderFeedback& feedback);
+    // Everything that touches GL, on the thread owning the context
+    void render(const RenderSnapshot& snapshot);
 
     GLFWwindow* m_pWindow = nullptr;
     WindowData m_data;
-    float m_background_color[4] = {0.271f, 0.232f, 0.451f, 1.f};
+    EWindowMode m_mode;
+    i32 m_init_code = 0;
+    i32 m_swap_interval = 1;
+    class FramePacer* m_p_frame_pacer = nullptr;
+    bool m_camera_override = false;
+    glm::vec3 m_camera_position{ 0.f };
+    glm::vec3 m_camera_target{ 0.f };
+    SceneSettings m_scene;
+    InputLatencyTracker m_input_latency;
+    // Inputs the simulation steps since the last built frame have seen
+    InputTimes m_consumed_inputs;
+
+    SnapshotBuffer<RenderSnapshot> m_snapshots;
+    RenderSnapshot m_inline_snapshot;
+    std::thread m_render_thread;
+    std::mutex m_feedback_mutex;
+    RenderFeedback m_feedback;
+
+    // Render side only
+    i32 m_applied_swap_interval = -1;
+    u32 m_viewport_width = 0;
+    u32 m_viewport_height = 0;
 
+    // Simulated by input, on the on_update() thread
     std::unique_ptr<class Camera> p_camera;
+    // Renders the poses p_camera produced
+    std::unique_ptr<class Camera> p_render_camera;
     std::unique_ptr<class PointLight> p_point_light;
     std::unique_ptr<class ComplexModel> zelda;
+    std::unique_ptr<class InstancedModel> p_torches;
+    // Apply reimported scene assets and shaders at the start of render()
+    std::unique_ptr<class AssetReloader> p_asset_reloader;
+    std::unique_ptr<class AssetReloader> p_shader_reloader;
 };
 
 }
@@ -0,0 +1,92 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/Application.hpp"
+
+// Renders the editor scene offscreen along a scripted camera path for a fixed
+// number of frames and writes frame time percentiles, CPU time per profiler
+// scope and draw/triangle counts as JSON. Meant for CI, so runs are comparable
+// between commits on the same machine.
+
+using namespace SimpleEngine;
+
+static void print_usage()
+{
+    std::cout << "Usage: SimpleEngineRenderBenchmark [--frames N] [--warmup N] [--width W] [--height H]\n"
+                 "                                   [--torches N] [--output report.json]\n"
+                 "                                   [--backend opengl|null] [--record commands.bin]\n"
+                 "                                   [--fail-on-frame-allocations]\n"
+                 "The null backend drops every render call, leaving the engine's own submission cost.\n"
+                 "--fail-on-frame-allocations fails the run if a frame after warm-up allocates outside\n"
+                 "ImGui and the profiler; it needs a SIMPLE_ENGINE_TRACK_ALLOCATIONS build.\n"
+                 "Run from the build's bin directory so the scene resources are found.\n";
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkSettings settings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--frames") == 0 && has_value)
+        {
+            settings.frames = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--warmup") == 0 && has_value)
+        {
+            settings.warmup_frames = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--width") == 0 && has_value)
+        {
+            settings.width = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--height") == 0 && has_value)
+        {
+            settings.height = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--torches") == 0 && has_value)
+        {
+            settings.torch_instances = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--output") == 0 && has_value)
+        {
+            settings.report_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--backend") == 0 && has_value)
+        {
+            const std::string name = argv[++i];
+            if (name == "opengl") settings.backend = EBenchmarkBackend::OpenGL;
+            else if (name == "null") settings.backend = EBenchmarkBackend::Null;
+            else
+            {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && has_value)
+        {
+            settings.commands_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--fail-on-frame-allocations") == 0)
+        {
+            settings.fail_on_frame_allocations = true;
+        }
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (settings.frames == 0 || settings.width == 0 || settings.height == 0)
+    {
+        print_usage();
+        return 1;
+    }
+
+    auto application = std::make_unique<Application>();
+    return application->run_benchmark(settings) == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "SimpleEngineCore/Types.hpp"
+#include "SimpleEngineCore/JobSystem.hpp"
+#include "SimpleEngineCore/Rendering/OpenGL/TextureCompression.hpp"
+
+// Cooks PNGs into ".ctex" block-compressed mip chains next to the source
+// image, where Texture picks them up, and reports encode throughput and
+// quality. Runs on the CPU only.
+
+using namespace SimpleEngine;
+
+static void print_usage()
+{
+    std::cout << "Usage: SimpleEngineTextureCooker [--format bc1|bc3|bc5] [--threads N] [--no-mips] [--box-mips] image.png...\n"
+                 "Without --format, images with transparency are cooked as BC3 and the rest as BC1.\n"
+                 "Mips are Kaiser-filtered in linear space unless --box-mips is given.\n";
+}
+
+static bool has_transparency(const Image& image)
+{
+    for (size_t i = 3; i < image.rgba.size(); i += 4)
+    {
+        if (image.rgba[i] != 255)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char* format_name(const EBlockFormat format)
+{
+    switch (format)
+    {
+        case EBlockFormat::BC1: return "BC1";
+        case EBlockFormat::BC3: return "BC3";
+        case EBlockFormat::BC5: return "BC5";
+    }
+    return "?";
+}
+
+static std::string output_path(const std::string& input)
+{
+    const size_t dot = input.find_last_of('.');
+    const size_t slash = input.find_last_of("/\\");
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+    {
+        return input.substr(0, dot) + ".ctex";
+    }
+    return input + ".ctex";
+}
+
+int main(int argc, char** argv)
+{
+    bool format_forced = false;
+    EBlockFormat forced_format = EBlockFormat::BC1;
+    bool generate_mips = true;
+    bool kaiser_mips = true;
+    u32 threads_count = 0;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+        {
+            const std::string name = argv[++i];
+            format_forced = true;
+            if (name == "bc1") forced_format = EBlockFormat::BC1;
+            else if (name == "bc3") forced_format = EBlockFormat::BC3;
+            else if (name == "bc5") forced_format = EBlockFormat::BC5;
+            else
+            {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threads_count = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--no-mips") == 0)
+        {
+            generate_mips = false;
+        }
+        else if (std::strcmp(argv[i], "--box-mips") == 0)
+        {
+            kaiser_mips = false;
+        }
+        else if (argv[i][0] == '-')
+        {
+            print_usage();
+            return 1;
+        }
+        else
+        {
+            inputs.emplace_back(argv[i]);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        print_usage();
+        return 1;
+    }
+    if (threads_count > 0)
+    {
+        JobSystem::get().start(threads_count);
+    }
+
+    std::cout << std::left << std::setw(40) << "image" << std::right
+              << std::setw(12) << "size" << std::setw(8) << "format" << std::setw(8) << "levels"
+              << std::setw(12) << "encode ms" << std::setw(10) << "MPix/s" << std::setw(10) << "PSNR dB"
+              << std::setw(12) << "raw KiB" << std::setw(12) << "cooked KiB" << std::setw(8) << "ratio" << '\n';
+
+    i32 failures = 0;
+    for (const std::string& input : inputs)
+    {
+        Image image;
+        if (!load_image_rgba(input.c_str(), image))
+        {
+            std::cerr << "Cannot read " << input << '\n';
+            ++failures;
+            continue;
+        }
+
+        const EBlockFormat format = format_forced ? forced_format
+                                                  : (has_transparency(image) ? EBlockFormat::BC3 : EBlockFormat::BC1);
+
+        const auto start = std::chrono::steady_clock::now();
+        const CompressedTexture texture = compress_texture(image, format, generate_mips, threads_count, kaiser_mips);
+        const double encode_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        size_t raw_bytes = 0;
+        size_t cooked_bytes = 0;
+        size_t pixels = 0;
+        for (const CompressedLevel& level : texture.levels)
+        {
+            pixels += size_t(level.width) * level.height;
+            raw_bytes += size_t(level.width) * level.height * 4;
+            cooked_bytes += level.blocks.size();
+        }
+
+        const double psnr = compute_psnr(format, image, decompress_level(format, texture.levels[0]));
+        const std::string output = output_path(input);
+        if (!write_compressed_texture(output.c_str(), texture))
+        {
+            std::cerr << "Cannot write " << output << '\n';
+            ++failures;
+            continue;
+        }
+
+        std::cout << std::left << std::setw(40) << input << std::right
+                  << std::setw(12) << (std::to_string(image.width) + "x" + std::to_string(image.height))
+                  << std::setw(8) << format_name(format)
+                  << std::setw(8) << texture.levels.size()
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << encode_ms
+                  << std::setw(10) << (encode_ms > 0.0 ? pixels / encode_ms / 1000.0 : 0.0)
+                  << std::setw(10) << psnr
+                  << std::setw(12) << raw_bytes / 1024
+                  << std::setw(12) << cooked_bytes / 1024
+                  << std::setw(8) << double(raw_bytes) / double(cooked_bytes) << '\n';
+    }
+
+    return failures == 0 ? 0 : 1;
+}